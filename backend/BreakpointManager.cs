@@ -3,12 +3,16 @@ using System.Threading;
 using System.Collections;
 using System.Runtime.InteropServices;
 
+using Mono.Debugger.Architectures;
+
 namespace Mono.Debugger.Backend
 {
 	internal class BreakpointManager : IDisposable
 	{
 		IntPtr _manager;
 		Hashtable index_hash;
+		Hashtable condition_hash;
+		Hashtable thread_counts;
 
 		[DllImport("monodebuggerserver")]
 		static extern IntPtr mono_debugger_breakpoint_manager_new ();
@@ -40,6 +44,8 @@ namespace Mono.Debugger.Backend
 		public BreakpointManager ()
 		{
 			index_hash = new Hashtable ();
+			condition_hash = new Hashtable ();
+			thread_counts = new Hashtable ();
 			_manager = mono_debugger_breakpoint_manager_new ();
 		}
 
@@ -48,6 +54,8 @@ namespace Mono.Debugger.Backend
 			Lock ();
 
 			index_hash = new Hashtable ();
+			condition_hash = new Hashtable ();
+			thread_counts = new Hashtable ();
 			_manager = mono_debugger_breakpoint_manager_clone (old.Manager);
 
 			foreach (int index in old.index_hash.Keys) {
@@ -159,7 +167,10 @@ namespace Mono.Debugger.Backend
 					throw new InternalError ();
 				}
 
-				index_hash.Add (index, new BreakpointEntry (handle, domain));
+				index_hash.Add (index, new BreakpointEntry (handle, address, domain));
+				if (!handle.Breakpoint.ThreadGroup.IsSystem ||
+				    (handle.Breakpoint.Condition != null))
+					thread_counts.Add (index, new ThreadCounts ());
 				return index;
 			} finally {
 				Unlock ();
@@ -179,7 +190,218 @@ namespace Mono.Debugger.Backend
 						continue;
 					inferior.RemoveBreakpoint (indices [i]);
 					index_hash.Remove (indices [i]);
+					condition_hash.Remove (indices [i]);
+					thread_counts.Remove (indices [i]);
+				}
+			} finally {
+				Unlock ();
+			}
+		}
+
+		// <summary>
+		//   Called each time breakpoint `index' is hit while its breakpoint
+		//   has a condition.  The first time, we try to compile `condition'
+		//   and attach it to the breakpoint in the server.
+		//
+		//   Returns true if the server evaluated exactly this condition.
+		//   The server doesn't know about thread groups, so we never do
+		//   that for breakpoints which only break in some threads.
+		// </summary>
+		public bool CompileCondition (Inferior inferior, Thread thread, int index,
+					      BreakpointCondition condition, Method method,
+					      TargetAddress address)
+		{
+			ConditionEntry entry;
+			Lock ();
+			try {
+				if (!index_hash.Contains (index))
+					return false;
+
+				BreakpointEntry bpt_entry = (BreakpointEntry) index_hash [index];
+				if (!bpt_entry.Handle.Breakpoint.ThreadGroup.IsSystem)
+					return false;
+
+				entry = (ConditionEntry) condition_hash [index];
+				if ((entry != null) && (entry.Condition == condition))
+					return entry.IsCompiled;
+			} finally {
+				Unlock ();
+			}
+
+			byte[] code = null;
+			try {
+				BreakpointConditionBuilder builder = new BreakpointConditionBuilder (
+					inferior, thread, method, address);
+				if (condition.Compile (builder))
+					code = builder.GetCode ();
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SSE, "Cannot compile condition `{0}': {1}",
+					      condition.Text, ex.Message);
+			}
+
+			byte[] insn_code = null;
+			int ip_relative_offset = -1;
+
+			if (code != null)
+				insn_code = read_resume_instruction (inferior, address, out ip_relative_offset);
+
+			Lock ();
+			try {
+				// Also clears the old condition if we can't compile the new one.
+				bool compiled = false;
+				if ((code != null) || (entry != null)) {
+					try {
+						inferior.SetBreakpointCondition (
+							index, code, insn_code, ip_relative_offset);
+						compiled = code != null;
+					} catch (TargetException ex) {
+						Report.Debug (DebugFlags.SSE,
+							      "Cannot set condition of breakpoint {0}: {1}",
+							      index, ex.Message);
+					}
+				}
+
+				condition_hash [index] = new ConditionEntry (condition, compiled);
+				return compiled;
+			} finally {
+				Unlock ();
+			}
+		}
+
+		// <summary>
+		//   Read the instruction at `address' if the server may execute a copy
+		//   of it to resume the target after hitting a breakpoint there.
+		// </summary>
+		static byte[] read_resume_instruction (Inferior inferior, TargetAddress address,
+						       out int ip_relative_offset)
+		{
+			ip_relative_offset = -1;
+
+			Instruction insn = inferior.Architecture.ReadInstruction (inferior, address);
+			if ((insn == null) || !insn.HasInstructionSize || !insn.IsStraightLine)
+				return null;
+
+			if (insn.IsIpRelative) {
+				ip_relative_offset = insn.IpRelativeDisplacementOffset;
+				if (ip_relative_offset < 0)
+					return null;
+			}
+
+			return insn.Code;
+		}
+
+		// <summary>
+		//   Don't stop the next `count' times any of `breakpoint's locations
+		//   is hit; each location has its own count.  The server decrements
+		//   these counts without reporting the hits, unless the breakpoint
+		//   only breaks in some threads or has a condition; see
+		//   CheckIgnoreCount().
+		// </summary>
+		public void SetIgnoreCount (Inferior inferior, Breakpoint breakpoint, int count)
+		{
+			Lock ();
+			try {
+				bool found = false;
+				foreach (int index in index_hash.Keys) {
+					BreakpointEntry entry = (BreakpointEntry) index_hash [index];
+					if (entry.Handle.Breakpoint != breakpoint)
+						continue;
+
+					ThreadCounts counts = (ThreadCounts) thread_counts [index];
+					if (counts != null) {
+						counts.IgnoreCount = count;
+						found = true;
+						continue;
+					}
+
+					int ip_relative_offset;
+					byte[] insn_code = read_resume_instruction (
+						inferior, entry.Address, out ip_relative_offset);
+
+					if (!inferior.SetBreakpointIgnoreCount (
+						    index, count, insn_code, ip_relative_offset))
+						throw new TargetException (
+							TargetError.NotImplemented,
+							"Ignore counts are not supported by this target.");
+					found = true;
+				}
+
+				if (!found)
+					throw new TargetException (
+						TargetError.NoSuchBreakpoint,
+						"Breakpoint {0} is not inserted in this process.",
+						breakpoint.Index);
+			} finally {
+				Unlock ();
+			}
+		}
+
+		// <summary>
+		//   Returns the server's hit counters of `breakpoint', summed up over
+		//   all its locations, or null if it isn't inserted in this process.
+		// </summary>
+		public BreakpointStatistics GetStatistics (Inferior inferior, Breakpoint breakpoint)
+		{
+			Lock ();
+			try {
+				BreakpointStatistics stats = null;
+				foreach (int index in index_hash.Keys) {
+					BreakpointEntry entry = (BreakpointEntry) index_hash [index];
+					if (entry.Handle.Breakpoint != breakpoint)
+						continue;
+
+					if (stats == null)
+						stats = new BreakpointStatistics ();
+
+					int hit_count, filtered_count, ignore_count;
+					if (!inferior.GetBreakpointStatistics (
+						    index, out hit_count, out filtered_count, out ignore_count))
+						return null;
+
+					// The server still filters the hits where the condition is false.
+					ThreadCounts counts = (ThreadCounts) thread_counts [index];
+					if (counts != null) {
+						hit_count = counts.HitCount;
+						ignore_count = counts.IgnoreCount;
+					}
+
+					stats.HitCount += hit_count;
+					stats.FilteredCount += filtered_count;
+					stats.IgnoreCount = Math.Max (stats.IgnoreCount, ignore_count);
 				}
+
+				return stats;
+			} finally {
+				Unlock ();
+			}
+		}
+
+		// <summary>
+		//   Called each time breakpoint `index' is hit in a thread it breaks
+		//   in, after its condition turned out to be true.  The server counts
+		//   and ignores hits of unconditional breakpoints which break in all
+		//   threads; we do it here for the others, so hits in other threads
+		//   and hits where the condition is false are not counted.
+		//
+		//   The server may only evaluate a condition once we compiled it, so
+		//   it can't decide on its own whether a hit counts.
+		//
+		//   Returns true if this hit must be ignored.
+		// </summary>
+		public bool CheckIgnoreCount (int index)
+		{
+			Lock ();
+			try {
+				ThreadCounts counts = (ThreadCounts) thread_counts [index];
+				if (counts == null)
+					return false;
+
+				counts.HitCount++;
+				if (counts.IgnoreCount == 0)
+					return false;
+
+				counts.IgnoreCount--;
+				return true;
 			} finally {
 				Unlock ();
 			}
@@ -244,6 +466,8 @@ namespace Mono.Debugger.Backend
 						continue;
 					inferior.RemoveBreakpoint (indices [i]);
 					index_hash.Remove (indices [i]);
+					condition_hash.Remove (indices [i]);
+					thread_counts.Remove (indices [i]);
 				}
 			} finally {
 				Unlock ();
@@ -291,14 +515,35 @@ namespace Mono.Debugger.Backend
 			Dispose (false);
 		}
 
+		protected class ConditionEntry
+		{
+			public readonly BreakpointCondition Condition;
+			public readonly bool IsCompiled;
+
+			public ConditionEntry (BreakpointCondition condition, bool is_compiled)
+			{
+				this.Condition = condition;
+				this.IsCompiled = is_compiled;
+			}
+		}
+
+		protected class ThreadCounts
+		{
+			public int HitCount;
+			public int IgnoreCount;
+		}
+
 		protected struct BreakpointEntry
 		{
 			public readonly BreakpointHandle Handle;
+			public readonly TargetAddress Address;
 			public readonly int Domain;
 
-			public BreakpointEntry (BreakpointHandle handle, int domain)
+			public BreakpointEntry (BreakpointHandle handle, TargetAddress address,
+						int domain)
 			{
 				this.Handle = handle;
+				this.Address = address;
 				this.Domain = domain;
 			}
 
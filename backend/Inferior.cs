@@ -39,6 +39,9 @@ namespace Mono.Debugger.Backend
 		TargetMemoryInfo target_info;
 		Architecture arch;
 
+		MemoryCache memory_cache;
+		ReadPageHandler read_page_handler;
+
 		bool has_signals;
 		SignalInfo signal_info;
 
@@ -102,6 +105,9 @@ namespace Mono.Debugger.Backend
 		[DllImport("monodebuggerserver")]
 		static extern TargetError mono_debugger_server_write_memory (IntPtr handle, long start, int size, IntPtr data);
 
+		[DllImport("monodebuggerserver")]
+		static extern TargetError mono_debugger_server_read_memory_vectored (IntPtr handle, int count, long[] addresses, int[] sizes, IntPtr data, int[] status);
+
 		[DllImport("monodebuggerserver")]
 		static extern TargetError mono_debugger_server_get_target_info (out int target_int_size, out int target_long_size, out int target_address_size, out int is_bigendian);
 
@@ -127,7 +133,7 @@ namespace Mono.Debugger.Backend
 		static extern TargetError mono_debugger_server_call_method_invoke (IntPtr handle, long invoke_method, long method_address, int num_params, int blob_size, IntPtr param_data, IntPtr offset_data, IntPtr blob_data, long callback_argument, bool debug);
 
 		[DllImport("monodebuggerserver")]
-		static extern TargetError mono_debugger_server_execute_instruction (IntPtr handle, IntPtr instruction, int insn_size, bool update_ip);
+		static extern TargetError mono_debugger_server_execute_instruction (IntPtr handle, IntPtr instruction, int insn_size, bool update_ip, int ip_relative_offset);
 
 		[DllImport("monodebuggerserver")]
 		static extern TargetError mono_debugger_server_insert_breakpoint (IntPtr handle, long address, out int breakpoint);
@@ -138,6 +144,15 @@ namespace Mono.Debugger.Backend
 		[DllImport("monodebuggerserver")]
 		static extern TargetError mono_debugger_server_remove_breakpoint (IntPtr handle, int breakpoint);
 
+		[DllImport("monodebuggerserver")]
+		static extern TargetError mono_debugger_server_set_breakpoint_condition (IntPtr handle, int breakpoint, IntPtr code, int code_size, IntPtr instruction, int insn_size, int ip_relative_offset);
+
+		[DllImport("monodebuggerserver")]
+		static extern TargetError mono_debugger_server_set_breakpoint_ignore_count (IntPtr handle, int breakpoint, int count, IntPtr instruction, int insn_size, int ip_relative_offset);
+
+		[DllImport("monodebuggerserver")]
+		static extern TargetError mono_debugger_server_get_breakpoint_stats (IntPtr handle, int breakpoint, out int hit_count, out int filtered_count, out int ignore_count);
+
 		[DllImport("monodebuggerserver")]
 		static extern TargetError mono_debugger_server_enable_breakpoint (IntPtr handle, int breakpoint);
 
@@ -222,12 +237,20 @@ namespace Mono.Debugger.Backend
 			CHILD_INTERRUPTED,
 			RUNTIME_INVOKE_DONE,
 			INTERNAL_ERROR,
+			CHILD_RESUMED,
 
 			UNHANDLED_EXCEPTION	= 4001,
 			THROW_EXCEPTION,
 			HANDLE_EXCEPTION
 		}
 
+		internal enum BreakpointConditionResult {
+			None = 0,
+			True,
+			False,
+			Ignored
+		}
+
 		internal enum HardwareBreakpointType {
 			NONE = 0,
 			EXECUTE,
@@ -321,6 +344,8 @@ namespace Mono.Debugger.Backend
 			this.error_handler = error_handler;
 			this.breakpoint_manager = bpm;
 			this.address_domain = address_domain;
+			this.memory_cache = new MemoryCache ();
+			this.read_page_handler = new ReadPageHandler (read_page);
 
 			server_handle = mono_debugger_server_create_inferior (breakpoint_manager.Manager);
 			if (server_handle == IntPtr.Zero)
@@ -349,6 +374,9 @@ namespace Mono.Debugger.Backend
 			inferior.target_info = target_info;
 			inferior.exe = exe;
 
+			// All threads share the same address space.
+			inferior.memory_cache = memory_cache;
+
 			inferior.arch = inferior.process.Architecture;
 
 			if (do_attach)
@@ -433,6 +461,7 @@ namespace Mono.Debugger.Backend
 					TargetObject obj, long callback_arg)
 		{
 			check_disposed ();
+			memory_cache.ThreadRunning (this);
 
 			byte[] blob = null;
 			long address = 0;
@@ -465,6 +494,7 @@ namespace Mono.Debugger.Backend
 					   long callback_arg, bool debug)
 		{
 			check_disposed ();
+			memory_cache.ThreadRunning (this);
 
 			int length = param_objects.Length + 1;
 
@@ -528,8 +558,20 @@ namespace Mono.Debugger.Backend
 		}
 
 		public void ExecuteInstruction (byte[] instruction, bool update_ip)
+		{
+			ExecuteInstruction (instruction, -1, update_ip);
+		}
+
+		// <summary>
+		//   Execute `instruction' in the code buffer.  If `ip_relative_offset'
+		//   is not -1, it is the offset of a RIP-relative displacement which
+		//   the server adjusts for the instruction's new location.
+		// </summary>
+		public void ExecuteInstruction (byte[] instruction, int ip_relative_offset,
+						bool update_ip)
 		{
 			check_disposed ();
+			memory_cache.ThreadRunning (this);
 
 			IntPtr data = IntPtr.Zero;
 			try {
@@ -537,7 +579,8 @@ namespace Mono.Debugger.Backend
 				Marshal.Copy (instruction, 0, data, instruction.Length);
 
 				check_error (mono_debugger_server_execute_instruction (
-					server_handle, data, instruction.Length, update_ip));
+					server_handle, data, instruction.Length, update_ip,
+					ip_relative_offset));
 			} finally {
 				Marshal.FreeHGlobal (data);
 			}
@@ -550,12 +593,14 @@ namespace Mono.Debugger.Backend
 
 		public void AbortInvoke (long rti_id)
 		{
+			memory_cache.Invalidate ();
 			TargetError result = mono_debugger_server_abort_invoke (server_handle, rti_id);
 			check_error (result);
 		}
 
 		public int InsertBreakpoint (TargetAddress address)
 		{
+			memory_cache.Invalidate ();
 			int retval;
 			check_error (mono_debugger_server_insert_breakpoint (
 				server_handle, address.Address, out retval));
@@ -565,6 +610,7 @@ namespace Mono.Debugger.Backend
 		public int InsertHardwareBreakpoint (TargetAddress address, bool fallback,
 						     out int index)
 		{
+			memory_cache.Invalidate ();
 			int retval;
 			TargetError result = mono_debugger_server_insert_hw_breakpoint (
 				server_handle, HardwareBreakpointType.NONE, out index,
@@ -583,14 +629,101 @@ namespace Mono.Debugger.Backend
 
 		public void RemoveBreakpoint (int breakpoint)
 		{
+			memory_cache.Invalidate ();
 			check_error (mono_debugger_server_remove_breakpoint (
 				server_handle, breakpoint));
 		}
 
+		// <summary>
+		//   Attach the compiled condition `code' to breakpoint `breakpoint', so
+		//   the server can evaluate it without stopping.  `instruction' is the
+		//   original instruction at the breakpoint's address; if it's not null,
+		//   the server may use a copy of it to resume the thread in place when
+		//   the condition is false.
+		// </summary>
+		public void SetBreakpointCondition (int breakpoint, byte[] code,
+						    byte[] instruction, int ip_relative_offset)
+		{
+			check_disposed ();
+
+			IntPtr code_data = IntPtr.Zero, insn_data = IntPtr.Zero;
+			try {
+				int code_size = code != null ? code.Length : 0;
+				int insn_size = instruction != null ? instruction.Length : 0;
+
+				if (code_size > 0) {
+					code_data = Marshal.AllocHGlobal (code_size);
+					Marshal.Copy (code, 0, code_data, code_size);
+				}
+				if (insn_size > 0) {
+					insn_data = Marshal.AllocHGlobal (insn_size);
+					Marshal.Copy (instruction, 0, insn_data, insn_size);
+				}
+
+				TargetError result = mono_debugger_server_set_breakpoint_condition (
+					server_handle, breakpoint, code_data, code_size,
+					insn_data, insn_size, ip_relative_offset);
+				if (result != TargetError.NotImplemented)
+					check_error (result);
+			} finally {
+				if (code_data != IntPtr.Zero)
+					Marshal.FreeHGlobal (code_data);
+				if (insn_data != IntPtr.Zero)
+					Marshal.FreeHGlobal (insn_data);
+			}
+		}
+
+		// <summary>
+		//   Don't report the next `count' hits of breakpoint `breakpoint'.
+		//   `instruction' and `ip_relative_offset' are the same as in
+		//   SetBreakpointCondition().  Returns false if the server doesn't
+		//   support ignore counts.
+		// </summary>
+		public bool SetBreakpointIgnoreCount (int breakpoint, int count,
+						      byte[] instruction, int ip_relative_offset)
+		{
+			check_disposed ();
+
+			IntPtr insn_data = IntPtr.Zero;
+			try {
+				int insn_size = instruction != null ? instruction.Length : 0;
+				if (insn_size > 0) {
+					insn_data = Marshal.AllocHGlobal (insn_size);
+					Marshal.Copy (instruction, 0, insn_data, insn_size);
+				}
+
+				TargetError result = mono_debugger_server_set_breakpoint_ignore_count (
+					server_handle, breakpoint, count, insn_data, insn_size,
+					ip_relative_offset);
+				if (result == TargetError.NotImplemented)
+					return false;
+				check_error (result);
+				return true;
+			} finally {
+				if (insn_data != IntPtr.Zero)
+					Marshal.FreeHGlobal (insn_data);
+			}
+		}
+
+		public bool GetBreakpointStatistics (int breakpoint, out int hit_count,
+						     out int filtered_count, out int ignore_count)
+		{
+			check_disposed ();
+
+			TargetError result = mono_debugger_server_get_breakpoint_stats (
+				server_handle, breakpoint, out hit_count, out filtered_count,
+				out ignore_count);
+			if (result == TargetError.NotImplemented)
+				return false;
+			check_error (result);
+			return true;
+		}
+
 		public int InsertHardwareWatchPoint (TargetAddress address,
 						     HardwareBreakpointType type,
 						     out int index)
 		{
+			memory_cache.Invalidate ();
 			int retval;
 			check_error (mono_debugger_server_insert_hw_breakpoint (
 				server_handle, type, out index, address.Address, out retval));
@@ -599,18 +732,21 @@ namespace Mono.Debugger.Backend
 
 		public void EnableBreakpoint (int breakpoint)
 		{
+			memory_cache.Invalidate ();
 			check_error (mono_debugger_server_enable_breakpoint (
 				server_handle, breakpoint));
 		}
 
 		public void DisableBreakpoint (int breakpoint)
 		{
+			memory_cache.Invalidate ();
 			check_error (mono_debugger_server_disable_breakpoint (
 				server_handle, breakpoint));
 		}
 
 		public void RestartNotification ()
 		{
+			memory_cache.Invalidate ();
 			check_error (mono_debugger_server_restart_notification (server_handle));
 		}
 
@@ -745,6 +881,10 @@ namespace Mono.Debugger.Backend
 				server_handle, status, out arg, out data1, out data2,
 				out opt_data_size, out opt_data);
 
+			Report.Debug (DebugFlags.MemoryCache, "{0} event {1}: {2}",
+				      child_pid, message, memory_cache);
+			memory_cache.ThreadStopped (this);
+
 			switch (message) {
 			case ChildEventType.CHILD_EXITED:
 			case ChildEventType.CHILD_SIGNALED:
@@ -898,6 +1038,10 @@ namespace Mono.Debugger.Backend
 			}
 		}
 
+		internal override long MemoryGeneration {
+			get { return memory_cache.Generation; }
+		}
+
 		public override AddressDomain AddressDomain {
 			get {
 				return address_domain;
@@ -925,11 +1069,54 @@ namespace Mono.Debugger.Backend
 			return data;
 		}
 
+		bool read_page (long address, byte[] buffer)
+		{
+			IntPtr data = IntPtr.Zero;
+			try {
+				data = Marshal.AllocHGlobal (buffer.Length);
+				TargetError result = mono_debugger_server_read_memory (
+					server_handle, address, buffer.Length, data);
+				if (result != TargetError.None)
+					return false;
+				Marshal.Copy (data, buffer, 0, buffer.Length);
+				return true;
+			} finally {
+				Marshal.FreeHGlobal (data);
+			}
+		}
+
+		byte[] read_cached (TargetAddress address, int size)
+		{
+			byte[] retval = new byte [size];
+			if (memory_cache.Read (address.Address, size, retval, read_page_handler))
+				return retval;
+
+			//
+			// Either some thread is running or a page could not be read;
+			// read the memory directly, this also gives us the correct
+			// exception.
+			//
+			IntPtr data = IntPtr.Zero;
+			try {
+				data = read_buffer (address, size);
+				Marshal.Copy (data, retval, 0, size);
+				return retval;
+			} finally {
+				Marshal.FreeHGlobal (data);
+			}
+		}
+
+		public MemoryCache MemoryCache {
+			get { return memory_cache; }
+		}
+
 		public override byte[] ReadBuffer (TargetAddress address, int size)
 		{
 			check_disposed ();
 			if (size == 0)
 				return new byte [0];
+			if (size <= MemoryCache.PageSize)
+				return read_cached (address, size);
 			IntPtr data = IntPtr.Zero;
 			try {
 				data = read_buffer (address, size);
@@ -941,40 +1128,64 @@ namespace Mono.Debugger.Backend
 			}
 		}
 
-		public override byte ReadByte (TargetAddress address)
+		public override byte[][] ReadBuffers (TargetAddress[] addresses, int[] sizes)
 		{
 			check_disposed ();
+
+			int count = addresses.Length;
+			long[] addrs = new long [count];
+			int[] status = new int [count];
+			int total = 0;
+			for (int i = 0; i < count; i++) {
+				addrs [i] = addresses [i].Address;
+				total += sizes [i];
+			}
+
+			if (total == 0)
+				return base.ReadBuffers (addresses, sizes);
+
 			IntPtr data = IntPtr.Zero;
 			try {
-				data = read_buffer (address, 1);
-				return Marshal.ReadByte (data);
+				data = Marshal.AllocHGlobal (total);
+				TargetError result = mono_debugger_server_read_memory_vectored (
+					server_handle, count, addrs, sizes, data, status);
+				if (result == TargetError.NotImplemented)
+					return base.ReadBuffers (addresses, sizes);
+				else if (result != TargetError.None)
+					throw new TargetException (result);
+
+				byte[][] retval = new byte [count][];
+				int offset = 0;
+				for (int i = 0; i < count; i++) {
+					if ((TargetError) status [i] == TargetError.None) {
+						retval [i] = new byte [sizes [i]];
+						Marshal.Copy ((IntPtr) ((long) data + offset),
+							      retval [i], 0, sizes [i]);
+					}
+					offset += sizes [i];
+				}
+				return retval;
 			} finally {
 				Marshal.FreeHGlobal (data);
 			}
 		}
 
+		public override byte ReadByte (TargetAddress address)
+		{
+			check_disposed ();
+			return read_cached (address, 1) [0];
+		}
+
 		public override int ReadInteger (TargetAddress address)
 		{
 			check_disposed ();
-			IntPtr data = IntPtr.Zero;
-			try {
-				data = read_buffer (address, 4);
-				return Marshal.ReadInt32 (data);
-			} finally {
-				Marshal.FreeHGlobal (data);
-			}
+			return BitConverter.ToInt32 (read_cached (address, 4), 0);
 		}
 
 		public override long ReadLongInteger (TargetAddress address)
 		{
 			check_disposed ();
-			IntPtr data = IntPtr.Zero;
-			try {
-				data = read_buffer (address, 8);
-				return Marshal.ReadInt64 (data);
-			} finally {
-				Marshal.FreeHGlobal (data);
-			}
+			return BitConverter.ToInt64 (read_cached (address, 8), 0);
 		}
 
 		public override TargetAddress ReadAddress (TargetAddress address)
@@ -1001,20 +1212,34 @@ namespace Mono.Debugger.Backend
 				return res;
 		}
 
+		const int StringChunkSize = 256;
+
+		//
+		// Read the string in chunks which never cross a page boundary, so
+		// an unmapped page after the terminating NUL doesn't hurt us.
+		//
 		public override string ReadString (TargetAddress address)
 		{
 			check_disposed ();
-			StringBuilder sb = new StringBuilder ();
+			MemoryStream ms = new MemoryStream ();
 
 			while (true) {
-				byte b = ReadByte (address);
-				address++;
-
-				if (b == 0)
-					return sb.ToString ();
+				long page_left = MemoryCache.PageSize -
+					(address.Address & (MemoryCache.PageSize - 1));
+				int size = (int) System.Math.Min (StringChunkSize, page_left);
+
+				byte[] buffer = ReadBuffer (address, size);
+				int pos = Array.IndexOf (buffer, (byte) 0);
+				if (pos >= 0) {
+					ms.Write (buffer, 0, pos);
+					break;
+				}
 
-				sb.Append ((char) b);
+				ms.Write (buffer, 0, size);
+				address += size;
 			}
+
+			return Encoding.UTF8.GetString (ms.GetBuffer (), 0, (int) ms.Length);
 		}
 
 		public override TargetBlob ReadMemory (TargetAddress address, int size)
@@ -1145,6 +1370,11 @@ namespace Mono.Debugger.Backend
 
 		TargetState change_target_state (TargetState new_state, int arg)
 		{
+			if ((new_state == TargetState.Running) || (new_state == TargetState.Busy))
+				memory_cache.ThreadRunning (this);
+			else
+				memory_cache.ThreadStopped (this);
+
 			if (new_state == target_state)
 				return target_state;
 
@@ -1251,6 +1481,7 @@ namespace Mono.Debugger.Backend
 		public void Detach ()
 		{
 			check_disposed ();
+			memory_cache.ThreadRunning (this);
 			if (pushed_regs)
 				mono_debugger_server_pop_registers (server_handle);
 			check_error (mono_debugger_server_detach (server_handle));
@@ -1264,6 +1495,7 @@ namespace Mono.Debugger.Backend
 		public void Kill ()
 		{
 			check_disposed ();
+			memory_cache.Invalidate ();
 			check_error (mono_debugger_server_kill (server_handle));
 		}
 
@@ -1399,6 +1631,7 @@ namespace Mono.Debugger.Backend
 
 		public TargetAddress PushRegisters ()
 		{
+			memory_cache.Invalidate ();
 			long new_rsp;
 			check_error (mono_debugger_server_push_registers (server_handle, out new_rsp));
 			pushed_regs = true;
@@ -1407,6 +1640,7 @@ namespace Mono.Debugger.Backend
 
 		public void PopRegisters ()
 		{
+			memory_cache.Invalidate ();
 			pushed_regs = false;
 			check_error (mono_debugger_server_pop_registers (server_handle));
 		}
@@ -1608,6 +1842,7 @@ namespace Mono.Debugger.Backend
 
 		protected virtual void OnMemoryChanged ()
 		{
+			memory_cache.Invalidate ();
 			// child_event (ChildEventType.CHILD_MEMORY_CHANGED, 0);
 		}
 
@@ -1757,6 +1992,8 @@ namespace Mono.Debugger.Backend
 				// dispose all managed resources.
 				this.disposed = true;
 
+				memory_cache.ThreadStopped (this);
+
 				// Release unmanaged resources
 				lock (this) {
 					if (server_handle != IntPtr.Zero) {
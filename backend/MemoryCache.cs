@@ -0,0 +1,191 @@
+using System;
+using System.Collections;
+
+namespace Mono.Debugger.Backend
+{
+	internal delegate bool ReadPageHandler (long address, byte[] buffer);
+
+	// <summary>
+	//   A small page-granular LRU cache of the target's memory.
+	//
+	//   The cache is shared between all the threads of a process, but it is
+	//   only used while all of them are stopped: threads are stopped and
+	//   resumed independently, and a running thread may modify any memory.
+	//   It is also flushed whenever a thread is resumed or stopped, writes
+	//   to memory or modifies its breakpoints.
+	// </summary>
+	internal class MemoryCache
+	{
+		public const int PageSize = 4096;
+		public const int MaxPages = 64;
+
+		class Page
+		{
+			public readonly long Address;
+			public readonly byte[] Data;
+			public long Stamp;
+
+			public Page (long address, byte[] data)
+			{
+				this.Address = address;
+				this.Data = data;
+			}
+		}
+
+		Hashtable pages = new Hashtable ();
+		Hashtable running_threads = new Hashtable ();
+		long stamp;
+		long generation;
+
+		long hits, misses, invalidations, bypasses;
+
+		public long Hits {
+			get { return hits; }
+		}
+
+		public long Misses {
+			get { return misses; }
+		}
+
+		public long Invalidations {
+			get { return invalidations; }
+		}
+
+		public long Bypasses {
+			get { return bypasses; }
+		}
+
+		// <summary>
+		//   Incremented each time the cache is flushed, so it changes
+		//   whenever the target's memory may have changed.
+		// </summary>
+		public long Generation {
+			get {
+				lock (this) {
+					return generation;
+				}
+			}
+		}
+
+		// <summary>
+		//   Tell the cache that `thread' is about to run; it won't be used
+		//   until all the threads are stopped again.
+		// </summary>
+		public void ThreadRunning (object thread)
+		{
+			lock (this) {
+				running_threads [thread] = true;
+				clear ();
+			}
+		}
+
+		// <summary>
+		//   Tell the cache that `thread' stopped, exited or was disposed.
+		// </summary>
+		public void ThreadStopped (object thread)
+		{
+			lock (this) {
+				running_threads.Remove (thread);
+				clear ();
+			}
+		}
+
+		public void Invalidate ()
+		{
+			lock (this) {
+				clear ();
+			}
+		}
+
+		void clear ()
+		{
+			generation++;
+			if (pages.Count == 0)
+				return;
+			pages.Clear ();
+			invalidations++;
+		}
+
+		public void ResetStatistics ()
+		{
+			lock (this) {
+				hits = misses = invalidations = bypasses = 0;
+			}
+		}
+
+		Page get_page (long page_addr, ReadPageHandler reader)
+		{
+			Page page = (Page) pages [page_addr];
+			if (page != null) {
+				hits++;
+				page.Stamp = ++stamp;
+				return page;
+			}
+
+			misses++;
+
+			byte[] data = new byte [PageSize];
+			if (!reader (page_addr, data))
+				return null;
+
+			if (pages.Count >= MaxPages)
+				evict ();
+
+			page = new Page (page_addr, data);
+			page.Stamp = ++stamp;
+			pages.Add (page_addr, page);
+			return page;
+		}
+
+		void evict ()
+		{
+			Page oldest = null;
+			foreach (Page page in pages.Values) {
+				if ((oldest == null) || (page.Stamp < oldest.Stamp))
+					oldest = page;
+			}
+			pages.Remove (oldest.Address);
+		}
+
+		// <summary>
+		//   Copy `size' bytes starting at `address' into `buffer'.
+		//   Returns false if some thread is running or any of the pages
+		//   could not be read; the caller should then read the memory
+		//   directly.
+		// </summary>
+		public bool Read (long address, int size, byte[] buffer, ReadPageHandler reader)
+		{
+			lock (this) {
+				if (running_threads.Count > 0) {
+					bypasses++;
+					return false;
+				}
+
+				int offset = 0;
+				while (offset < size) {
+					long addr = address + offset;
+					long page_addr = addr & ~((long) PageSize - 1);
+					int page_offset = (int) (addr - page_addr);
+					int count = System.Math.Min (size - offset, PageSize - page_offset);
+
+					Page page = get_page (page_addr, reader);
+					if (page == null)
+						return false;
+
+					Buffer.BlockCopy (page.Data, page_offset, buffer, offset, count);
+					offset += count;
+				}
+
+				return true;
+			}
+		}
+
+		public override string ToString ()
+		{
+			return String.Format ("MemoryCache ({0} pages, {1} hits, {2} misses, " +
+					      "{3} invalidations, {4} bypasses, {5} running)",
+					      pages.Count, hits, misses, invalidations, bypasses,
+					      running_threads.Count);
+		}
+	}
+}
@@ -169,7 +169,14 @@ namespace Mono.Debugger.Backend
 			if (inferior == null)
 				return;
 
-			ProcessEvent (inferior.ProcessEvent (status));
+			Inferior.ChildEvent cevent = inferior.ProcessEvent (status);
+
+			// The server already resumed the target after hitting a breakpoint
+			// whose condition was false.
+			if (cevent.Type == Inferior.ChildEventType.CHILD_RESUMED)
+				return;
+
+			ProcessEvent (cevent);
 		}
 
 		public bool ProcessEvent (Inferior.ChildEvent cevent)
@@ -177,6 +184,8 @@ namespace Mono.Debugger.Backend
 			Report.Debug (DebugFlags.EventLoop, "{0} received event {1}",
 				      this, cevent);
 
+			step_trap_count++;
+
 			if (killed) {
 				if (cevent.Type == Inferior.ChildEventType.CHILD_INTERRUPTED) {
 					inferior.Continue ();
@@ -844,6 +853,13 @@ namespace Mono.Debugger.Backend
 			get { return last_target_event; }
 		}
 
+		internal override long MemoryGeneration {
+			get {
+				Inferior inferior = this.inferior;
+				return inferior != null ? inferior.MemoryGeneration : -1;
+			}
+		}
+
 		public override Method Lookup (TargetAddress address)
 		{
 			process.UpdateSymbolTable (inferior);
@@ -1095,16 +1111,74 @@ namespace Mono.Debugger.Backend
 			if (!bpt.Breaks (thread.ID) || !process.BreakpointManager.IsBreakpointEnabled (index))
 				return false;
 
+			int server_index = index;
 			index = bpt.Index;
 
 			bool remain_stopped;
 			if (bpt.BreakpointHandler (inferior, out remain_stopped))
 				return remain_stopped;
 
+			// The server already decremented the breakpoint's ignore count,
+			// but couldn't resume the target on its own.
+			if (cevent.Data1 == (long) Inferior.BreakpointConditionResult.Ignored)
+				return false;
+
+			// Only hits where the condition is true count.
 			TargetAddress address = inferior.CurrentFrame;
+			if ((bpt.Condition != null) && !check_breakpoint_condition (
+				    cevent, server_index, bpt, iframe, address))
+				return false;
+
+			if (process.BreakpointManager.CheckIgnoreCount (server_index))
+				return false;
+
 			return bpt.CheckBreakpointHit (thread, address);
 		}
 
+		// <summary>
+		//   Returns whether the breakpoint's condition is true.  The server
+		//   already evaluated it if it could; otherwise, we evaluate it here
+		//   and try to compile it for the next time.
+		// </summary>
+		bool check_breakpoint_condition (Inferior.ChildEvent cevent, int index, Breakpoint bpt,
+						 Inferior.StackFrame iframe, TargetAddress address)
+		{
+			Method method = Lookup (address);
+
+			bool compiled = process.BreakpointManager.CompileCondition (
+				inferior, thread, index, bpt.Condition, method, address);
+
+			if (compiled && (cevent.Data1 == (long) Inferior.BreakpointConditionResult.False))
+				return false;
+			else if (compiled && (cevent.Data1 == (long) Inferior.BreakpointConditionResult.True))
+				return true;
+
+			StackFrame frame;
+			Registers registers = inferior.GetRegisters ();
+			if (method == null) {
+				frame = new StackFrame (
+					thread, FrameType.Normal, iframe.Address, iframe.StackPointer,
+					iframe.FrameAddress, registers);
+			} else if (method.HasLineNumbers) {
+				SourceAddress source = method.LineNumberTable.Lookup (address);
+				frame = new StackFrame (
+					thread, FrameType.Normal, iframe.Address, iframe.StackPointer,
+					iframe.FrameAddress, registers, method, source);
+			} else {
+				frame = new StackFrame (
+					thread, FrameType.Normal, iframe.Address, iframe.StackPointer,
+					iframe.FrameAddress, registers, method);
+			}
+
+			try {
+				return bpt.Condition.Evaluate (frame);
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SSE, "{0} cannot evaluate condition of {1}: {2}",
+					      this, bpt, ex);
+				return true;
+			}
+		}
+
 		bool step_over_breakpoint (bool singlestep, TargetAddress until)
 		{
 			int index;
@@ -1138,7 +1212,19 @@ namespace Mono.Debugger.Backend
 			}
 
 			if (instruction.IsIpRelative) {
-				PushOperation (new OperationStepOverBreakpoint (this, index, until));
+				//
+				// We can still execute it in the code buffer if the server
+				// can rewrite its displacement; otherwise we need to stop
+				// all threads and step over the breakpoint in place.
+				//
+				int offset = instruction.IpRelativeDisplacementOffset;
+				if ((offset < 0) || !can_relocate_instruction (instruction, offset)) {
+					PushOperation (new OperationStepOverBreakpoint (this, index, until));
+					return true;
+				}
+
+				PushOperation (new OperationExecuteInstruction (
+					this, instruction.Code, offset, true));
 				return true;
 			}
 
@@ -1146,6 +1232,18 @@ namespace Mono.Debugger.Backend
 			return true;
 		}
 
+		bool can_relocate_instruction (Instruction instruction, int offset)
+		{
+			if (!process.MonoManager.HasCodeBuffer)
+				return false;
+
+			int displacement = BitConverter.ToInt32 (instruction.Code, offset);
+			TargetAddress target = instruction.Address + instruction.InstructionSize +
+				displacement;
+
+			return process.MonoManager.IsReachableFromCodeBuffer (target);
+		}
+
 		void enable_extended_notification (NotificationType type)
 		{
 			long notifications = inferior.ReadLongInteger (extended_notifications_addr);
@@ -1420,6 +1518,16 @@ namespace Mono.Debugger.Backend
 
 		TemporaryBreakpointData temp_breakpoint = null;
 
+		int step_trap_count;
+
+		// <summary>
+		//   The number of times the target stopped while executing the
+		//   last stepping operation.
+		// </summary>
+		public override int StepTrapCount {
+			get { return step_trap_count; }
+		}
+
 		void insert_temporary_breakpoint (TargetAddress address)
 		{
 			check_inferior ();
@@ -2176,6 +2284,21 @@ namespace Mono.Debugger.Backend
 			});
 		}
 
+		internal override void SetBreakpointIgnoreCount (Breakpoint breakpoint, int count)
+		{
+			SendCommand (delegate {
+				process.BreakpointManager.SetIgnoreCount (inferior, breakpoint, count);
+				return null;
+			});
+		}
+
+		internal override BreakpointStatistics GetBreakpointStatistics (Breakpoint breakpoint)
+		{
+			return (BreakpointStatistics) SendCommand (delegate {
+				return process.BreakpointManager.GetStatistics (inferior, breakpoint);
+			});
+		}
+
 		public override int GetInstructionSize (TargetAddress address)
 		{
 			return (int) SendCommand (delegate {
@@ -2205,6 +2328,13 @@ namespace Mono.Debugger.Backend
 			});
 		}
 
+		public override byte[][] ReadBuffers (TargetAddress[] addresses, int[] sizes)
+		{
+			return (byte[][]) SendCommand (delegate {
+				return inferior.ReadBuffers (addresses, sizes);
+			});
+		}
+
 		public override TargetBlob ReadMemory (TargetAddress address, int size)
 		{
 			return new TargetBlob (ReadBuffer (address, size), TargetMemoryInfo);
@@ -3323,15 +3453,22 @@ namespace Mono.Debugger.Backend
 	protected class OperationExecuteInstruction : Operation
 	{
 		public readonly byte[] Instruction;
+		public readonly int IpRelativeOffset;
 		public readonly bool UpdateIP;
 
 		bool pushed_code_buffer;
 
 		public OperationExecuteInstruction (SingleSteppingEngine sse, byte[] insn,
 						    bool update_ip)
+			: this (sse, insn, -1, update_ip)
+		{ }
+
+		public OperationExecuteInstruction (SingleSteppingEngine sse, byte[] insn,
+						    int ip_relative_offset, bool update_ip)
 			: base (sse, null)
 		{
 			this.Instruction = insn;
+			this.IpRelativeOffset = ip_relative_offset;
 			this.UpdateIP = update_ip;
 		}
 
@@ -3351,7 +3488,7 @@ namespace Mono.Debugger.Backend
 				return;
 			}
 
-			inferior.ExecuteInstruction (Instruction, UpdateIP);
+			inferior.ExecuteInstruction (Instruction, IpRelativeOffset, UpdateIP);
 		}
 
 		protected override EventResult DoProcessEvent (Inferior.ChildEvent cevent,
@@ -3365,7 +3502,7 @@ namespace Mono.Debugger.Backend
 			args = null;
 			if (pushed_code_buffer) {
 				pushed_code_buffer = false;
-				inferior.ExecuteInstruction (Instruction, UpdateIP);
+				inferior.ExecuteInstruction (Instruction, IpRelativeOffset, UpdateIP);
 				return EventResult.Running;
 			}
 
@@ -3386,6 +3523,7 @@ namespace Mono.Debugger.Backend
 		public override void Execute ()
 		{
 			Report.Debug (DebugFlags.SSE, "{0} start stepping operation: {1} {2}", sse, this, Result);
+			sse.step_trap_count = 0;
 			base.Execute ();
 		}
 
@@ -3590,6 +3728,40 @@ namespace Mono.Debugger.Backend
 			return false;
 		}
 
+		const int MaxRangeStepInstructions = 512;
+
+		//
+		// Range stepping: rather than single-stepping through the
+		// straight-line code of the step frame, decode it and run to
+		// the first instruction which may leave it (a branch, call or
+		// return) or to the end of the range.
+		//
+		// Returns TargetAddress.Null if that's not worth it.
+		//
+		TargetAddress find_range_exit (TargetAddress address)
+		{
+			TargetAddress end = StepFrame.End;
+			int count = 0;
+
+			while ((address < end) && (count < MaxRangeStepInstructions)) {
+				Instruction insn = inferior.Architecture.ReadInstruction (
+					inferior, address);
+				if ((insn == null) || !insn.IsStraightLine)
+					break;
+
+				address += insn.InstructionSize;
+				count++;
+			}
+
+			Report.Debug (DebugFlags.SSE, "{0} range stepping: {1} instructions until {2}",
+				      sse, count, address);
+
+			if (count < 2)
+				return TargetAddress.Null;
+
+			return address;
+		}
+
 		protected bool Step (bool first)
 		{
 			TargetAddress current_frame = inferior.CurrentFrame;
@@ -3644,6 +3816,14 @@ namespace Mono.Debugger.Backend
 			 */
 			Instruction instruction = inferior.Architecture.ReadInstruction (
 				inferior, current_frame);
+			if ((instruction != null) && instruction.IsStraightLine && in_frame) {
+				TargetAddress until = find_range_exit (current_frame);
+				if (!until.IsNull) {
+					sse.do_continue (until);
+					return false;
+				}
+			}
+
 			if ((instruction == null) || !instruction.IsCall) {
 				sse.do_step ();
 				return false;
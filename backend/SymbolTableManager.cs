@@ -14,27 +14,216 @@ namespace Mono.Debugger.Backend
 	{
 		ArrayList symbol_files;
 
+		//
+		// Global address index over all loaded symbol files: sorted by start
+		// address and non-overlapping, so a lookup only has to ask exactly one
+		// symbol file.  Symbol files which can't tell us their address range
+		// are kept in `unindexed_files' and searched linearly.
+		//
+		ArrayList address_ranges;
+		ArrayList unindexed_files;
+
+		int update_level;
+		bool pending_change;
+
 		internal SymbolTableManager (DebuggerSession session)
 		{
 			this.symbol_files = ArrayList.Synchronized (new ArrayList ());
+			this.address_ranges = new ArrayList ();
+			this.unindexed_files = new ArrayList ();
 		}
 
+		// <summary>
+		//   Add a symbol file which registers its address ranges itself,
+		//   using AddAddressRange().
+		// </summary>
 		internal void AddSymbolFile (SymbolFile symfile)
 		{
 			symbol_files.Add (symfile);
 		}
 
+		internal void AddSymbolFile (SymbolFile symfile, ISymbolContainer container)
+		{
+			symbol_files.Add (symfile);
+
+			if (container.IsContinuous)
+				AddAddressRange (symfile, container.StartAddress, container.EndAddress);
+			else {
+				lock (this) {
+					unindexed_files.Add (symfile);
+				}
+			}
+		}
+
+		// <summary>
+		//   Register the address range of a symbol file.
+		// </summary>
+		// <remarks>
+		//   The most recently added range wins: the parts of existing ranges
+		//   which it overlaps are removed, but the parts before and after it
+		//   are kept.  This happens when the JIT reuses the memory of an
+		//   unloaded domain, or for JIT code inside a library's range.
+		// </remarks>
+		internal void AddAddressRange (SymbolFile symfile, TargetAddress start,
+					       TargetAddress end)
+		{
+			if (end <= start)
+				return;
+
+			AddressRange range = new AddressRange (symfile, start.Address, end.Address);
+
+			lock (this) {
+				int pos = address_ranges.BinarySearch (range);
+				if (pos >= 0) {
+					AddressRange old = (AddressRange) address_ranges [pos];
+					if ((old.SymbolFile == symfile) && (old.End == range.End))
+						return;
+				} else
+					pos = ~pos;
+
+				//
+				// Cut the new range out of all ranges which overlap it; since the
+				// list is sorted and non-overlapping, only the range before the
+				// insertion point can start below `start' and only the last one
+				// we look at can end after `end'.
+				//
+				if ((pos > 0) && (((AddressRange) address_ranges [pos - 1]).End > range.Start))
+					pos--;
+
+				while (pos < address_ranges.Count) {
+					AddressRange old = (AddressRange) address_ranges [pos];
+					if (old.Start >= range.End)
+						break;
+
+					Report.Debug (DebugFlags.SymbolTable,
+						      "Address range {0} overlaps {1}, replacing it.",
+						      range, old);
+					address_ranges.RemoveAt (pos);
+
+					if (old.Start < range.Start) {
+						address_ranges.Insert (pos++, new AddressRange (
+							old.SymbolFile, old.Start, range.Start));
+					}
+
+					if (old.End > range.End) {
+						address_ranges.Insert (pos, new AddressRange (
+							old.SymbolFile, range.End, old.End));
+						break;
+					}
+				}
+
+				address_ranges.Insert (pos, range);
+			}
+
+			OnSymbolTableChanged ();
+		}
+
+		// <summary>
+		//   Don't send a SymbolTableChanged event for each added or removed
+		//   range until EndUpdate() is called; this is used when reading a
+		//   lot of JIT ranges at once.
+		// </summary>
+		internal void BeginUpdate ()
+		{
+			lock (this) {
+				update_level++;
+			}
+		}
+
+		internal void EndUpdate ()
+		{
+			bool changed;
+			lock (this) {
+				if (--update_level > 0)
+					return;
+
+				changed = pending_change;
+				pending_change = false;
+			}
+
+			if (changed && (SymbolTableChanged != null))
+				SymbolTableChanged ();
+		}
+
+		internal void RemoveSymbolFile (SymbolFile symfile)
+		{
+			symbol_files.Remove (symfile);
+
+			lock (this) {
+				unindexed_files.Remove (symfile);
+
+				ArrayList ranges = new ArrayList (address_ranges.Count);
+				foreach (AddressRange range in address_ranges) {
+					if (range.SymbolFile != symfile)
+						ranges.Add (range);
+				}
+				address_ranges = ranges;
+			}
+
+			OnSymbolTableChanged ();
+		}
+
+		SymbolFile find_symbol_file (TargetAddress address)
+		{
+			lock (this) {
+				int lo = 0, hi = address_ranges.Count - 1;
+				while (lo <= hi) {
+					int mid = (lo + hi) / 2;
+					AddressRange range = (AddressRange) address_ranges [mid];
+
+					if (address.Address < range.Start)
+						hi = mid - 1;
+					else if (address.Address >= range.End)
+						lo = mid + 1;
+					else
+						return range.SymbolFile;
+				}
+
+				return null;
+			}
+		}
+
+		SymbolFile[] get_unindexed_files ()
+		{
+			lock (this) {
+				SymbolFile[] files = new SymbolFile [unindexed_files.Count];
+				unindexed_files.CopyTo (files, 0);
+				return files;
+			}
+		}
+
+		void OnSymbolTableChanged ()
+		{
+			lock (this) {
+				if (update_level > 0) {
+					pending_change = true;
+					return;
+				}
+			}
+
+			if (SymbolTableChanged != null)
+				SymbolTableChanged ();
+		}
+
 		//
 		// ISymbolLookup
 		//
 
 		public Method Lookup (TargetAddress address)
 		{
-			foreach (SymbolFile symfile in symbol_files) {
+			SymbolFile symfile = find_symbol_file (address);
+			if (symfile != null) {
 				if (!symfile.SymbolsLoaded)
+					return null;
+
+				return symfile.SymbolTable.Lookup (address);
+			}
+
+			foreach (SymbolFile file in get_unindexed_files ()) {
+				if (!file.SymbolsLoaded)
 					continue;
 
-				Method method = symfile.SymbolTable.Lookup (address);
+				Method method = file.SymbolTable.Lookup (address);
 				if (method != null)
 					return method;
 			}
@@ -44,8 +233,12 @@ namespace Mono.Debugger.Backend
 
 		public Symbol SimpleLookup (TargetAddress address, bool exact_match)
 		{
-			foreach (SymbolFile symfile in symbol_files) {
-				Symbol name = symfile.SimpleLookup (address, exact_match);
+			SymbolFile symfile = find_symbol_file (address);
+			if (symfile != null)
+				return symfile.SimpleLookup (address, exact_match);
+
+			foreach (SymbolFile file in get_unindexed_files ()) {
+				Symbol name = file.SimpleLookup (address, exact_match);
 				if (name != null)
 					return name;
 			}
@@ -53,6 +246,38 @@ namespace Mono.Debugger.Backend
 			return null;
 		}
 
+		protected class AddressRange : IComparable
+		{
+			public readonly SymbolFile SymbolFile;
+			public readonly long Start;
+			public readonly long End;
+
+			public AddressRange (SymbolFile symfile, long start, long end)
+			{
+				this.SymbolFile = symfile;
+				this.Start = start;
+				this.End = end;
+			}
+
+			public int CompareTo (object obj)
+			{
+				AddressRange range = (AddressRange) obj;
+
+				if (range.Start < Start)
+					return 1;
+				else if (range.Start > Start)
+					return -1;
+				else
+					return 0;
+			}
+
+			public override string ToString ()
+			{
+				return String.Format ("AddressRange ({0:x}:{1:x}:{2})",
+						      Start, End, SymbolFile);
+			}
+		}
+
 		//
 		// ISymbolContainer
 		//
@@ -115,6 +340,10 @@ namespace Mono.Debugger.Backend
 			if (!this.disposed) {
 				if (disposing) {
 					symbol_files = ArrayList.Synchronized (new ArrayList ());
+					lock (this) {
+						address_ranges = new ArrayList ();
+						unindexed_files = new ArrayList ();
+					}
 				}
 				
 				this.disposed = true;
@@ -32,6 +32,15 @@ namespace Mono.Debugger
 			get;
 		}
 
+		// <summary>
+		//   Changes each time the target's memory may have changed, for
+		//   instance when one of its threads was resumed.  Values we read
+		//   earlier may only be reused while this stays the same.
+		// </summary>
+		internal virtual long MemoryGeneration {
+			get { return 0; }
+		}
+
 		public abstract byte ReadByte (TargetAddress address);
 
 		public abstract int ReadInteger (TargetAddress address);
@@ -46,6 +55,24 @@ namespace Mono.Debugger
 
 		public abstract byte[] ReadBuffer (TargetAddress address, int size);
 
+		// <summary>
+		//   Read several blocks of memory at once; block `i' is `sizes [i]' bytes
+		//   starting at `addresses [i]'.  Blocks which cannot be read are returned
+		//   as null rather than aborting the whole request.
+		// </summary>
+		public virtual byte[][] ReadBuffers (TargetAddress[] addresses, int[] sizes)
+		{
+			byte[][] retval = new byte [addresses.Length][];
+			for (int i = 0; i < addresses.Length; i++) {
+				try {
+					retval [i] = ReadBuffer (addresses [i], sizes [i]);
+				} catch (TargetMemoryException) {
+					retval [i] = null;
+				}
+			}
+			return retval;
+		}
+
 		public abstract Registers GetRegisters ();
 
 		public abstract bool CanWrite {
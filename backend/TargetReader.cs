@@ -9,7 +9,6 @@ namespace Mono.Debugger.Backend
 	[Serializable]
 	internal class TargetReader
 	{
-		byte[] data;
 		TargetBinaryReader reader;
 		TargetMemoryInfo info;
 
@@ -19,12 +18,15 @@ namespace Mono.Debugger.Backend
 				throw new ArgumentNullException ();
 			this.reader = new TargetBinaryReader (data, info);
 			this.info = info;
-			this.data = data;
 		}
 
-		internal TargetReader (TargetBlob data)
-			: this (data.Contents, data.TargetMemoryInfo)
-		{ }
+		internal TargetReader (TargetBlob blob)
+		{
+			if (blob == null)
+				throw new ArgumentNullException ();
+			this.reader = new TargetBinaryReader (blob);
+			this.info = blob.TargetMemoryInfo;
+		}
 
 		public long Offset {
 			get {
@@ -38,13 +40,13 @@ namespace Mono.Debugger.Backend
 
 		public long Size {
 			get {
-				return data.Length;
+				return reader.Size;
 			}
 		}
 
 		public byte[] Contents {
 			get {
-				return data;
+				return reader.Contents;
 			}
 		}
 
@@ -212,7 +214,7 @@ namespace Mono.Debugger.Backend
 
 		public override string ToString ()
 		{
-			return String.Format ("MemoryReader ([{0}])", TargetBinaryReader.HexDump (data));
+			return String.Format ("MemoryReader ([{0}])", reader.HexDump ());
 		}
 	}
 }
@@ -90,10 +90,22 @@ namespace Mono.Debugger.Backend
 			get { return tgroup; }
 		}
 
+		public virtual int StepTrapCount {
+			get { return 0; }
+		}
+
 		public abstract TargetEventArgs LastTargetEvent {
 			get;
 		}
 
+		// <summary>
+		//   Same as TargetMemoryAccess.MemoryGeneration, but may be read
+		//   from any thread without going through DoTargetAccess().
+		// </summary>
+		internal virtual long MemoryGeneration {
+			get { return 0; }
+		}
+
 		internal abstract object DoTargetAccess (TargetAccessHandler func);
 
 		public abstract TargetMemoryArea[] GetMemoryMaps ();
@@ -165,6 +177,10 @@ namespace Mono.Debugger.Backend
 		// </summary>
 		internal abstract void RemoveBreakpoint (BreakpointHandle handle);
 
+		internal abstract void SetBreakpointIgnoreCount (Breakpoint breakpoint, int count);
+
+		internal abstract BreakpointStatistics GetBreakpointStatistics (Breakpoint breakpoint);
+
 		internal abstract void AcquireThreadLock ();
 
 		internal abstract void ReleaseThreadLock ();
@@ -264,6 +280,19 @@ namespace Mono.Debugger.Backend
 
 		public abstract byte[] ReadBuffer (TargetAddress address, int size);
 
+		public virtual byte[][] ReadBuffers (TargetAddress[] addresses, int[] sizes)
+		{
+			byte[][] retval = new byte [addresses.Length][];
+			for (int i = 0; i < addresses.Length; i++) {
+				try {
+					retval [i] = ReadBuffer (addresses [i], sizes [i]);
+				} catch (TargetMemoryException) {
+					retval [i] = null;
+				}
+			}
+			return retval;
+		}
+
 		public abstract Registers GetRegisters ();
 
 		public abstract bool CanWrite {
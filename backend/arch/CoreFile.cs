@@ -15,6 +15,7 @@ namespace Mono.Debugger.Backend
 	{
 		TargetMemoryInfo info;
 		Bfd bfd, core_bfd;
+		CoreFileMemory core_memory;
 		string core_file;
 		ArrayList threads;
 
@@ -36,6 +37,7 @@ namespace Mono.Debugger.Backend
 			core_file = start.CoreFile;
 
 			core_bfd = bfd.OpenCoreFile (core_file);
+			core_memory = CoreFileMemory.Open (info, core_file);
 
 #if FIXME
 			string crash_program = core_bfd.CrashProgram;
@@ -123,7 +125,7 @@ namespace Mono.Debugger.Backend
 
 		protected TargetReader GetReader (TargetAddress address)
 		{
-			TargetReader reader = core_bfd.GetReader (address, true);
+			TargetReader reader = core_memory.GetReader (address);
 			if (reader != null)
 				return reader;
 
@@ -139,6 +141,15 @@ namespace Mono.Debugger.Backend
 				"core file.", address);
 		}
 
+		protected byte[] ReadBuffer (TargetAddress address, int size)
+		{
+			byte[] buffer = core_memory.ReadBuffer (address, size);
+			if (buffer != null)
+				return buffer;
+
+			return GetReader (address).BinaryReader.ReadBuffer (size);
+		}
+
 		void read_note_section ()
 		{
 			threads = new ArrayList ();
@@ -448,7 +459,7 @@ namespace Mono.Debugger.Backend
 
 			public override byte[] ReadBuffer (TargetAddress address, int size)
 			{
-				return CoreFile.GetReader (address).BinaryReader.ReadBuffer (size);
+				return CoreFile.ReadBuffer (address, size);
 			}
 
 			internal override Inferior.CallbackFrame GetCallbackFrame (TargetAddress stack_pointer,
@@ -507,6 +518,16 @@ namespace Mono.Debugger.Backend
 				throw new InvalidOperationException ();
 			}
 
+			internal override void SetBreakpointIgnoreCount (Breakpoint breakpoint, int count)
+			{
+				throw new InvalidOperationException ();
+			}
+
+			internal override BreakpointStatistics GetBreakpointStatistics (Breakpoint breakpoint)
+			{
+				return null;
+			}
+
 			public override CommandResult Step (ThreadingModel model, StepMode mode, StepFrame frame)
 			{
 				throw new InvalidOperationException ();
@@ -718,6 +739,8 @@ namespace Mono.Debugger.Backend
 
 		protected override void DoDispose ()
 		{
+			if (core_memory != null)
+				core_memory.Dispose ();
 			if (core_bfd != null)
 				core_bfd.Dispose ();
 			base.DoDispose ();
@@ -0,0 +1,270 @@
+using System;
+using System.Collections;
+using System.Runtime.InteropServices;
+
+using Mono.Debugger.Backend;
+
+namespace Mono.Debugger.Backend
+{
+	// <summary>
+	//   Serves memory reads from a core file.
+	//
+	//   The core file is mapped read-only and never copied; we build a
+	//   sorted table of its PT_LOAD segments and use a binary search to
+	//   find the segment containing an address.  Addresses which aren't
+	//   in the core file (because the segment wasn't dumped) must be read
+	//   from the executable or its shared libraries.
+	// </summary>
+	internal class CoreFileMemory : IDisposable
+	{
+		const int PT_LOAD = 1;
+		const int PN_XNUM = 0xffff;
+
+		//
+		// Readers are created on top of a TargetBlob, whose size is an int;
+		// so we split larger segments.
+		//
+		const long MaxChunkSize = 1L << 30;
+
+		TargetMemoryInfo info;
+		Bfd.MappedRegion mapping;
+
+		//
+		// Sorted by address and non-overlapping: the chunk at index `i'
+		// covers [starts [i], ends [i]) and starts at `offsets [i]' in the
+		// core file.
+		//
+		long[] starts;
+		long[] ends;
+		long[] offsets;
+		TargetBlob[] blobs;
+
+		int last_hit = -1;
+
+		protected CoreFileMemory (TargetMemoryInfo info, Bfd.MappedRegion mapping)
+		{
+			this.info = info;
+			this.mapping = mapping;
+
+			read_program_headers ();
+		}
+
+		public static CoreFileMemory Open (TargetMemoryInfo info, string core_file)
+		{
+			Bfd.MappedRegion mapping = Bfd.MapFile (core_file);
+			if (mapping == null)
+				throw new TargetException (
+					TargetError.CannotStartTarget, "Can't map core file {0}.",
+					core_file);
+
+			try {
+				return new CoreFileMemory (info, mapping);
+			} catch {
+				mapping.Dispose ();
+				throw;
+			}
+		}
+
+		public int Count {
+			get { return starts.Length; }
+		}
+
+		TargetBinaryReader get_header_reader (long offset, int size)
+		{
+			if ((offset < 0) || (size < 0) || (offset + size > mapping.Size))
+				throw new TargetException (
+					TargetError.CannotStartTarget, "Invalid core file.");
+
+			byte[] data = new byte [size];
+			Marshal.Copy ((IntPtr) ((long) mapping.Start + offset), data, 0, size);
+			return new TargetBinaryReader (data, info);
+		}
+
+		void read_program_headers ()
+		{
+			TargetBinaryReader ehdr = get_header_reader (0, 64);
+			if ((ehdr.PeekInt32 (0) != 0x464c457f) && (ehdr.PeekInt32 (0) != 0x7f454c46))
+				throw new TargetException (
+					TargetError.CannotStartTarget, "Core file is not an ELF file.");
+
+			bool is64 = ehdr.PeekByte (4) == 2;
+
+			long phoff, shoff;
+			int phentsize, phnum;
+			if (is64) {
+				phoff = ehdr.PeekInt64 (32);
+				shoff = ehdr.PeekInt64 (40);
+				phentsize = (ushort) ehdr.PeekInt16 (54);
+				phnum = (ushort) ehdr.PeekInt16 (56);
+			} else {
+				phoff = ehdr.PeekUInt32 (28);
+				shoff = ehdr.PeekUInt32 (32);
+				phentsize = (ushort) ehdr.PeekInt16 (42);
+				phnum = (ushort) ehdr.PeekInt16 (44);
+			}
+
+			//
+			// If there are too many segments, the real count is in the
+			// `sh_info' field of the first section header.
+			//
+			if ((phnum == PN_XNUM) && (shoff != 0)) {
+				TargetBinaryReader shdr = get_header_reader (shoff, is64 ? 64 : 40);
+				phnum = shdr.PeekInt32 (is64 ? 44 : 28);
+			}
+
+			TargetBinaryReader phdrs = get_header_reader (phoff, phnum * phentsize);
+
+			ArrayList list = new ArrayList ();
+			for (int i = 0; i < phnum; i++) {
+				long pos = i * phentsize;
+				if (phdrs.PeekInt32 (pos) != PT_LOAD)
+					continue;
+
+				long offset, vaddr, filesz;
+				if (is64) {
+					offset = phdrs.PeekInt64 (pos + 8);
+					vaddr = phdrs.PeekInt64 (pos + 16);
+					filesz = phdrs.PeekInt64 (pos + 32);
+				} else {
+					offset = phdrs.PeekUInt32 (pos + 4);
+					vaddr = phdrs.PeekUInt32 (pos + 8);
+					filesz = phdrs.PeekUInt32 (pos + 16);
+				}
+
+				// Truncated core files are quite common.
+				if (offset + filesz > mapping.Size)
+					filesz = Math.Max (0, mapping.Size - offset);
+				if (filesz == 0)
+					continue;
+
+				for (long done = 0; done < filesz; done += MaxChunkSize) {
+					long size = Math.Min (filesz - done, MaxChunkSize);
+					list.Add (new long[] { vaddr + done, size, offset + done });
+				}
+			}
+
+			list.Sort (new ChunkComparer ());
+
+			starts = new long [list.Count];
+			ends = new long [list.Count];
+			offsets = new long [list.Count];
+			blobs = new TargetBlob [list.Count];
+
+			for (int i = 0; i < list.Count; i++) {
+				long[] chunk = (long[]) list [i];
+				starts [i] = chunk [0];
+				ends [i] = chunk [0] + chunk [1];
+				offsets [i] = chunk [2];
+			}
+		}
+
+		class ChunkComparer : IComparer
+		{
+			public int Compare (object a, object b)
+			{
+				return ((long[]) a) [0].CompareTo (((long[]) b) [0]);
+			}
+		}
+
+		int find_chunk (long address)
+		{
+			int hit = last_hit;
+			if ((hit >= 0) && (address >= starts [hit]) && (address < ends [hit]))
+				return hit;
+
+			int pos = Array.BinarySearch (starts, address);
+			if (pos < 0)
+				pos = ~pos - 1;
+			if ((pos < 0) || (address >= ends [pos]))
+				return -1;
+
+			last_hit = pos;
+			return pos;
+		}
+
+		public bool Contains (TargetAddress address)
+		{
+			check_disposed ();
+			return find_chunk (address.Address) >= 0;
+		}
+
+		// <summary>
+		//   Get a reader which points directly into the core file; returns
+		//   null if `address' isn't in the core file.
+		// </summary>
+		public TargetReader GetReader (TargetAddress address)
+		{
+			check_disposed ();
+			int chunk = find_chunk (address.Address);
+			if (chunk < 0)
+				return null;
+
+			if (blobs [chunk] == null) {
+				IntPtr data = (IntPtr) ((long) mapping.Start + offsets [chunk]);
+				int size = (int) (ends [chunk] - starts [chunk]);
+				blobs [chunk] = new TargetBlob (data, size, info, mapping);
+			}
+
+			TargetReader reader = new TargetReader (blobs [chunk]);
+			reader.Offset = address.Address - starts [chunk];
+			return reader;
+		}
+
+		// <summary>
+		//   Read `size' bytes at `address', which may span several adjacent
+		//   segments; returns null if any part isn't in the core file.
+		// </summary>
+		public byte[] ReadBuffer (TargetAddress address, int size)
+		{
+			check_disposed ();
+			byte[] buffer = new byte [size];
+
+			long current = address.Address;
+			int done = 0;
+			while (done < size) {
+				int chunk = find_chunk (current);
+				if (chunk < 0)
+					return null;
+
+				int count = (int) Math.Min (size - done, ends [chunk] - current);
+				long offset = offsets [chunk] + current - starts [chunk];
+				Marshal.Copy ((IntPtr) ((long) mapping.Start + offset),
+					      buffer, done, count);
+
+				done += count;
+				current += count;
+			}
+
+			return buffer;
+		}
+
+		//
+		// IDisposable
+		//
+
+		private bool disposed = false;
+
+		private void check_disposed ()
+		{
+			if (disposed)
+				throw new ObjectDisposedException ("CoreFileMemory");
+		}
+
+		public void Dispose ()
+		{
+			lock (this) {
+				if (disposed)
+					return;
+
+				disposed = true;
+			}
+
+			//
+			// Don't unmap the core file here: it stays alive as long as
+			// somebody is still using a reader on top of one of our blobs.
+			//
+			blobs = null;
+			mapping = null;
+		}
+	}
+}
@@ -39,6 +39,16 @@ namespace Mono.Debugger.Architectures
 			get;
 		}
 
+		// <summary>
+		//   If this instruction has a 32-bit displacement relative to the
+		//   instruction pointer, its offset within `Code'; -1 otherwise.
+		//   Such an instruction may still be executed out of line after
+		//   adjusting the displacement.
+		// </summary>
+		public abstract int IpRelativeDisplacementOffset {
+			get;
+		}
+
 		public bool IsCall {
 			get {
 				return (InstructionType == Type.Call) ||
@@ -50,6 +60,15 @@ namespace Mono.Debugger.Architectures
 			get;
 		}
 
+		// <summary>
+		//   Whether execution always continues with the next instruction,
+		//   ie. this is neither a branch, call or return nor anything else
+		//   which may transfer control somewhere else.
+		// </summary>
+		public abstract bool IsStraightLine {
+			get;
+		}
+
 		public abstract int InstructionSize {
 			get;
 		}
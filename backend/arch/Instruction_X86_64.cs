@@ -57,6 +57,9 @@ namespace Mono.Debugger.Architectures
 		public override bool CanInterpretInstruction {
 			get {
 				switch (InstructionType) {
+				case Type.ConditionalJump:
+					return CanInterpretConditionalJump;
+
 				case Type.IndirectJump:
 				case Type.Jump:
 				case Type.IndirectCall:
@@ -74,6 +77,9 @@ namespace Mono.Debugger.Architectures
 		public override bool InterpretInstruction (Inferior inferior)
 		{
 			switch (InstructionType) {
+			case Type.ConditionalJump:
+				return InterpretConditionalJump (inferior);
+
 			case Type.IndirectJump:
 			case Type.Jump: {
 				TargetAddress target = GetEffectiveAddress (inferior);
@@ -62,6 +62,19 @@ namespace Mono.Debugger.Architectures
 			get { return has_insn_size; }
 		}
 
+		public override int IpRelativeDisplacementOffset {
+			get { return is_ip_relative ? ip_relative_offset : -1; }
+		}
+
+		public override bool IsStraightLine {
+			get {
+				if (!has_insn_size || is_control_transfer)
+					return false;
+
+				return (type == Type.Unknown) || (type == Type.Interpretable);
+			}
+		}
+
 		public override int InstructionSize {
 			get {
 				if (!has_insn_size)
@@ -81,6 +94,13 @@ namespace Mono.Debugger.Architectures
 		}
 
 		bool is_ip_relative;
+		int ip_relative_offset = -1;
+		bool is_control_transfer;
+
+		/* For ConditionalJump */
+		int condition_code = -1;
+		int branch_displacement;
+		byte loop_opcode;
 		bool has_insn_size;
 		int insn_size;
 		byte[] code;
@@ -293,6 +313,7 @@ namespace Mono.Debugger.Architectures
 
 			if (Is64BitMode && (ModRM.Mod == 0) && ((ModRM.R_M & 0x07) == 0x05)) {
 				is_ip_relative = true;
+				ip_relative_offset = (int) reader.Offset;
 			}
 		}
 
@@ -301,11 +322,24 @@ namespace Mono.Debugger.Architectures
 			if (OneByte_Has_ModRM [opcode] != 0)
 				DecodeModRM (reader);
 
+			//
+			// In 64-bit mode, these are VEX / EVEX / XOP prefixes and what
+			// we decoded as ModRM is really part of the prefix, so we don't
+			// know where the displacement is.
+			//
+			if (Is64BitMode && ((opcode == 0x62) || (opcode == 0xc4) || (opcode == 0xc5) ||
+					    ((opcode == 0x8f) && (ModRM.Reg != 0))))
+				ip_relative_offset = -1;
+
 			if ((opcode >= 0x70) && (opcode <= 0x7f)) {
-				CallTarget = Address + reader.BinaryReader.ReadSByte () + 2;
+				branch_displacement = reader.BinaryReader.ReadSByte ();
+				CallTarget = Address + branch_displacement + 2;
+				condition_code = opcode & 0x0f;
 				type = Type.ConditionalJump;
 			} else if ((opcode >= 0xe0) && (opcode <= 0xe3)) {
-				CallTarget = Address + reader.BinaryReader.ReadSByte () + 2;
+				branch_displacement = reader.BinaryReader.ReadSByte ();
+				CallTarget = Address + branch_displacement + 2;
+				loop_opcode = opcode;
 				type = Type.ConditionalJump;
 			} else if ((opcode == 0xe8) || (opcode == 0xe9)) {
 				if ((RexPrefix & X86_REX_Prefix.REX_W) != 0) {
@@ -337,6 +371,10 @@ namespace Mono.Debugger.Architectures
 				DecodeGroup5 (reader);
 			} else if (opcode == 0x90) {
 				type = Type.Interpretable;
+			} else if ((opcode == 0x9a) || (opcode == 0xea) ||
+				   ((opcode >= 0xca) && (opcode <= 0xcf)) || (opcode == 0xf4)) {
+				/* far call/jmp/ret, int, iret, hlt */
+				is_control_transfer = true;
 			}
 		}
 
@@ -361,8 +399,14 @@ namespace Mono.Debugger.Architectures
 				} else {
 					int offset = reader.BinaryReader.ReadInt32 ();
 					CallTarget = Address + offset + 5;
+					branch_displacement = offset;
+					condition_code = opcode & 0x0f;
 				}
 				type = Type.ConditionalJump;
+			} else if ((opcode == 0x05) || (opcode == 0x07) || (opcode == 0x0b) ||
+				   (opcode == 0x34) || (opcode == 0x35)) {
+				/* syscall, sysret, ud2, sysenter, sysexit */
+				is_control_transfer = true;
 			}
 		}
 
@@ -442,6 +486,100 @@ namespace Mono.Debugger.Architectures
 			DereferenceAddress = dereference_addr;
 		}
 
+		static bool evaluate_condition (int condition_code, long flags)
+		{
+			bool cf = (flags & 0x0001) != 0;
+			bool pf = (flags & 0x0004) != 0;
+			bool zf = (flags & 0x0040) != 0;
+			bool sf = (flags & 0x0080) != 0;
+			bool of = (flags & 0x0800) != 0;
+
+			bool result;
+			switch (condition_code >> 1) {
+			case 0: /* jo */
+				result = of;
+				break;
+			case 1: /* jb */
+				result = cf;
+				break;
+			case 2: /* je */
+				result = zf;
+				break;
+			case 3: /* jbe */
+				result = cf || zf;
+				break;
+			case 4: /* js */
+				result = sf;
+				break;
+			case 5: /* jp */
+				result = pf;
+				break;
+			case 6: /* jl */
+				result = sf != of;
+				break;
+			default: /* jle */
+				result = zf || (sf != of);
+				break;
+			}
+
+			/* Odd condition codes are the negated forms. */
+			if ((condition_code & 1) != 0)
+				return !result;
+			return result;
+		}
+
+		protected bool CanInterpretConditionalJump {
+			get {
+				if ((Prefix & (X86_Prefix.DATA | X86_Prefix.ADDR)) != 0)
+					return false;
+
+				return (condition_code >= 0) || (loop_opcode != 0);
+			}
+		}
+
+		// <summary>
+		//   Emulate a conditional jump, jcxz or loop instruction by
+		//   evaluating its condition against the current registers.
+		// </summary>
+		protected bool InterpretConditionalJump (Inferior inferior)
+		{
+			if (!CanInterpretConditionalJump)
+				return false;
+
+			Registers regs = inferior.GetRegisters ();
+			long flags = regs [(int) X86_Register.EFLAGS].GetValue ();
+
+			bool taken;
+			if (loop_opcode != 0) {
+				long mask = Is64BitMode ? -1 : 0xffffffffL;
+				long count = regs [(int) X86_Register.RCX].GetValue () & mask;
+
+				if (loop_opcode == 0xe3) /* jrcxz */
+					taken = count == 0;
+				else {
+					count = (count - 1) & mask;
+					regs [(int) X86_Register.RCX].SetValue (count);
+
+					bool zf = (flags & 0x0040) != 0;
+					taken = count != 0;
+					if (loop_opcode == 0xe0) /* loopne */
+						taken &= !zf;
+					else if (loop_opcode == 0xe1) /* loope */
+						taken &= zf;
+				}
+			} else {
+				taken = evaluate_condition (condition_code, flags);
+			}
+
+			TargetAddress target = Address + InstructionSize;
+			if (taken)
+				target += branch_displacement;
+
+			regs [(int) X86_Register.RIP].SetValue (target);
+			inferior.SetRegisters (regs);
+			return true;
+		}
+
 		public override TargetAddress GetEffectiveAddress (TargetMemoryAccess memory)
 		{
 			if (!CallTarget.IsNull)
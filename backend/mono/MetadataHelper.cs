@@ -75,117 +75,167 @@ namespace Mono.Debugger.Backend.Mono
 			return memory.ReadAddress (klass + MonoMetadataInfo.KlassImageOffset);
 		}
 
-		public int MonoClassGetToken (TargetMemoryAccess memory,
-					      TargetAddress klass)
+		public TargetAddress MonoClassGetByValType (TargetMemoryAccess memory,
+							    TargetAddress klass)
 		{
-			return memory.ReadInteger (klass + MonoMetadataInfo.KlassTokenOffset);
+			return klass + MonoMetadataInfo.KlassByValArgOffset;
 		}
 
-		public int MonoClassGetInstanceSize (TargetMemoryAccess memory,
-						     TargetAddress klass)
+		public MonoClassSnapshot GetClassSnapshot (TargetMemoryAccess memory,
+							   TargetAddress klass)
 		{
-			int flags = memory.ReadInteger (klass + 4 * memory.TargetAddressSize);
+			return new MonoClassSnapshot (this, memory, klass);
+		}
 
-			bool size_inited = (flags & 4) != 0;
-			bool valuetype = (flags & 8) != 0;
+		// <summary>
+		//   A copy of a `MonoClass' which we read with a single memory access.
+		// </summary>
+		// <remarks>
+		//   The `MonoClassField' and method arrays are read in one piece the
+		//   first time they're needed.  The field, method and instance size
+		//   entries are only filled in when the runtime initializes the class,
+		//   so we read the header again if we find them still empty.
+		// </remarks>
+		public class MonoClassSnapshot
+		{
+			public readonly TargetAddress Klass;
+			public readonly TargetAddress Image;
+			public readonly int Token;
+			public readonly TargetAddress Parent;
+			public readonly TargetAddress GenericClass;
+			public readonly TargetAddress GenericContainer;
+
+			MetadataInfo metadata;
+			int addr_size;
+
+			int flags;
+			int instance_size;
+			TargetAddress fields_addr;
+			int field_count;
+			TargetAddress methods_addr;
+			int method_count;
+
+			TargetReader fields;
+			TargetReader methods;
+
+			public MonoClassSnapshot (MetadataHelper helper, TargetMemoryAccess memory,
+						  TargetAddress klass)
+			{
+				this.metadata = helper.MonoMetadataInfo;
+				this.addr_size = memory.TargetMemoryInfo.TargetAddressSize;
+				this.Klass = klass;
 
-			if (!size_inited)
-				throw new TargetException (TargetError.ClassNotInitialized);
+				TargetReader reader = read_header (memory);
+				Image = reader.PeekAddress (metadata.KlassImageOffset);
+				Token = reader.PeekInteger (metadata.KlassTokenOffset);
+				Parent = reader.PeekAddress (metadata.KlassParentOffset);
+				GenericClass = reader.PeekAddress (metadata.KlassGenericClassOffset);
+				GenericContainer = reader.PeekAddress (metadata.KlassGenericContainerOffset);
+			}
 
-			int size = memory.ReadInteger (klass + 4 + 3 * memory.TargetAddressSize);
-			if (valuetype)
-				size -= 2 * memory.TargetAddressSize;
+			TargetReader read_header (TargetMemoryAccess memory)
+			{
+				TargetReader reader = new TargetReader (
+					memory.ReadMemory (Klass, metadata.KlassSize));
 
-			return size;
-		}
+				flags = reader.PeekInteger (4 * addr_size);
+				instance_size = reader.PeekInteger (4 + 3 * addr_size);
+				fields_addr = reader.PeekAddress (metadata.KlassFieldOffset);
+				field_count = reader.PeekInteger (metadata.KlassFieldCountOffset);
+				methods_addr = reader.PeekAddress (metadata.KlassMethodsOffset);
+				method_count = reader.PeekInteger (metadata.KlassMethodCountOffset);
 
-		public TargetAddress MonoClassGetParent (TargetMemoryAccess memory,
-							 TargetAddress klass)
-		{
-			return memory.ReadAddress (klass + MonoMetadataInfo.KlassParentOffset);
-		}
+				return reader;
+			}
 
-		public TargetAddress MonoClassGetGenericClass (TargetMemoryAccess memory,
-							       TargetAddress klass)
-		{
-			return memory.ReadAddress (klass + MonoMetadataInfo.KlassGenericClassOffset);
-		}
+			public TargetAddress ByValType {
+				get { return Klass + metadata.KlassByValArgOffset; }
+			}
 
-		public TargetAddress MonoClassGetGenericContainer (TargetMemoryAccess memory,
-								   TargetAddress klass)
-		{
-			return memory.ReadAddress (klass + MonoMetadataInfo.KlassGenericContainerOffset);
-		}
+			public int GetInstanceSize (TargetMemoryAccess memory)
+			{
+				if ((flags & 4) == 0)
+					read_header (memory);
 
-		public TargetAddress MonoClassGetByValType (TargetMemoryAccess memory,
-							    TargetAddress klass)
-		{
-			return klass + MonoMetadataInfo.KlassByValArgOffset;
-		}
+				bool size_inited = (flags & 4) != 0;
+				bool valuetype = (flags & 8) != 0;
 
-		public bool MonoClassHasFields (TargetMemoryAccess memory, TargetAddress klass)
-		{
-			TargetAddress fields = memory.ReadAddress (
-				klass + MonoMetadataInfo.KlassFieldOffset);
-			return !fields.IsNull;
-		}
+				if (!size_inited)
+					throw new TargetException (TargetError.ClassNotInitialized);
 
-		public int MonoClassGetFieldCount (TargetMemoryAccess memory, TargetAddress klass)
-		{
-			return memory.ReadInteger (klass + MonoMetadataInfo.KlassFieldCountOffset);
-		}
+				if (valuetype)
+					return instance_size - 2 * addr_size;
 
-		public TargetAddress MonoClassGetFieldType (TargetMemoryAccess memory, TargetAddress klass,
-							    int index)
-		{
-			int offset = index * MonoMetadataInfo.FieldInfoSize +
-				MonoMetadataInfo.FieldInfoTypeOffset;
+				return instance_size;
+			}
 
-			TargetAddress fields = memory.ReadAddress (
-				klass + MonoMetadataInfo.KlassFieldOffset);
-			if (fields.IsNull)
-				throw new TargetException (TargetError.ClassNotInitialized);
+			public bool HasFields (TargetMemoryAccess memory)
+			{
+				if (fields_addr.IsNull)
+					read_header (memory);
+				return !fields_addr.IsNull;
+			}
 
-			return memory.ReadAddress (fields + offset);
-		}
+			public int GetFieldCount (TargetMemoryAccess memory)
+			{
+				if (fields_addr.IsNull)
+					read_header (memory);
+				return field_count;
+			}
 
-		public int MonoClassGetFieldOffset (TargetMemoryAccess memory, TargetAddress klass,
-						    int index)
-		{
-			int offset = index * MonoMetadataInfo.FieldInfoSize +
-				MonoMetadataInfo.FieldInfoOffsetOffset;
+			TargetReader read_fields (TargetMemoryAccess memory)
+			{
+				if (fields != null)
+					return fields;
 
-			TargetAddress fields = memory.ReadAddress (
-				klass + MonoMetadataInfo.KlassFieldOffset);
-			if (fields.IsNull)
-				throw new TargetException (TargetError.ClassNotInitialized);
+				if (!HasFields (memory))
+					throw new TargetException (TargetError.ClassNotInitialized);
 
-			return memory.ReadInteger (fields + offset);
-		}
+				fields = new TargetReader (
+					memory.ReadMemory (fields_addr, field_count * metadata.FieldInfoSize));
+				return fields;
+			}
 
-		public bool MonoClassHasMethods (TargetMemoryAccess memory, TargetAddress klass)
-		{
-			TargetAddress methods = memory.ReadAddress (
-				klass + MonoMetadataInfo.KlassMethodsOffset);
-			return !methods.IsNull;
-		}
+			public TargetAddress GetFieldType (TargetMemoryAccess memory, int index)
+			{
+				TargetReader reader = read_fields (memory);
+				return reader.PeekAddress (
+					index * metadata.FieldInfoSize + metadata.FieldInfoTypeOffset);
+			}
 
-		public int MonoClassGetMethodCount (TargetMemoryAccess memory, TargetAddress klass)
-		{
-			return memory.ReadInteger (klass + MonoMetadataInfo.KlassMethodCountOffset);
-		}
+			public int GetFieldOffset (TargetMemoryAccess memory, int index)
+			{
+				TargetReader reader = read_fields (memory);
+				return reader.PeekInteger (
+					index * metadata.FieldInfoSize + metadata.FieldInfoOffsetOffset);
+			}
 
-		public TargetAddress MonoClassGetMethod (TargetMemoryAccess memory, TargetAddress klass,
-							 int index)
-		{
-			TargetAddress methods = memory.ReadAddress (
-				klass + MonoMetadataInfo.KlassMethodsOffset);
+			public bool HasMethods (TargetMemoryAccess memory)
+			{
+				if (methods_addr.IsNull)
+					read_header (memory);
+				return !methods_addr.IsNull;
+			}
 
-			if (methods.IsNull)
-				throw new TargetException (TargetError.ClassNotInitialized);
+			public int GetMethodCount (TargetMemoryAccess memory)
+			{
+				if (methods_addr.IsNull)
+					read_header (memory);
+				return method_count;
+			}
 
-			methods += index * memory.TargetAddressSize;
-			return memory.ReadAddress (methods);
+			public TargetAddress GetMethod (TargetMemoryAccess memory, int index)
+			{
+				if (methods == null) {
+					if (!HasMethods (memory))
+						throw new TargetException (TargetError.ClassNotInitialized);
+
+					methods = new TargetReader (
+						memory.ReadMemory (methods_addr, method_count * addr_size));
+				}
+
+				return methods.PeekAddress (index * addr_size);
+			}
 		}
 
 		//
@@ -5,6 +5,7 @@ using System.Reflection;
 using System.Runtime.InteropServices;
 using System.Collections;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Threading;
 using C = Mono.CompilerServices.SymbolWriter;
 
@@ -124,7 +125,11 @@ namespace Mono.Debugger.Backend.Mono
 			this.current_chunk = first_chunk;
 		}
 
-		public void Read (TargetMemoryAccess memory)
+		// <summary>
+		//   Read all the data items which were added since we were last
+		//   called and return their number.
+		// </summary>
+		public int Read (TargetMemoryAccess memory)
 		{
 			int address_size = memory.TargetMemoryInfo.TargetAddressSize;
 			int header_size = 16 + address_size;
@@ -135,7 +140,9 @@ namespace Mono.Debugger.Backend.Mono
 			}
 
 			if (current_chunk.IsNull)
-				return;
+				return 0;
+
+			int count = 0;
 
 		again:
 			TargetReader reader = new TargetReader (
@@ -147,8 +154,13 @@ namespace Mono.Debugger.Backend.Mono
 			reader.ReadInteger (); /* dummy */
 			TargetAddress next = reader.ReadAddress ();
 
-			read_data_items (memory, current_chunk + header_size,
-					 last_offset, current_offset);
+			//
+			// Most of the time, nothing has changed since the last time;
+			// don't even ask the target for an empty block then.
+			//
+			if (current_offset > last_offset)
+				count += read_data_items (memory, current_chunk + header_size,
+							  last_offset, current_offset);
 
 			last_offset = current_offset;
 
@@ -157,10 +169,12 @@ namespace Mono.Debugger.Backend.Mono
 				last_offset = 0;
 				goto again;
 			}
+
+			return count;
 		}
 
-		void read_data_items (TargetMemoryAccess memory, TargetAddress address,
-				      int start, int end)
+		int read_data_items (TargetMemoryAccess memory, TargetAddress address,
+				     int start, int end)
 		{
 			TargetReader reader = new TargetReader (
 				memory.ReadMemory (address + start, end - start));
@@ -169,6 +183,7 @@ namespace Mono.Debugger.Backend.Mono
 				      "READ DATA ITEMS: {0} {1} {2} - {3} {4}", address,
 				      start, end, reader.BinaryReader.Position, reader.Size);
 
+			int count = 0;
 			while (reader.BinaryReader.Position + 4 < reader.Size) {
 				int item_size = reader.BinaryReader.ReadInt32 ();
 				if (item_size == 0)
@@ -179,9 +194,12 @@ namespace Mono.Debugger.Backend.Mono
 				long pos = reader.BinaryReader.Position;
 
 				ReadDataItem (memory, item_type, reader);
+				count++;
 
 				reader.BinaryReader.Position = pos + item_size;
 			}
+
+			return count;
 		}
 
 		protected enum DataItemType {
@@ -641,14 +659,25 @@ namespace Mono.Debugger.Backend.Mono
 		{
 			Report.Debug (DebugFlags.JitSymtab, "Update requested");
 			if (initialized) {
-				DateTime start = DateTime.Now;
+				Stopwatch watch = StartTiming ();
 				++data_table_count;
-				foreach (MonoDataTable table in data_tables.Values)
-					table.Read (target);
-				foreach (MonoSymbolFile symfile in symfile_by_index.Values)
-					symfile.TypeTable.Read (target);
-				global_data_table.Read (target);
-				data_table_time += DateTime.Now - start;
+				int count = 0;
+				process.SymbolTableManager.BeginUpdate ();
+				try {
+					foreach (MonoDataTable table in data_tables.Values)
+						count += table.Read (target);
+					foreach (MonoSymbolFile symfile in symfile_by_index.Values)
+						count += symfile.TypeTable.Read (target);
+					count += global_data_table.Read (target);
+				} finally {
+					process.SymbolTableManager.EndUpdate ();
+				}
+				if (count > 0) {
+					++update_count;
+					data_item_count += count;
+				}
+				if (watch != null)
+					data_table_time += watch.Elapsed;
 			}
 		}
 
@@ -659,10 +688,11 @@ namespace Mono.Debugger.Backend.Mono
 
 			Report.Debug (DebugFlags.JitSymtab, "Starting to read symbol table");
 			try {
-				DateTime start = DateTime.Now;
+				Stopwatch watch = StartTiming ();
 				++full_update_count;
 				do_read_symbol_table (memory);
-				update_time += DateTime.Now - start;
+				if (watch != null)
+					update_time += watch.Elapsed;
 			} catch (ThreadAbortException) {
 				return;
 			} catch (SymbolTableException ex) {
@@ -723,6 +753,7 @@ namespace Mono.Debugger.Backend.Mono
 			assembly_hash.Remove (symfile.Assembly);
 			assembly_by_name.Remove (symfile.Assembly.Name.FullName);
 			symfile_by_index.Remove (symfile.Index);
+			process.SymbolTableManager.RemoveSymbolFile (symfile);
 		}
 
 		// This method reads the MonoDebuggerSymbolTable structure
@@ -902,25 +933,54 @@ namespace Mono.Debugger.Backend.Mono
 			}
 		}
 
-		static int manual_update_count;
-		static int full_update_count;
-		static int update_count;
-		static int data_table_count;
-		static TimeSpan data_table_time;
-		static TimeSpan update_time;
-		static int range_entry_count;
-		static TimeSpan range_entry_time;
-		static TimeSpan range_entry_method_time;
+		int full_update_count;
+		int update_count;
+		int data_table_count;
+		int data_item_count;
+		TimeSpan data_table_time;
+		TimeSpan update_time;
+		int range_entry_count;
+		TimeSpan range_entry_time;
+		TimeSpan range_entry_method_time;
 
-		public static void RangeEntryCreated (TimeSpan time)
+		// <summary>
+		//   Returns a running stopwatch if `config +symtab-stats' is on, so
+		//   that we don't pay for the timing on every JIT notification.
+		// </summary>
+		internal Stopwatch StartTiming ()
+		{
+			if (!process.Session.Config.SymbolTableStatistics)
+				return null;
+
+			return Stopwatch.StartNew ();
+		}
+
+		internal SymbolTableStatistics GetStatistics ()
+		{
+			SymbolTableStatistics stats = new SymbolTableStatistics ();
+			stats.FullUpdateCount = full_update_count;
+			stats.UpdateTime = update_time;
+			stats.DataTableCount = data_table_count;
+			stats.UpdateCount = update_count;
+			stats.DataItemCount = data_item_count;
+			stats.DataTableTime = data_table_time;
+			stats.RangeEntryCount = range_entry_count;
+			stats.RangeEntryTime = range_entry_time;
+			stats.RangeEntryMethodTime = range_entry_method_time;
+			return stats;
+		}
+
+		internal void RangeEntryCreated (Stopwatch watch)
 		{
 			range_entry_count++;
-			range_entry_time += time;
+			if (watch != null)
+				range_entry_time += watch.Elapsed;
 		}
 
-		public static void RangeEntryGetMethod (TimeSpan time)
+		internal void RangeEntryGetMethod (Stopwatch watch)
 		{
-			range_entry_method_time += time;
+			if (watch != null)
+				range_entry_method_time += watch.Elapsed;
 		}
 
 		internal MonoClassInfo ReadClassInfo (TargetMemoryAccess memory, TargetAddress klass)
@@ -1348,6 +1408,79 @@ namespace Mono.Debugger.Backend.Mono
 		void unload_appdomain (int id)
 		{
 			appdomain_info.Remove (id);
+
+			lock (static_field_data)
+				static_field_data.Remove (id);
+		}
+
+		Dictionary<int,Dictionary<TargetAddress,TargetAddress>> static_field_data =
+			new Dictionary<int,Dictionary<TargetAddress,TargetAddress>> ();
+
+		// <summary>
+		//   Returns the address of the static fields of class @klass in
+		//   @thread's current appdomain.
+		// </summary>
+		// <remarks>
+		//   We need to call into the runtime to get it, but it doesn't change
+		//   once the class is initialized, so we cache it until the domain is
+		//   unloaded.
+		// </remarks>
+		internal TargetAddress GetStaticFieldData (Thread thread, TargetAddress klass)
+		{
+			int domain = get_static_field_domain (thread.CurrentFrame);
+
+			Dictionary<TargetAddress,TargetAddress> hash = null;
+			if (domain >= 0) {
+				lock (static_field_data) {
+					if (!static_field_data.TryGetValue (domain, out hash)) {
+						hash = new Dictionary<TargetAddress,TargetAddress> ();
+						static_field_data.Add (domain, hash);
+					}
+
+					TargetAddress cached;
+					if (hash.TryGetValue (klass, out cached))
+						return cached;
+				}
+			}
+
+			TargetAddress data = thread.CallMethod (
+				MonoDebuggerInfo.ClassGetStaticFieldData, klass, 0);
+
+			if ((hash != null) && !data.IsNull) {
+				lock (static_field_data)
+					hash [klass] = data;
+			}
+
+			return data;
+		}
+
+		// <summary>
+		//   The runtime uses the thread's current appdomain, which we can't
+		//   read.  It is the domain of the current frame's method, unless
+		//   that's a wrapper, which may switch domains, or domain-neutral
+		//   code in the root domain, which runs in all domains.  Returns -1
+		//   if we don't know the domain and mustn't cache the address.
+		// </summary>
+		int get_static_field_domain (StackFrame frame)
+		{
+			Method method = frame.Method;
+			if ((method == null) || method.IsWrapper)
+				return -1;
+
+			if ((method.Domain == 0) && has_secondary_appdomains ())
+				return -1;
+
+			return method.Domain;
+		}
+
+		bool has_secondary_appdomains ()
+		{
+			foreach (int id in data_tables.Keys) {
+				if (id != 0)
+					return true;
+			}
+
+			return false;
 		}
 
 		bool is_shadow_copy_path (string path)
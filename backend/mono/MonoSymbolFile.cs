@@ -328,24 +328,30 @@ namespace Mono.Debugger.Backend.Mono
 			get { return File != null; }
 		}
 
-		internal void AddRangeEntry (TargetMemoryAccess memory, TargetReader reader,
-					     byte[] contents)
+		RangeEntry add_range_entry (TargetMemoryAccess memory, TargetReader reader,
+					    byte[] contents)
 		{
 			RangeEntry range = RangeEntry.Create (this, memory, reader, contents);
 			if (!range_hash.Contains (range.Hash)) {
 				range_hash.Add (range.Hash, range);
 				ranges.Add (range);
+				process.SymbolTableManager.AddAddressRange (
+					this, range.StartAddress, range.EndAddress);
+				symtab.AddRange (range);
 			}
+			return range;
+		}
+
+		internal void AddRangeEntry (TargetMemoryAccess memory, TargetReader reader,
+					     byte[] contents)
+		{
+			add_range_entry (memory, reader, contents);
 		}
 
 		internal Method ReadRangeEntry (TargetMemoryAccess memory, TargetReader reader,
 						byte[] contents)
 		{
-			RangeEntry range = RangeEntry.Create (this, memory, reader, contents);
-			if (!range_hash.Contains (range.Hash)) {
-				range_hash.Add (range.Hash, range);
-				ranges.Add (range);
-			}
+			RangeEntry range = add_range_entry (memory, reader, contents);
 			return range.GetMethod ();
 		}
 
@@ -1607,36 +1613,19 @@ namespace Mono.Debugger.Backend.Mono
 				if ((Addresses == null) || (line < StartRow) || (line > EndRow))
 					return TargetAddress.Null;
 
-				bool found_a_range = false;
-
-				for (int i = 0; i < Addresses.Length; i++) {
-					LineEntry entry = (LineEntry) Addresses [i];
-
-					if (entry.SourceRange == null)
-						continue;
-
-					SourceRange range = entry.SourceRange.Value;
-					found_a_range = true;
-
-					if ((line < range.StartLine) || (line > range.EndLine))
-						continue;
-					if ((line == range.StartLine) && (column < range.StartColumn))
-						continue;
-					if ((line == range.EndLine) && (column > range.EndColumn))
-						continue;
-
-					return entry.Address;
-				}
-
 				//
 				// If the symbol file doesn't contain any source ranges for this
 				// method, default to traditional line-based lookup.
 				//
 
-				if (!found_a_range)
+				if (!Data.HasSourceRanges)
 					return Lookup (line);
 
-				return TargetAddress.Null;
+				int index = Data.LookupRange (line, column);
+				if (index < 0)
+					return TargetAddress.Null;
+
+				return Addresses [index].Address;
 			}
 
 			public override TargetAddress Lookup (int line)
@@ -1644,14 +1633,11 @@ namespace Mono.Debugger.Backend.Mono
 				if ((Addresses == null) || (line < StartRow) || (line > EndRow))
 					return TargetAddress.Null;
 
-				for (int i = 0; i < Addresses.Length; i++) {
-					LineEntry entry = (LineEntry) Addresses [i];
-
-					if (line <= entry.Line)
-						return entry.Address;
-				}
+				int index = Data.LookupLine (line);
+				if (index < 0)
+					return TargetAddress.Null;
 
-				return TargetAddress.Null;
+				return Addresses [index].Address;
 			}
 
 			public override SourceAddress Lookup (TargetAddress address)
@@ -1662,30 +1648,21 @@ namespace Mono.Debugger.Backend.Mono
 				if (Addresses.Length < 1)
 					return null;
 
-				TargetAddress next_address = end;
-				TargetAddress next_not_hidden = end;
-
-				for (int i = Addresses.Length-1; i >= 0; i--) {
-					LineEntry entry = (LineEntry) Addresses [i];
-
-					int range = (int) (next_not_hidden - address);
-
-					next_address = entry.Address;
-					if (!entry.IsHidden)
-						next_not_hidden = entry.Address;
-
-					if (next_address > address)
-						continue;
+				int index = Data.LookupAddress (address);
+				if (index < 0)
+					return create_address (Addresses [0], (int) (address - start),
+							       (int) (Addresses [0].Address - address));
 
-					int offset = (int) (address - next_address);
-					return create_address (entry, offset, range);
-				}
+				LineEntry entry = Addresses [index];
 
-				if (Addresses.Length < 1)
-					return null;
+				//
+				// The range extends to the next line which isn't hidden.
+				//
+				int next = Data.NextVisible (index);
+				TargetAddress next_not_hidden = (next >= 0) ? Addresses [next].Address : end;
 
-				return create_address (Addresses [0], (int) (address - start),
-						       (int) (Addresses [0].Address - address));
+				return create_address (entry, (int) (address - entry.Address),
+						       (int) (next_not_hidden - address));
 			}
 
 			SourceAddress create_address (LineEntry entry, int line_offset, int line_range)
@@ -1728,17 +1705,160 @@ namespace Mono.Debugger.Backend.Mono
 				writer.WriteLine ("----------------------------------------");
 			}
 
+			// <summary>
+			//   The line number table; `Addresses' is sorted by address.
+			//   We also build some indices to avoid linear searches.
+			// </summary>
 			protected class LineNumberTableData
 			{
 				public readonly int StartRow;
 				public readonly int EndRow;
 				public readonly LineEntry[] Addresses;
 
+				//
+				// max_lines [i] is the largest line number in Addresses [0..i];
+				// it's sorted, so we can search it for the first entry with a
+				// line number >= some line.
+				//
+				int[] max_lines;
+
+				//
+				// The index of the next entry which isn't hidden, or -1.
+				//
+				int[] next_visible;
+
+				//
+				// The entries with a source range, sorted by their start line
+				// and then by their index: ((long) start line << 32) | index.
+				// No range spans more than `max_range_lines' lines.
+				//
+				long[] ranges;
+				int max_range_lines;
+
 				public LineNumberTableData (int start, int end, LineEntry[] addresses)
 				{
 					this.StartRow = start;
 					this.EndRow = end;
 					this.Addresses = addresses;
+
+					build_index ();
+				}
+
+				void build_index ()
+				{
+					int count = Addresses.Length;
+
+					max_lines = new int [count];
+					for (int i = 0; i < count; i++) {
+						int line = Addresses [i].Line;
+						max_lines [i] = (i > 0) ? Math.Max (max_lines [i-1], line) : line;
+					}
+
+					next_visible = new int [count];
+					int next = -1;
+					for (int i = count - 1; i >= 0; i--) {
+						next_visible [i] = next;
+						if (!Addresses [i].IsHidden)
+							next = i;
+					}
+
+					List<long> list = new List<long> ();
+					for (int i = 0; i < count; i++) {
+						if (Addresses [i].SourceRange == null)
+							continue;
+
+						SourceRange range = Addresses [i].SourceRange.Value;
+						list.Add (((long) range.StartLine << 32) | (uint) i);
+						max_range_lines = Math.Max (
+							max_range_lines, range.EndLine - range.StartLine);
+					}
+
+					if (list.Count > 0) {
+						ranges = list.ToArray ();
+						Array.Sort (ranges);
+					}
+				}
+
+				public bool HasSourceRanges {
+					get { return ranges != null; }
+				}
+
+				// <summary>
+				//   The first entry whose line is >= `line', or -1.
+				// </summary>
+				public int LookupLine (int line)
+				{
+					int lo = 0, hi = max_lines.Length - 1, found = -1;
+					while (lo <= hi) {
+						int mid = (lo + hi) / 2;
+						if (max_lines [mid] >= line) {
+							found = mid;
+							hi = mid - 1;
+						} else
+							lo = mid + 1;
+					}
+
+					return found;
+				}
+
+				// <summary>
+				//   The first entry whose source range contains `line' and
+				//   `column', or -1.
+				// </summary>
+				public int LookupRange (int line, int column)
+				{
+					if (ranges == null)
+						return -1;
+
+					long first = (long) (line - max_range_lines) << 32;
+					int pos = Array.BinarySearch (ranges, first);
+					if (pos < 0)
+						pos = ~pos;
+
+					int found = -1;
+					for (; pos < ranges.Length; pos++) {
+						if ((int) (ranges [pos] >> 32) > line)
+							break;
+
+						int index = (int) (ranges [pos] & 0xffffffff);
+						if ((found >= 0) && (index > found))
+							continue;
+
+						SourceRange range = Addresses [index].SourceRange.Value;
+						if ((line < range.StartLine) || (line > range.EndLine))
+							continue;
+						if ((line == range.StartLine) && (column < range.StartColumn))
+							continue;
+						if ((line == range.EndLine) && (column > range.EndColumn))
+							continue;
+
+						found = index;
+					}
+
+					return found;
+				}
+
+				// <summary>
+				//   The last entry whose address is <= `address', or -1.
+				// </summary>
+				public int LookupAddress (TargetAddress address)
+				{
+					int lo = 0, hi = Addresses.Length - 1, found = -1;
+					while (lo <= hi) {
+						int mid = (lo + hi) / 2;
+						if (Addresses [mid].Address <= address) {
+							found = mid;
+							lo = mid + 1;
+						} else
+							hi = mid - 1;
+					}
+
+					return found;
+				}
+
+				public int NextVisible (int index)
+				{
+					return next_visible [index];
 				}
 			}
 		}
@@ -1905,6 +2025,7 @@ namespace Mono.Debugger.Backend.Mono
 			public static RangeEntry Create (MonoSymbolFile file, TargetMemoryAccess memory,
 							 TargetReader reader, byte[] contents)
 			{
+				Stopwatch watch = file.MonoLanguage.StartTiming ();
 				int domain = reader.BinaryReader.ReadInt32 ();
 				int index = reader.BinaryReader.ReadInt32 ();
 
@@ -1934,17 +2055,25 @@ namespace Mono.Debugger.Backend.Mono
 						wrapper_addr, (WrapperType) wrapper_type, name, cil_code);
 				}
 
-				return new RangeEntry (
+				RangeEntry entry = new RangeEntry (
 					file, domain, index, wrapper, method,
 					code_start, code_start + code_size, contents);
+
+				file.MonoLanguage.RangeEntryCreated (watch);
+				return entry;
 			}
 
 			internal Method GetMethod ()
 			{
-				if (Wrapper != null)
-					return File.GetWrapperMethod (Hash, Wrapper, Contents);
-				else
-					return File.GetMonoMethod (Hash, Index, Contents);
+				Stopwatch watch = File.MonoLanguage.StartTiming ();
+				try {
+					if (Wrapper != null)
+						return File.GetWrapperMethod (Hash, Wrapper, Contents);
+					else
+						return File.GetMonoMethod (Hash, Index, Contents);
+				} finally {
+					File.MonoLanguage.RangeEntryGetMethod (watch);
+				}
 			}
 
 			protected override ISymbolLookup GetSymbolLookup ()
@@ -2284,6 +2413,14 @@ namespace Mono.Debugger.Backend.Mono
 			{
 				base.UpdateSymbolTable ();
 			}
+
+			// <summary>
+			//   `range' was just added to the file's SymbolRanges.
+			// </summary>
+			public void AddRange (RangeEntry range)
+			{
+				RangeAdded (range);
+			}
 		}
 	}
 }
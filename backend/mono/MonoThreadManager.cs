@@ -113,6 +113,26 @@ namespace Mono.Debugger.Backend.Mono
 			private set;
 		}
 
+		TargetAddress executable_code_buffer = TargetAddress.Null;
+
+		// <summary>
+		//   Whether `target' can be addressed with a 32-bit displacement
+		//   from the end of an instruction placed anywhere in the code buffer.
+		// </summary>
+		internal bool IsReachableFromCodeBuffer (TargetAddress target)
+		{
+			if (executable_code_buffer.IsNull)
+				return false;
+
+			long start = executable_code_buffer.Address;
+			long end = start + debugger_info.ExecutableCodeBufferSize;
+
+			long distance1 = target.Address - start;
+			long distance2 = target.Address - end;
+
+			return (distance1 == (int) distance1) && (distance2 == (int) distance2);
+		}
+
 		[DllImport("monodebuggerserver")]
 		static extern IntPtr mono_debugger_server_initialize_mono_runtime (
 			int address_size, long notification_address,
@@ -133,6 +153,7 @@ namespace Mono.Debugger.Backend.Mono
 			TargetAddress executable_code_buffer = inferior.ReadAddress (
 				debugger_info.ExecutableCodeBuffer);
 			HasCodeBuffer = !executable_code_buffer.IsNull;
+			this.executable_code_buffer = executable_code_buffer;
 
 			mono_runtime_info = mono_debugger_server_initialize_mono_runtime (
 				inferior.TargetAddressSize,
@@ -160,6 +181,7 @@ namespace Mono.Debugger.Backend.Mono
 		internal void InitCodeBuffer (Inferior inferior, TargetAddress code_buffer)
 		{
 			HasCodeBuffer = true;
+			executable_code_buffer = code_buffer;
 			mono_debugger_server_initialize_code_buffer (
 				mono_runtime_info, code_buffer.Address,
 				debugger_info.ExecutableCodeBufferSize);
@@ -22,16 +22,18 @@ namespace Mono.Debugger.Backend
 		protected BfdSymbolFile symfile;
 		TargetAddress entry_point = TargetAddress.Null;
 		bool is_loaded;
-		Hashtable symbols;
-		Hashtable local_symbols;
-		ArrayList simple_symbols;
+		SymbolArena symbol_arena;
 		BfdSymbolTable simple_symtab;
+		SymbolIndexCache symbol_index_cache;
+		string symbol_index_key;
 		DwarfReader dwarf;
 		DwarfFrameReader frame_reader, eh_frame_reader;
 		bool dwarf_loaded;
 		bool frames_loaded;
 		bool has_debugging_info;
 		string filename, target;
+		long file_size;
+		DateTime file_mtime;
 		bool is_coredump;
 		bool initialized;
 		bool has_shlib_info;
@@ -73,10 +75,10 @@ namespace Mono.Debugger.Backend
 
 			object get_section_contents (object user_data)
 			{
-				byte[] data = bfd.GetSectionContents (section);
-				if (data == null)
+				TargetBlob blob = bfd.GetSectionBlob (section);
+				if (blob == null)
 					throw new SymbolTableException ("Can't get bfd section {0}", name);
-				return new TargetReader (data, bfd.info);
+				return new TargetReader (blob);
 			}
 
 			public TargetReader GetReader (TargetAddress address)
@@ -133,13 +135,21 @@ namespace Mono.Debugger.Backend
 		extern static IntPtr bfd_glue_openr_next_archived_file (IntPtr archive, IntPtr last);
 
 		[DllImport("monodebuggerserver")]
-		extern static int bfd_glue_get_symbols (IntPtr bfd, out IntPtr symtab);
+		extern static IntPtr bfd_glue_export_symbols (IntPtr bfd, bool strip_leading_underscore,
+							      out int num_symbols, out int size);
 
 		[DllImport("monodebuggerserver")]
-		extern static int bfd_glue_get_dynamic_symbols (IntPtr bfd, out IntPtr symtab);
+		extern static bool bfd_glue_get_section_contents (IntPtr bfd, IntPtr section, IntPtr data, int size);
 
 		[DllImport("monodebuggerserver")]
-		extern static bool bfd_glue_get_section_contents (IntPtr bfd, IntPtr section, IntPtr data, int size);
+		extern static IntPtr bfd_glue_map_section (IntPtr bfd, IntPtr section,
+							   out IntPtr map_start, out long map_size);
+
+		[DllImport("monodebuggerserver")]
+		extern static void bfd_glue_unmap_section (IntPtr map_start, long map_size);
+
+		[DllImport("monodebuggerserver")]
+		extern static IntPtr bfd_glue_map_file (string filename, out long size);
 
 		[DllImport("monodebuggerserver")]
 		extern static IntPtr bfd_glue_get_first_section (IntPtr bfd);
@@ -168,10 +178,6 @@ namespace Mono.Debugger.Backend
 		[DllImport("libglib-2.0-0.dll")]
 		extern static void g_free (IntPtr data);
 
-		[DllImport("monodebuggerserver")]
-		extern static string bfd_glue_get_symbol (IntPtr bfd, IntPtr symtab, int index,
-							  out int is_function, out long address);
-
 		static Bfd ()
 		{
 			bfd_init ();
@@ -188,6 +194,12 @@ namespace Mono.Debugger.Backend
 
 			this.symfile = new BfdSymbolFile (this);
 
+			FileInfo file_info = new FileInfo (filename);
+			if (file_info.Exists) {
+				file_size = file_info.Length;
+				file_mtime = file_info.LastWriteTimeUtc;
+			}
+
 			bfd = bfd_glue_openr (filename, null);
 			if (bfd == IntPtr.Zero)
 				throw new SymbolTableException ("Can't read symbol file: {0}", filename);
@@ -306,7 +318,7 @@ namespace Mono.Debugger.Backend
 				module.LoadModule (symfile);
 			}
 
-			os.Process.SymbolTableManager.AddSymbolFile (symfile);
+			os.Process.SymbolTableManager.AddSymbolFile (symfile, this);
 		}
 
 		public Bfd OpenCoreFile (string core_file)
@@ -318,68 +330,78 @@ namespace Mono.Debugger.Backend
 
 		void read_bfd_symbols ()
 		{
-			IntPtr symtab;
-			int num_symbols = bfd_glue_get_symbols (bfd, out symtab);
-
-			symbols = new Hashtable ();
-			local_symbols = new Hashtable ();
-			simple_symbols = new ArrayList ();
-
 			bool is_mach = (bfd_glue_get_target_name (bfd) == "mach-o-le");
 
-			for (int i = 0; i < num_symbols; i++) {
-				string name;
-				long address;
-				int is_function;
-
-				name = bfd_glue_get_symbol (bfd, symtab, i, out is_function, out address);
-				if (name == null)
-					continue;
+			if (!is_coredump) {
+				symbol_index_cache = SymbolIndexCache.GetCache (os.Process.Session.Config);
+				if (symbol_index_cache != null)
+					symbol_index_key = SymbolIndexCache.GetKey (
+						filename, get_build_id_note ());
+			}
 
-				if(is_mach) {
-					if(name[0] == '_')
-						name = name.Substring(1);
+			int num_symbols;
+			if (symbol_index_key != null) {
+				byte[] cached = symbol_index_cache.LoadSymbols (
+					symbol_index_key, out num_symbols);
+				if ((cached != null) && !SymbolArena.IsValid (cached, num_symbols)) {
+					Report.Debug (DebugFlags.SymbolTable,
+						      "Ignoring invalid symbol cache entry for {0}.",
+						      filename);
+					symbol_index_cache.RemoveSymbols (symbol_index_key);
+					cached = null;
 				}
 
-				TargetAddress relocated = new TargetAddress (
-					info.AddressDomain, base_address.Address + address);
-				if (is_function != 0 && !symbols.Contains (name))
-					symbols.Add (name, relocated);
-				else if (name.StartsWith ("MONO_DEBUGGER__") && !symbols.Contains (name))
-					symbols.Add (name, relocated);
-				else if (!local_symbols.Contains (name))
-					local_symbols.Add (name, relocated);
+				if (cached != null) {
+					Report.Debug (DebugFlags.SymbolTable,
+						      "Loaded {0} symbols of {1} from the cache.",
+						      num_symbols, filename);
+
+					IntPtr copy = Marshal.AllocHGlobal (cached.Length);
+					Marshal.Copy (cached, 0, copy, cached.Length);
 
-				simple_symbols.Add (new Symbol (name, relocated, 0));
+					symbol_arena = new SymbolArena (
+						copy, num_symbols, base_address.Address, true);
+					simple_symtab = new BfdSymbolTable (this);
+					return;
+				}
 			}
 
-			g_free (symtab);
+			int size;
+			IntPtr data = bfd_glue_export_symbols (bfd, is_mach, out num_symbols, out size);
 
-			num_symbols = bfd_glue_get_dynamic_symbols (bfd, out symtab);
+			if (symbol_index_key != null) {
+				byte[] contents = new byte [size];
+				Marshal.Copy (data, contents, 0, size);
+				symbol_index_cache.SaveSymbols (symbol_index_key, num_symbols, contents);
+			}
 
-			for (int i = 0; i < num_symbols; i++) {
-				string name;
-				long address;
-				int is_function;
+			symbol_arena = new SymbolArena (data, num_symbols, base_address.Address, false);
+			simple_symtab = new BfdSymbolTable (this);
+		}
 
-				name = bfd_glue_get_symbol (bfd, symtab, i, out is_function, out address);
-				if (name == null)
-					continue;
+		byte[] get_build_id_note ()
+		{
+			IntPtr section = bfd_get_section_by_name (bfd, ".note.gnu.build-id");
+			if (section == IntPtr.Zero)
+				return null;
 
-				TargetAddress relocated = new TargetAddress (
-					info.AddressDomain,
-					base_address.Address + address);
-				simple_symbols.Add (new Symbol (name, relocated, 0));
+			try {
+				return GetSectionContents (section);
+			} catch {
+				return null;
 			}
+		}
 
-			g_free (symtab);
-
-			simple_symtab = new BfdSymbolTable (this);
+		// <summary>
+		//   The on-disk index cache and this file's key in it, or null if
+		//   it's disabled.
+		// </summary>
+		internal SymbolIndexCache SymbolIndexCache {
+			get { return symbol_index_cache; }
 		}
 
-		protected ArrayList GetSimpleSymbols ()
-		{
-			return simple_symbols;
+		internal string SymbolIndexKey {
+			get { return symbol_index_key; }
 		}
 
 		internal TargetAddress ReadDynamicInfo (Inferior inferior)
@@ -540,8 +562,17 @@ namespace Mono.Debugger.Backend
 			if (section != null) {
 				byte[] contents = GetSectionContents (section.section);
 				TargetBlob blob = new TargetBlob (contents, info);
+
+				TargetBlob hdr_blob = null;
+				long hdr_vma = 0;
+				Section hdr = GetSectionByName (".eh_frame_hdr", false);
+				if (hdr != null) {
+					hdr_blob = new TargetBlob (GetSectionContents (hdr.section), info);
+					hdr_vma = vma_base + hdr.vma;
+				}
+
 				eh_frame_reader = new DwarfFrameReader (
-					this, blob, vma_base + section.vma, true);
+					this, blob, vma_base + section.vma, true, hdr_blob, hdr_vma);
 			}
 		}
 
@@ -602,24 +633,26 @@ namespace Mono.Debugger.Backend
 
 		public override TargetAddress LookupSymbol (string name)
 		{
-			if (symbols == null)
+			if (symbol_arena == null)
 				return TargetAddress.Null;
 
-			if (symbols.Contains (name))
-				return (TargetAddress) symbols [name];
+			long address;
+			if (!symbol_arena.LookupByName (name, false, out address))
+				return TargetAddress.Null;
 
-			return TargetAddress.Null;
+			return new TargetAddress (info.AddressDomain, address);
 		}
 
 		public override TargetAddress LookupLocalSymbol (string name)
 		{
-			if (local_symbols == null)
+			if (symbol_arena == null)
 				return TargetAddress.Null;
 
-			if (local_symbols.Contains (name))
-				return (TargetAddress) local_symbols [name];
+			long address;
+			if (!symbol_arena.LookupByName (name, true, out address))
+				return TargetAddress.Null;
 
-			return TargetAddress.Null;
+			return new TargetAddress (info.AddressDomain, address);
 		}
 
 		internal Section FindSection (long address)
@@ -760,7 +793,169 @@ namespace Mono.Debugger.Backend
 			return new TargetReader (contents, info);
 		}
 
+		// <summary>
+		//   Owns a read-only mapping of a section or file; every TargetBlob
+		//   which points into the mapping holds a reference to it.
+		// </summary>
+		internal class MappedRegion : IDisposable
+		{
+			IntPtr map_start;
+			long map_size;
+
+			public MappedRegion (IntPtr map_start, long map_size)
+			{
+				this.map_start = map_start;
+				this.map_size = map_size;
+			}
+
+			public IntPtr Start {
+				get { return map_start; }
+			}
+
+			public long Size {
+				get { return map_size; }
+			}
+
+			~MappedRegion ()
+			{
+				Dispose (false);
+			}
+
+			void Dispose (bool disposing)
+			{
+				lock (this) {
+					if (map_start == IntPtr.Zero)
+						return;
+
+					bfd_glue_unmap_section (map_start, map_size);
+					map_start = IntPtr.Zero;
+				}
+			}
+
+			public void Dispose ()
+			{
+				Dispose (true);
+				GC.SuppressFinalize (this);
+			}
+		}
+
+		// <summary>
+		//   Map all of `filename' read-only; returns null on failure.
+		// </summary>
+		internal static MappedRegion MapFile (string filename)
+		{
+			long size;
+			IntPtr start = bfd_glue_map_file (filename, out size);
+			if (start == IntPtr.Zero)
+				return null;
+			return new MappedRegion (start, size);
+		}
+
+		// <summary>
+		//   Get the contents of a section without copying it if possible;
+		//   the returned blob points into a read-only mapping of the file.
+		//   Sections which need relocation (or which we can't map for some
+		//   other reason) are read via GetSectionContents().
+		// </summary>
+		// <remarks>
+		//   Accessing a mapping of a file which has been truncated since
+		//   raises SIGBUS, so we don't map anything once the file has been
+		//   rebuilt or modified after we opened it.  This can't protect
+		//   mappings which already exist; don't rebuild a file while the
+		//   debugger is using it.
+		// </remarks>
+		internal TargetBlob GetSectionBlob (string name)
+		{
+			IntPtr section = bfd_get_section_by_name (bfd, name);
+			if (section == IntPtr.Zero)
+				throw new SymbolTableException ("Can't find bfd section {0}", name);
+
+			TargetBlob blob = GetSectionBlob (section);
+			if (blob == null)
+				throw new SymbolTableException ("Can't read bfd section {0}", name);
+			return blob;
+		}
+
+		TargetBlob GetSectionBlob (IntPtr section)
+		{
+			return GetSectionBlob (bfd, section, info, !file_changed ());
+		}
+
+		bool file_changed ()
+		{
+			FileInfo file_info = new FileInfo (filename);
+			if (!file_info.Exists ||
+			    (file_info.Length != file_size) || (file_info.LastWriteTimeUtc != file_mtime)) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "{0} changed since we opened it, not mapping it.", filename);
+				return true;
+			}
+
+			return false;
+		}
+
+		// <summary>
+		//   Get the contents of some sections of another object file, such
+		//   as a split-DWARF .dwo or .dwp file.  The result contains null for
+		//   each section which doesn't exist; we return null if `filename'
+		//   isn't an object file.  The file isn't kept open.
+		// </summary>
+		internal static TargetBlob[] GetSectionBlobs (string filename, TargetMemoryInfo info,
+							      string[] names)
+		{
+			IntPtr bfd = bfd_glue_openr (filename, null);
+			if (bfd == IntPtr.Zero)
+				return null;
+
+			try {
+				if (!bfd_glue_check_format_object (bfd))
+					return null;
+
+				TargetBlob[] blobs = new TargetBlob [names.Length];
+				for (int i = 0; i < names.Length; i++) {
+					IntPtr section = bfd_get_section_by_name (bfd, names [i]);
+					if (section != IntPtr.Zero)
+						blobs [i] = GetSectionBlob (bfd, section, info, true);
+				}
+
+				return blobs;
+			} finally {
+				bfd_close (bfd);
+			}
+		}
+
+		static TargetBlob GetSectionBlob (IntPtr bfd, IntPtr section, TargetMemoryInfo info,
+						  bool may_map)
+		{
+			IntPtr map_start;
+			long map_size;
+
+			IntPtr data = IntPtr.Zero;
+			if (may_map)
+				data = bfd_glue_map_section (bfd, section, out map_start, out map_size);
+			else {
+				map_start = IntPtr.Zero;
+				map_size = 0;
+			}
+
+			if (data != IntPtr.Zero) {
+				int size = bfd_glue_get_section_size (section);
+				MappedRegion mapping = new MappedRegion (map_start, map_size);
+				return new TargetBlob (data, size, info, mapping);
+			}
+
+			byte[] contents = GetSectionContents (bfd, section);
+			if (contents == null)
+				return null;
+			return new TargetBlob (contents, info);
+		}
+
 		byte[] GetSectionContents (IntPtr section)
+		{
+			return GetSectionContents (bfd, section);
+		}
+
+		static byte[] GetSectionContents (IntPtr bfd, IntPtr section)
 		{
 			int size = bfd_glue_get_section_size (section);
 			IntPtr data = IntPtr.Zero;
@@ -943,6 +1138,12 @@ namespace Mono.Debugger.Backend
 				dwarf.ReadTypes ();
 		}
 
+		public void ReadTypes (string name)
+		{
+			if (dwarf != null)
+				dwarf.ReadTypes (name);
+		}
+
 		protected class BfdSymbolFile : SymbolFile
 		{
 			public readonly Bfd Bfd;
@@ -1018,57 +1219,310 @@ namespace Mono.Debugger.Backend
 		// The BFD symbol table.
 		//
 
+		//
+		// The symbols returned by bfd_glue_export_symbols() (or a copy from the
+		// SymbolIndexCache): an array of BfdGlueSymbol records followed by a
+		// pool of NUL-terminated names.
+		// We keep it in unmanaged memory and only decode a name when it is
+		// actually needed; name lookups go through a sorted index of the
+		// name hashes which the server computed for us.
+		//
+		private class SymbolArena : IDisposable
+		{
+			/* Keep in sync with BfdGlueSymbol in bfdglue.h. */
+			const int RecordSize = 24;
+			const int AddressOffset = 0;
+			const int NameOffsetOffset = 8;
+			const int NameHashOffset = 12;
+			const int FlagsOffset = 16;
+
+			const int FlagsFunction = 1;
+			const int FlagsDynamic = 2;
+
+			IntPtr data;
+			bool is_hglobal;
+			long pool;
+			int count;
+			long base_address;
+
+			//
+			// `(name_hash << 32) | index' for all the non-dynamic symbols,
+			// sorted; so symbols with the same hash are adjacent and in
+			// symbol table order.
+			//
+			long[] name_index;
+
+			public SymbolArena (IntPtr data, int count, long base_address, bool is_hglobal)
+			{
+				this.data = data;
+				this.is_hglobal = is_hglobal;
+				this.count = count;
+				this.base_address = base_address;
+				this.pool = data.ToInt64 () + (long) count * RecordSize;
+
+				int num_static = 0;
+				long[] index = new long [count];
+				for (int i = 0; i < count; i++) {
+					if ((get_flags (i) & FlagsDynamic) != 0)
+						continue;
+
+					uint hash = (uint) Marshal.ReadInt32 (
+						data, i * RecordSize + NameHashOffset);
+					index [num_static++] = ((long) hash << 32) | (long) i;
+				}
+
+				name_index = new long [num_static];
+				Array.Copy (index, name_index, num_static);
+				Array.Sort (name_index);
+			}
+
+			// <summary>
+			//   Check that `data' is a well-formed arena of `count' symbols
+			//   before we hand it to unmanaged code; used for entries from
+			//   the SymbolIndexCache, which may be truncated, corrupted or
+			//   written with a different record layout.
+			// </summary>
+			public static bool IsValid (byte[] data, int count)
+			{
+				if ((count < 0) || ((long) count * RecordSize > data.Length))
+					return false;
+
+				int pool_start = count * RecordSize;
+				int pool_len = data.Length - pool_start;
+				if ((pool_len > 0) && (data [data.Length - 1] != 0))
+					return false;
+
+				for (int i = 0; i < count; i++) {
+					int offset = BitConverter.ToInt32 (
+						data, i * RecordSize + NameOffsetOffset);
+					if ((offset < 0) || (offset >= pool_len))
+						return false;
+				}
+
+				return true;
+			}
+
+			public int Count {
+				get { return count; }
+			}
+
+			public long GetAddress (int index)
+			{
+				return base_address + Marshal.ReadInt64 (
+					data, index * RecordSize + AddressOffset);
+			}
+
+			IntPtr get_name_ptr (int index)
+			{
+				int offset = Marshal.ReadInt32 (data, index * RecordSize + NameOffsetOffset);
+				return new IntPtr (pool + offset);
+			}
+
+			int get_flags (int index)
+			{
+				return Marshal.ReadInt32 (data, index * RecordSize + FlagsOffset);
+			}
+
+			public string GetName (int index)
+			{
+				return Marshal.PtrToStringAnsi (get_name_ptr (index));
+			}
+
+			bool name_equals (int index, byte[] name)
+			{
+				IntPtr ptr = get_name_ptr (index);
+				for (int i = 0; i < name.Length; i++) {
+					if (Marshal.ReadByte (ptr, i) != name [i])
+						return false;
+				}
+
+				return Marshal.ReadByte (ptr, name.Length) == 0;
+			}
+
+			static uint hash_name (byte[] name)
+			{
+				/* 32-bit FNV-1a, like hash_symbol_name() in bfdglue.c. */
+				uint hash = 2166136261;
+				for (int i = 0; i < name.Length; i++) {
+					hash ^= name [i];
+					hash *= 16777619;
+				}
+				return hash;
+			}
+
+			// <summary>
+			//   Look up a non-dynamic symbol by name.  If there are several
+			//   symbols with the same name, the first function (or
+			//   MONO_DEBUGGER__ variable) is the global one and all the
+			//   others are local, of which we return the first one.
+			// </summary>
+			public bool LookupByName (string name, bool local, out long address)
+			{
+				byte[] bytes = Encoding.UTF8.GetBytes (name);
+				uint hash = hash_name (bytes);
+
+				long key = (long) hash << 32;
+				int pos = Array.BinarySearch (name_index, key);
+				if (pos < 0)
+					pos = ~pos;
+
+				bool seen_global = false;
+				for (; pos < name_index.Length; pos++) {
+					if ((uint) (name_index [pos] >> 32) != hash)
+						break;
+
+					int index = (int) (name_index [pos] & 0xffffffff);
+					if (!name_equals (index, bytes))
+						continue;
+
+					bool is_global = !seen_global &&
+						(((get_flags (index) & FlagsFunction) != 0) ||
+						 name.StartsWith ("MONO_DEBUGGER__"));
+					if (is_global)
+						seen_global = true;
+
+					if (is_global != local) {
+						address = GetAddress (index);
+						return true;
+					}
+				}
+
+				address = 0;
+				return false;
+			}
+
+			public void Dispose ()
+			{
+				if (data == IntPtr.Zero)
+					return;
+
+				if (is_hglobal)
+					Marshal.FreeHGlobal (data);
+				else
+					g_free (data);
+				data = IntPtr.Zero;
+			}
+		}
+
 		private class BfdSymbolTable
 		{
 			Bfd bfd;
-			Symbol[] list;
+
+			//
+			// Sorted by address, with aliases collapsed: `symbols [i]' is the
+			// index of the first symbol at `addresses [i]' in the arena.
+			//
+			long[] addresses;
+			int[] symbols;
+
+			//
+			// Small direct-mapped cache of recent lookups; we usually hit the
+			// same few addresses over and over while stepping.
+			//
+			const int CacheSize = 64;
+			long[] cache_address = new long [CacheSize];
+			Symbol[] cache_symbol = new Symbol [CacheSize];
+			bool[] cache_valid = new bool [CacheSize];
 
 			public BfdSymbolTable (Bfd bfd)
 			{
 				this.bfd = bfd;
 			}
 
+			void create_index ()
+			{
+				SymbolArena arena = bfd.symbol_arena;
+				int count = arena.Count;
+
+				long[] all_addresses = new long [count];
+				int[] all_symbols = new int [count];
+				for (int i = 0; i < count; i++) {
+					all_addresses [i] = arena.GetAddress (i);
+					all_symbols [i] = i;
+				}
+
+				Array.Sort (all_addresses, all_symbols);
+
+				//
+				// Array.Sort() is not stable, so of several symbols at the same
+				// address, explicitly keep the one which comes first in the
+				// symbol table.
+				//
+				int num_unique = 0;
+				for (int i = 0; i < count; i++) {
+					if ((num_unique > 0) &&
+					    (all_addresses [i] == all_addresses [num_unique - 1])) {
+						if (all_symbols [i] < all_symbols [num_unique - 1])
+							all_symbols [num_unique - 1] = all_symbols [i];
+						continue;
+					}
+
+					all_addresses [num_unique] = all_addresses [i];
+					all_symbols [num_unique] = all_symbols [i];
+					num_unique++;
+				}
+
+				addresses = new long [num_unique];
+				symbols = new int [num_unique];
+				Array.Copy (all_addresses, addresses, num_unique);
+				Array.Copy (all_symbols, symbols, num_unique);
+			}
+
+			int find_symbol (long address)
+			{
+				int lo = 0, hi = addresses.Length - 1;
+				int found = -1;
+
+				while (lo <= hi) {
+					int mid = (lo + hi) / 2;
+					if (addresses [mid] <= address) {
+						found = mid;
+						lo = mid + 1;
+					} else
+						hi = mid - 1;
+				}
+
+				return found;
+			}
+
+			Symbol do_lookup (TargetAddress address)
+			{
+				int idx = find_symbol (address.Address);
+				if (idx < 0)
+					return null;
+
+				long offset = address.Address - addresses [idx];
+				string name = bfd.symbol_arena.GetName (symbols [idx]);
+				return new Symbol (name, address - offset, (int) offset);
+			}
+
 			public Symbol SimpleLookup (TargetAddress address, bool exact_match)
 			{
 				if (bfd.IsContinuous &&
 				    ((address < bfd.StartAddress) || (address >= bfd.EndAddress)))
 					return null;
 
-				if (list == null) {
-					ArrayList the_list = bfd.GetSimpleSymbols ();
-					the_list.Sort ();
-
-					list = new Symbol [the_list.Count];
-					the_list.CopyTo (list);
-				}
-
-				for (int i = list.Length - 1; i >= 0; i--) {
-					Symbol entry = list [i];
+				Symbol symbol;
 
-					if (address < entry.Address)
-						continue;
+				lock (this) {
+					if (addresses == null)
+						create_index ();
 
-					long offset = address - entry.Address;
-					if (offset == 0) {
-						while (i > 0) {
-							Symbol n_entry = list [--i];
-
-							if (n_entry.Address == entry.Address) 
-								entry = n_entry;
-							else
-								break;
-						}
-
-						return new Symbol (entry.Name, address, 0);
-					} else if (exact_match)
-						return null;
-					else
-						return new Symbol (
-							entry.Name, address - offset,
-							(int) offset);
+					int slot = (int) ((ulong) address.Address % CacheSize);
+					if (cache_valid [slot] && (cache_address [slot] == address.Address))
+						symbol = cache_symbol [slot];
+					else {
+						symbol = do_lookup (address);
+						cache_address [slot] = address.Address;
+						cache_symbol [slot] = symbol;
+						cache_valid [slot] = true;
+					}
 				}
 
-				return null;
+				if ((symbol != null) && exact_match && (symbol.Offset != 0))
+					return null;
+
+				return symbol;
 			}
 		}
 
@@ -1076,6 +1530,10 @@ namespace Mono.Debugger.Backend
 		{
 			bfd_close (bfd);
 			bfd = IntPtr.Zero;
+			if (symbol_arena != null) {
+				symbol_arena.Dispose ();
+				symbol_arena = null;
+			}
 			base.DoDispose ();
 		}
 	}
@@ -27,6 +27,15 @@ namespace Mono.Debugger.Backend
 			}
 		}
 
+		internal override void ReadNativeTypes (string name)
+		{
+			foreach (Bfd bfd in bfd_hash.Values) {
+				if (bfd == null)
+					continue;
+				bfd.ReadTypes (name);
+			}
+		}
+
 		public override NativeExecutableReader LookupLibrary (TargetAddress address)
 		{
 			foreach (Bfd bfd in bfd_hash.Values) {
@@ -9,27 +9,42 @@ namespace Mono.Debugger.Backend
 		protected readonly TargetBlob blob;
 		protected readonly bool is_ehframe;
 		protected readonly long vma;
-		protected CIE cie_list;
+		protected readonly TargetBlob hdr_blob;
+		protected readonly long hdr_vma;
+		protected Hashtable cie_hash = new Hashtable ();
+
+		//
+		// Sorted FDE index: `index_start [i]' is the initial location of the
+		// FDE at offset `index_offset [i]' in the frame blob.
+		//
+		long[] index_start;
+		long[] index_offset;
 
 		public DwarfFrameReader (Bfd bfd, TargetBlob blob, long vma,
 					 bool is_ehframe)
+			: this (bfd, blob, vma, is_ehframe, null, 0)
+		{ }
+
+		public DwarfFrameReader (Bfd bfd, TargetBlob blob, long vma,
+					 bool is_ehframe, TargetBlob hdr_blob, long hdr_vma)
 		{
 			this.bfd = bfd;
 			this.blob = blob;
 			this.vma = vma;
 			this.is_ehframe = is_ehframe;
+			this.hdr_blob = hdr_blob;
+			this.hdr_vma = hdr_vma;
 		}
 
 		protected CIE find_cie (long offset)
 		{
-			for (CIE cie = cie_list; cie != null; cie = cie.Next) {
-				if (cie.Offset == offset)
-					return cie;
-			}
+			CIE cie = (CIE) cie_hash [offset];
+			if (cie != null)
+				return cie;
 
-			CIE new_cie = new CIE (this, offset, cie_list);
-			cie_list = new_cie;
-			return cie_list;
+			cie = new CIE (this, offset);
+			cie_hash.Add (offset, cie);
+			return cie;
 		}
 
 		public StackFrame UnwindStack (StackFrame frame, TargetMemoryAccess target,
@@ -40,47 +55,34 @@ namespace Mono.Debugger.Backend
 
 			TargetAddress address = frame.TargetAddress;
 
-			DwarfBinaryReader reader = new DwarfBinaryReader (bfd, blob, false);
+			if (index_start == null)
+				create_index ();
 
-			while (reader.Position < reader.Size) {
-				long length = reader.ReadInitialLength ();
-				if (length == 0)
-					break;
-				long end_pos = reader.Position + length;
+			int idx = find_index (address.Address);
+			if (idx < 0)
+				return null;
 
-				long cie_pointer = reader.ReadOffset ();
-				bool is_cie;
-				if (is_ehframe)
-					is_cie = cie_pointer == 0;
-				else
-					is_cie = cie_pointer == -1;
+			DwarfBinaryReader reader = new DwarfBinaryReader (bfd, blob, false);
 
-				if (is_cie) {
-					reader.Position = end_pos;
+			//
+			// Several FDEs may share the same initial location (for instance
+			// empty ones left over from discarded sections), so check all of
+			// them before giving up.
+			//
+			for (int i = idx; (i >= 0) && (index_start [i] == index_start [idx]); i--) {
+				long end_pos;
+				CIE cie;
+
+				reader.Position = index_offset [i];
+				if (!read_fde_header (reader, out cie, out end_pos))
 					continue;
-				}
-
-				if (is_ehframe)
-					cie_pointer = reader.Position - cie_pointer -
-						target.TargetMemoryInfo.TargetAddressSize;
-
-				CIE cie = find_cie (cie_pointer);
 
 				long initial, range;
-				if (is_ehframe) {
-					initial = ReadEncodedValue (reader, cie.Encoding);
-					range = ReadEncodedValue (reader, cie.Encoding & 0x0f);
-				} else {
-					initial = reader.ReadAddress ();
-					range = reader.ReadAddress ();
-				}
+				read_fde_range (reader, cie, out initial, out range);
 
 				TargetAddress start = new TargetAddress (target.AddressDomain, initial);
-
-				if ((address < start) || (address > start + range)) {
-					reader.Position = end_pos;
+				if ((address < start) || (address > start + range))
 					continue;
-				}
 
 				Entry fde = new Entry (cie, start, address);
 				fde.Read (reader, end_pos);
@@ -90,7 +92,143 @@ namespace Mono.Debugger.Backend
 			return null;
 		}
 
+		int find_index (long address)
+		{
+			int lo = 0, hi = index_start.Length - 1;
+			int found = -1;
+
+			while (lo <= hi) {
+				int mid = (lo + hi) / 2;
+				if (index_start [mid] <= address) {
+					found = mid;
+					lo = mid + 1;
+				} else
+					hi = mid - 1;
+			}
+
+			return found;
+		}
+
+		bool read_fde_header (DwarfBinaryReader reader, out CIE cie, out long end_pos)
+		{
+			cie = null;
+
+			long length = reader.ReadInitialLength ();
+			end_pos = reader.Position + length;
+			if (length == 0)
+				return false;
+
+			long pointer_pos = reader.Position;
+			long cie_pointer = reader.ReadOffset ();
+			bool is_cie;
+			if (is_ehframe)
+				is_cie = cie_pointer == 0;
+			else
+				is_cie = cie_pointer == -1;
+
+			if (is_cie)
+				return false;
+
+			if (is_ehframe)
+				cie_pointer = pointer_pos - cie_pointer;
+
+			cie = find_cie (cie_pointer);
+			return true;
+		}
+
+		void read_fde_range (DwarfBinaryReader reader, CIE cie,
+				     out long initial, out long range)
+		{
+			if (is_ehframe) {
+				initial = ReadEncodedValue (reader, cie.Encoding);
+				range = ReadEncodedValue (reader, cie.Encoding & 0x0f);
+			} else {
+				initial = reader.ReadAddress ();
+				range = reader.ReadAddress ();
+			}
+		}
+
+		void create_index ()
+		{
+			if ((hdr_blob != null) && read_eh_frame_hdr ())
+				return;
+
+			ArrayList entries = new ArrayList ();
+
+			DwarfBinaryReader reader = new DwarfBinaryReader (bfd, blob, false);
+			while (reader.Position < reader.Size) {
+				long offset = reader.Position;
+				long length = reader.PeekInt32 (offset);
+				if (length == 0)
+					break;
+
+				long end_pos;
+				CIE cie;
+				if (read_fde_header (reader, out cie, out end_pos)) {
+					long initial, range;
+					read_fde_range (reader, cie, out initial, out range);
+					entries.Add (new IndexEntry (initial, offset));
+				}
+
+				reader.Position = end_pos;
+			}
+
+			entries.Sort ();
+
+			index_start = new long [entries.Count];
+			index_offset = new long [entries.Count];
+			for (int i = 0; i < entries.Count; i++) {
+				IndexEntry entry = (IndexEntry) entries [i];
+				index_start [i] = entry.Start;
+				index_offset [i] = entry.Offset;
+			}
+		}
+
+		//
+		// `.eh_frame_hdr' contains a binary search table of (initial location,
+		// FDE address) pairs which is already sorted by the linker.
+		//
+		bool read_eh_frame_hdr ()
+		{
+			DwarfBinaryReader reader = new DwarfBinaryReader (bfd, hdr_blob, false);
+			if (reader.Size < 4)
+				return false;
+
+			int version = reader.ReadByte ();
+			byte eh_frame_ptr_enc = reader.ReadByte ();
+			byte fde_count_enc = reader.ReadByte ();
+			byte table_enc = reader.ReadByte ();
+
+			if ((version != 1) || (fde_count_enc == (byte) DW_EH_PE.omit) ||
+			    (table_enc == (byte) DW_EH_PE.omit))
+				return false;
+
+			try {
+				ReadEncodedValue (reader, eh_frame_ptr_enc, hdr_vma, hdr_vma);
+				long count = ReadEncodedValue (reader, fde_count_enc, hdr_vma, hdr_vma);
+
+				long[] starts = new long [count];
+				long[] offsets = new long [count];
+				for (long i = 0; i < count; i++) {
+					starts [i] = ReadEncodedValue (reader, table_enc, hdr_vma, hdr_vma);
+					offsets [i] = ReadEncodedValue (reader, table_enc, hdr_vma, hdr_vma) - vma;
+				}
+
+				index_start = starts;
+				index_offset = offsets;
+				return true;
+			} catch (DwarfException) {
+				return false;
+			}
+		}
+
 		private long ReadEncodedValue (DwarfBinaryReader reader, int encoding)
+		{
+			return ReadEncodedValue (reader, encoding, vma, 0);
+		}
+
+		private long ReadEncodedValue (DwarfBinaryReader reader, int encoding,
+					       long section_vma, long data_base)
 		{
 			long base_addr;
 			switch (encoding & 0x70) {
@@ -98,7 +236,10 @@ namespace Mono.Debugger.Backend
 				base_addr = 0;
 				break;
 			case (byte) DW_EH_PE.pcrel:
-				base_addr = vma + reader.Position;
+				base_addr = section_vma + reader.Position;
+				break;
+			case (byte) DW_EH_PE.datarel:
+				base_addr = data_base;
 				break;
 			default:
 				throw new DwarfException (
@@ -108,12 +249,19 @@ namespace Mono.Debugger.Backend
 
 			long value;
 			switch (encoding & 0x0f) {
+			case (byte) DW_EH_PE.absptr:
+				value = reader.ReadAddress ();
+				break;
 			case (byte) DW_EH_PE.udata4:
 				value = reader.ReadUInt32 ();
 				break;
 			case (byte) DW_EH_PE.sdata4:
 				value = reader.ReadInt32 ();
 				break;
+			case (byte) DW_EH_PE.udata8:
+			case (byte) DW_EH_PE.sdata8:
+				value = reader.ReadInt64 ();
+				break;
 			default:
 				throw new DwarfException (
 					reader.Bfd, "Unknown encoding `{0:x}' in CIE",
@@ -181,6 +329,24 @@ namespace Mono.Debugger.Backend
 			indirect= 0x80
 		}
 
+		protected struct IndexEntry : IComparable
+		{
+			public readonly long Start;
+			public readonly long Offset;
+
+			public IndexEntry (long start, long offset)
+			{
+				this.Start = start;
+				this.Offset = offset;
+			}
+
+			public int CompareTo (object obj)
+			{
+				IndexEntry entry = (IndexEntry) obj;
+				return Start.CompareTo (entry.Start);
+			}
+		}
+
 		protected enum State
 		{
 			Undefined,
@@ -380,7 +546,6 @@ namespace Mono.Debugger.Backend
 		{
 			DwarfFrameReader frame;
 			long offset;
-			CIE next;
 
 			int code_alignment;
 			int data_alignment;
@@ -389,21 +554,17 @@ namespace Mono.Debugger.Backend
 			byte encoding = (byte) DW_EH_PE.udata4;
 			Column[] columns;
 
-			public CIE (DwarfFrameReader frame, long offset, CIE next)
+			public CIE (DwarfFrameReader frame, long offset)
 			{
 				this.frame = frame;
 				this.offset = offset;
-				this.next = next;
 
 				DwarfBinaryReader reader = new DwarfBinaryReader (
 					frame.bfd, frame.blob, false);
+				reader.Position = offset;
 				read_cie (reader);
 			}
 
-			public CIE Next {
-				get { return next; }
-			}
-
 			public Architecture Architecture {
 				get { return frame.bfd.Architecture; }
 			}
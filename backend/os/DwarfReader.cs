@@ -5,6 +5,7 @@ using System.Collections;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Runtime.InteropServices;
+using ST = System.Threading;
 
 using Mono.Debugger.Languages;
 using Mono.Debugger.Languages.Native;
@@ -109,16 +110,51 @@ namespace Mono.Debugger.Backend
 		ObjectCache debug_pubtypes_reader;
 		ObjectCache debug_str_reader;
 		ObjectCache debug_ranges_reader;
+		ObjectCache debug_names_reader;
+		ObjectCache gdb_index_reader;
+		ObjectCache debug_str_offsets_reader;
+		ObjectCache debug_addr_reader;
+		ObjectCache debug_line_str_reader;
+		ObjectCache debug_loclists_reader;
+		ObjectCache debug_rnglists_reader;
 
 		Hashtable source_file_hash;
 		Hashtable method_source_hash;
 		Hashtable method_hash;
-		Hashtable compile_unit_hash;
+
+		//
+		// Sorted by offset; these never change once we're constructed, so
+		// we don't need any locking to access them.
+		//
+		long[] compile_unit_offsets;
+		CompileUnitBlock[] compile_units;
+		Hashtable type_units;
 		DwarfSymbolTable symtab;
 		ArrayList aranges;
-		Hashtable pubnames;
+		NameIndex pubnames;
 		// Hashtable pubtypes;
+
+		//
+		// The name index from .debug_names or .gdb_index if we have one,
+		// otherwise the one we built ourselves; see get_name_index().
+		//
+		NameIndex name_index;
+		DwarfNameTable name_table;
+		bool name_index_initialized;
 		TargetMemoryInfo target_info;
+		DwarfIndex index;
+
+		//
+		// The .dwo and .dwp files we already opened, by file name; the
+		// value is null if we couldn't read the file.
+		//
+		Hashtable split_files;
+
+		//
+		// The abbreviation tables we already read, by offset; most compile
+		// units share them.
+		//
+		Hashtable abbrev_tables;
 
 		public DwarfReader (Bfd bfd, Module module)
 		{
@@ -129,20 +165,9 @@ namespace Mono.Debugger.Backend
 
 			debug_info_reader = create_reader (".debug_info", false);
 
-			DwarfBinaryReader reader = DebugInfoReader;
-
-			reader.ReadInitialLength (out is64bit);
-			int version = reader.ReadInt16 ();
-			if (version < 2)
-				throw new DwarfException (
-					bfd, "Wrong DWARF version: {0}", version);
-
-			reader.ReadOffset ();
-			address_size = reader.ReadByte ();
-
-			if ((address_size != 4) && (address_size != 8))
-				throw new DwarfException (
-					bfd, "Unknown address size: {0}", address_size);
+			UnitHeader header = new UnitHeader (bfd, DebugInfoReader);
+			is64bit = header.Is64Bit;
+			address_size = (byte) header.AddressSize;
 
 			debug_abbrev_reader = create_reader (".debug_abbrev", false);
 			debug_line_reader = create_reader (".debug_line", false);
@@ -150,13 +175,34 @@ namespace Mono.Debugger.Backend
 			debug_pubnames_reader = create_reader (".debug_pubnames", true);
 			debug_pubtypes_reader = create_reader (".debug_pubtypes", true);
 			debug_str_reader = create_reader (".debug_str", true);
-			debug_loc_reader = create_reader (".debug_loc", false);
+			debug_loc_reader = create_reader (".debug_loc", true);
 			debug_ranges_reader = create_reader (".debug_ranges", true);
-
-			compile_unit_hash = Hashtable.Synchronized (new Hashtable ());
-			method_source_hash = Hashtable.Synchronized (new Hashtable ());
-			method_hash = Hashtable.Synchronized (new Hashtable ());
-			source_file_hash = Hashtable.Synchronized (new Hashtable ());
+			debug_names_reader = create_reader (".debug_names", true);
+			gdb_index_reader = create_reader (".gdb_index", true);
+			debug_str_offsets_reader = create_reader (".debug_str_offsets", true);
+			debug_addr_reader = create_reader (".debug_addr", true);
+			debug_line_str_reader = create_reader (".debug_line_str", true);
+			debug_loclists_reader = create_reader (".debug_loclists", true);
+			debug_rnglists_reader = create_reader (".debug_rnglists", true);
+
+			method_source_hash = new Hashtable ();
+			method_hash = new Hashtable ();
+			source_file_hash = new Hashtable ();
+			split_files = new Hashtable ();
+			abbrev_tables = new Hashtable ();
+
+			SymbolIndexCache cache = bfd.SymbolIndexCache;
+			string cache_key = bfd.SymbolIndexKey;
+			if (cache_key != null) {
+				index = cache.LoadDwarfIndex (cache_key);
+				if (index == null) {
+					index = create_index ();
+					cache.SaveDwarfIndex (cache_key, index);
+				} else {
+					Report.Debug (DebugFlags.DwarfReader,
+						      "{0}: loaded index from the cache", filename);
+				}
+			}
 
 			if (bfd.IsLoaded) {
 				aranges = ArrayList.Synchronized (read_aranges ());
@@ -165,12 +211,14 @@ namespace Mono.Debugger.Backend
 				// pubtypes = read_pubtypes ();
 			}
 
-			long offset = 0;
-			while (offset < reader.Size) {
-				CompileUnitBlock block = new CompileUnitBlock (this, offset);
-				compile_unit_hash.Add (offset, block);
-				offset += block.length;
-			}
+			compile_unit_offsets = (index != null) ?
+				index.CompileUnits : read_compile_unit_offsets ();
+			compile_units = read_compile_units (compile_unit_offsets);
+			type_units = read_type_units ();
+
+			// We only need the cached aranges and pubnames until we're loaded.
+			if (aranges != null)
+				index = null;
 		}
 
 		public void ModuleLoaded ()
@@ -183,6 +231,239 @@ namespace Mono.Debugger.Backend
 
 			pubnames = read_pubnames ();
 			// pubtypes = read_pubtypes ();
+
+			index = null;
+		}
+
+		DwarfIndex create_index ()
+		{
+			DwarfIndex index = new DwarfIndex ();
+			index.CompileUnits = read_compile_unit_offsets ();
+			index.ARanges = read_raw_aranges ();
+			read_raw_pubnames (out index.PubNames, out index.PubNameOffsets);
+			return index;
+		}
+
+		// <summary>
+		//   Create the CompileUnitBlocks; this parses the abbreviation
+		//   tables and the DW_TAG_compile_unit DIE's, but none of their
+		//   children.  The compile units are independent of each other,
+		//   so we do this on all processors.
+		// </summary>
+		CompileUnitBlock[] read_compile_units (long[] offsets)
+		{
+			CompileUnitBlock[] blocks = new CompileUnitBlock [offsets.Length];
+
+			//
+			// Fetch the section contents on this thread, so the workers
+			// won't race to create them.
+			//
+			ObjectCache[] sections = {
+				debug_info_reader, debug_abbrev_reader, debug_str_reader,
+				debug_str_offsets_reader, debug_addr_reader, debug_line_str_reader
+			};
+
+			ArrayList blobs = new ArrayList ();
+			foreach (ObjectCache section in sections) {
+				if (section != null)
+					blobs.Add (section.Data);
+			}
+
+			run_parallel (offsets.Length, delegate (int i) {
+				blocks [i] = new CompileUnitBlock (this, offsets [i]);
+			});
+
+			GC.KeepAlive (blobs);
+
+			return blocks;
+		}
+
+		// <summary>
+		//   DWARF 5 type units live in .debug_info; map their signatures
+		//   to the units, so we can resolve DW_FORM_ref_sig8.
+		// </summary>
+		Hashtable read_type_units ()
+		{
+			Hashtable hash = new Hashtable ();
+			foreach (CompileUnitBlock block in compile_units) {
+				foreach (CompilationUnit comp_unit in block.CompilationUnits) {
+					if (comp_unit.IsTypeUnit)
+						hash [comp_unit.TypeSignature] = comp_unit;
+				}
+			}
+			return hash;
+		}
+
+		CompilationUnit get_type_unit (long signature)
+		{
+			return (CompilationUnit) type_units [signature];
+		}
+
+		// <summary>
+		//   Get the unit which contains `offset' in .debug_info and make
+		//   sure we read all of its DIE's.
+		// </summary>
+		CompilationUnit get_compilation_unit (long offset)
+		{
+			int pos = Array.BinarySearch (compile_unit_offsets, offset);
+			if (pos < 0)
+				pos = ~pos - 1;
+			if (pos < 0)
+				return null;
+
+			return compile_units [pos].GetCompilationUnit (offset);
+		}
+
+		// <summary>
+		//   Find and read the split unit of `skeleton'.  We first look for a
+		//   .dwp package next to our executable, then for the unit's .dwo
+		//   file in its compilation directory and next to the executable.
+		// </summary>
+		CompilationUnit load_split_unit (CompilationUnit skeleton)
+		{
+			try {
+				DwarfSplitFile package = get_split_file (filename + ".dwp");
+				if (package != null) {
+					CompilationUnit unit = package.GetCompileUnit (skeleton);
+					if (unit != null)
+						return unit;
+				}
+
+				string dwo_name = skeleton.UnitDie.DwoName;
+				if (dwo_name == null)
+					return null;
+
+				ArrayList paths = new ArrayList ();
+				if (Path.IsPathRooted (dwo_name))
+					paths.Add (dwo_name);
+				else {
+					string comp_dir = skeleton.UnitDie.CompilationDirectory;
+					if (comp_dir != null)
+						paths.Add (Path.Combine (comp_dir, dwo_name));
+				}
+
+				string dir = Path.GetDirectoryName (filename);
+				if (dir != null)
+					paths.Add (Path.Combine (dir, Path.GetFileName (dwo_name)));
+
+				foreach (string path in paths) {
+					DwarfSplitFile file = get_split_file (path);
+					if (file == null)
+						continue;
+
+					CompilationUnit unit = file.GetCompileUnit (skeleton);
+					if (unit != null)
+						return unit;
+				}
+
+				Report.Debug (DebugFlags.DwarfReader,
+					      "{0}: can't find split unit {1} of {2}",
+					      filename, dwo_name, skeleton);
+				return null;
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.DwarfReader,
+					      "{0}: can't read split unit of {1}: {2}",
+					      filename, skeleton, ex);
+				return null;
+			}
+		}
+
+		AbbrevTable get_abbrev_table (long offset)
+		{
+			return AbbrevTable.Get (abbrev_tables, DebugAbbrevReader, offset);
+		}
+
+		DwarfSplitFile get_split_file (string path)
+		{
+			lock (split_files) {
+				if (split_files.Contains (path))
+					return (DwarfSplitFile) split_files [path];
+
+				DwarfSplitFile file = DwarfSplitFile.Open (this, path);
+				split_files.Add (path, file);
+				return file;
+			}
+		}
+
+		delegate void ParallelFunc (int index);
+
+		//
+		// Don't start any threads for small files.
+		//
+		const int MinItemsPerWorker = 16;
+
+		// <summary>
+		//   Call `func' for each index in [0, count) on up to one thread per
+		//   processor and wait until they're all done.  If any of them
+		//   throws, the first exception is rethrown on the calling thread.
+		// </summary>
+		static void run_parallel (int count, ParallelFunc func)
+		{
+			int num_workers = Math.Min (Environment.ProcessorCount,
+						    count / MinItemsPerWorker);
+			if (num_workers <= 1) {
+				for (int i = 0; i < count; i++)
+					func (i);
+				return;
+			}
+
+			int next = -1;
+			Exception error = null;
+			object error_lock = new object ();
+
+			ST.ThreadStart worker = delegate {
+				try {
+					int i;
+					while ((i = ST.Interlocked.Increment (ref next)) < count) {
+						if (error != null)
+							return;
+						func (i);
+					}
+				} catch (Exception ex) {
+					lock (error_lock) {
+						if (error == null)
+							error = ex;
+					}
+				}
+			};
+
+			// The calling thread is one of the workers.
+			ST.Thread[] threads = new ST.Thread [num_workers - 1];
+			for (int i = 0; i < threads.Length; i++) {
+				threads [i] = new ST.Thread (worker);
+				threads [i].IsBackground = true;
+				threads [i].Start ();
+			}
+
+			worker ();
+
+			foreach (ST.Thread thread in threads)
+				thread.Join ();
+
+			if (error != null)
+				throw error;
+		}
+
+		CompileUnitBlock find_compile_unit_block (long offset)
+		{
+			int pos = Array.BinarySearch (compile_unit_offsets, offset);
+			return (pos >= 0) ? compile_units [pos] : null;
+		}
+
+		long[] read_compile_unit_offsets ()
+		{
+			DwarfBinaryReader reader = DebugInfoReader;
+			List<long> offsets = new List<long> ();
+
+			long offset = 0;
+			while (offset < reader.Size) {
+				offsets.Add (offset);
+				reader.Position = offset;
+				long length = reader.ReadInitialLength ();
+				offset = reader.Position + length;
+			}
+
+			return offsets.ToArray ();
 		}
 
 		public static bool IsSupported (Bfd bfd)
@@ -211,7 +492,7 @@ namespace Mono.Debugger.Backend
 
 		protected ISymbolTable get_symtab_at_offset (long offset)
 		{
-			CompileUnitBlock block = (CompileUnitBlock) compile_unit_hash [offset];
+			CompileUnitBlock block = find_compile_unit_block (offset);
 
 			// This either return the already-read symbol table or acquire the
 			// thread lock and read it.
@@ -220,15 +501,25 @@ namespace Mono.Debugger.Backend
 
 		public SourceFile[] Sources {
 			get {
-				SourceFile[] retval = new SourceFile [source_file_hash.Count];
-				source_file_hash.Values.CopyTo (retval, 0);
-				return retval;
+				// Skeleton units don't know their source file until we
+				// read their split unit.
+				foreach (CompileUnitBlock block in compile_units)
+					block.ReadSourceFiles ();
+
+				lock (source_file_hash) {
+					SourceFile[] retval = new SourceFile [source_file_hash.Count];
+					source_file_hash.Values.CopyTo (retval, 0);
+					return retval;
+				}
 			}
 		}
 
 		public Method GetMethod (long handle)
 		{
-			DwarfTargetMethod method = (DwarfTargetMethod) method_hash [handle];
+			DwarfTargetMethod method;
+			lock (method_hash) {
+				method = (DwarfTargetMethod) method_hash [handle];
+			}
 			if ((method == null) || !method.CheckLoaded ())
 				return null;
 			return method;
@@ -238,7 +529,7 @@ namespace Mono.Debugger.Backend
 		{
 			ArrayList list = new ArrayList ();
 
-			foreach (CompileUnitBlock block in compile_unit_hash.Values) {
+			foreach (CompileUnitBlock block in compile_units) {
 				foreach (CompilationUnit comp_unit in block.CompilationUnits) {
 					if (comp_unit.DieCompileUnit.SourceFile != file)
 						continue;
@@ -260,44 +551,156 @@ namespace Mono.Debugger.Backend
 
 		public MethodSource FindMethod (string name)
 		{
-			if (pubnames == null)
+			if (symtab == null)
 				return null;
 
-			NameEntry entry = (NameEntry) pubnames [name];
-			if (entry == null)
+			ArrayList entries = new ArrayList ();
+			get_name_index (NameKind.Function).Lookup (name, NameKind.Function, entries);
+
+			foreach (NameEntry entry in entries) {
+				MethodSource source = find_method (name, entry);
+				if (source != null)
+					return source;
+			}
+
+			return null;
+		}
+
+		MethodSource find_method (string name, NameEntry entry)
+		{
+			CompileUnitBlock block = find_compile_unit_block (entry.FileOffset);
+			if (block == null)
 				return null;
 
+			//
+			// .gdb_index only tells us the compile unit, and the DIE offsets
+			// of split units are relative to their .dwo file.
+			//
+			if ((entry.Offset < 0) || block.IsSkeleton)
+				return block.GetMethod (name);
+
 			MethodSource source;
-			source = (MethodSource) method_source_hash [entry.AbsoluteOffset];
+			lock (method_source_hash) {
+				source = (MethodSource) method_source_hash [entry.AbsoluteOffset];
+			}
 			if (source != null)
 				return source;
 
-			CompileUnitBlock block = (CompileUnitBlock) compile_unit_hash [entry.FileOffset];
 			return block.GetMethod (entry.AbsoluteOffset);
 		}
 
+		// <summary>
+		//   Get the name index to look up functions or types in.  We prefer
+		//   .debug_names or .gdb_index; .debug_pubnames only contains
+		//   functions.  If there's nothing we can use, we build our own
+		//   index the first time we're called and store it in the
+		//   SymbolIndexCache.
+		// </summary>
+		NameIndex get_name_index (NameKind kind)
+		{
+			lock (this) {
+				if (!name_index_initialized) {
+					name_index = read_name_index ();
+					name_index_initialized = true;
+				}
+
+				if (name_index != null)
+					return name_index;
+				if ((kind == NameKind.Function) && (pubnames != null))
+					return pubnames;
+
+				if (name_table == null)
+					name_table = load_name_table ();
+				return name_table;
+			}
+		}
+
+		NameIndex read_name_index ()
+		{
+			try {
+				if (debug_names_reader != null)
+					return new DebugNamesIndex (
+						this, (TargetBlob) debug_names_reader.Data);
+				if (gdb_index_reader != null)
+					return new GdbIndex (this, (TargetBlob) gdb_index_reader.Data);
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.DwarfReader,
+					      "{0}: Can't read name index: {1}", filename, ex.Message);
+			}
+
+			return null;
+		}
+
+		DwarfNameTable load_name_table ()
+		{
+			SymbolIndexCache cache = bfd.SymbolIndexCache;
+			string cache_key = bfd.SymbolIndexKey;
+
+			DwarfNameIndex data = null;
+			if (cache_key != null)
+				data = cache.LoadNameIndex (cache_key);
+
+			if (data == null) {
+				data = build_name_table ();
+				if (cache_key != null)
+					cache.SaveNameIndex (cache_key, data);
+			}
+
+			return new DwarfNameTable (data);
+		}
+
+		// <summary>
+		//   Build our own name index in one pass over .debug_info, reading
+		//   the compile units in parallel.
+		// </summary>
+		DwarfNameIndex build_name_table ()
+		{
+			NameTableBuilder[] builders = new NameTableBuilder [compile_units.Length];
+
+			run_parallel (compile_units.Length, delegate (int i) {
+				builders [i] = new NameTableBuilder ();
+				compile_units [i].IndexNames (builders [i]);
+			});
+
+			List<string> names = new List<string> ();
+			List<long> entries = new List<long> ();
+			foreach (NameTableBuilder builder in builders) {
+				names.AddRange (builder.Names);
+				entries.AddRange (builder.Entries);
+			}
+
+			DwarfNameIndex data = new DwarfNameIndex ();
+			data.Names = names.ToArray ();
+			data.Entries = entries.ToArray ();
+			return data;
+		}
+
 		protected DwarfMethodSource GetMethodSource (DieSubprogram subprog,
 							     int start_row, int end_row)
 		{
-			DwarfMethodSource source;
-			source = (DwarfMethodSource) method_source_hash [subprog.Offset];
-			if (source != null)
-				return source;
+			lock (method_source_hash) {
+				DwarfMethodSource source;
+				source = (DwarfMethodSource) method_source_hash [subprog.Handle];
+				if (source != null)
+					return source;
 
-			source = new DwarfMethodSource (subprog, start_row, end_row);
-			method_source_hash.Add (subprog.Offset, source);
-			return source;
+				source = new DwarfMethodSource (subprog, start_row, end_row);
+				method_source_hash.Add (subprog.Handle, source);
+				return source;
+			}
 		}
 
 		protected SourceFile GetSourceFile (string filename)
 		{
-			SourceFile file = (SourceFile) source_file_hash [filename];
-			if (file == null) {
-				file = new DwarfSourceFile (
-					bfd.NativeLanguage.Process.Session, module, filename);
-				source_file_hash.Add (filename, file);
+			lock (source_file_hash) {
+				SourceFile file = (SourceFile) source_file_hash [filename];
+				if (file == null) {
+					file = new DwarfSourceFile (
+						bfd.NativeLanguage.Process.Session, module, filename);
+					source_file_hash.Add (filename, file);
+				}
+				return file;
 			}
-			return file;
 		}
 
 		protected void AddType (DieType type)
@@ -305,14 +708,71 @@ namespace Mono.Debugger.Backend
 			bfd.NativeLanguage.AddType (type);
 		}
 
+		// <summary>
+		//   Only read the compile units which define a type called `name'.
+		// </summary>
+		// <remarks>
+		//   .debug_names and .gdb_index only contain the unqualified names,
+		//   so for `ns::Foo' we look for all the `Foo's.  If we don't find
+		//   anything, we read all the types like we used to.
+		// </remarks>
+		public void ReadTypes (string name)
+		{
+			if (types_initialized)
+				return;
+
+			NameIndex index = get_name_index (NameKind.Type);
+
+			ArrayList entries = new ArrayList ();
+			index.Lookup (name, NameKind.Type, entries);
+
+			if (entries.Count == 0) {
+				string base_name = get_unqualified_name (name);
+				if (base_name != name)
+					index.Lookup (base_name, NameKind.Type, entries);
+			}
+
+			if (entries.Count == 0) {
+				ReadTypes ();
+				return;
+			}
+
+			foreach (NameEntry entry in entries) {
+				CompileUnitBlock block = find_compile_unit_block (entry.FileOffset);
+				if (block != null)
+					block.ReadSymbolTable ();
+			}
+		}
+
+		// <summary>
+		//   Strip the namespace and class qualifiers from `name', but not
+		//   the ones in template arguments.
+		// </summary>
+		static string get_unqualified_name (string name)
+		{
+			int depth = 0;
+			for (int i = name.Length - 1; i > 0; i--) {
+				char c = name [i];
+				if (c == '>')
+					depth++;
+				else if (c == '<')
+					depth--;
+				else if ((depth == 0) && (c == ':') && (name [i - 1] == ':'))
+					return name.Substring (i + 1);
+			}
+
+			return name;
+		}
+
 		bool types_initialized;
 		public void ReadTypes ()
 		{
 			if (types_initialized)
 				return;
 
-			foreach (CompileUnitBlock block in compile_unit_hash.Values)
-				block.ReadSymbolTable ();
+			run_parallel (compile_units.Length, delegate (int i) {
+				compile_units [i].ReadSymbolTable ();
+			});
 
 			types_initialized = true;
 		}
@@ -343,6 +803,7 @@ namespace Mono.Debugger.Backend
 			SymbolTableCollection symtabs;
 			ArrayList compile_units;
 			bool initialized;
+			bool children_read;
 			bool symbols_initialized;
 
 			public Method Lookup (TargetAddress address)
@@ -399,6 +860,52 @@ namespace Mono.Debugger.Backend
 				return subprog.MethodSource;
 			}
 
+			public MethodSource GetMethod (string name)
+			{
+				build_symtabs ();
+				foreach (CompilationUnit comp_unit in compile_units) {
+					foreach (DieSubprogram subprog in comp_unit.DieCompileUnit.Subprograms) {
+						if (subprog.Name == name)
+							return subprog.MethodSource;
+					}
+				}
+
+				return null;
+			}
+
+			public void IndexNames (NameTableBuilder builder)
+			{
+				foreach (CompilationUnit comp_unit in compile_units)
+					comp_unit.IndexNames (builder);
+			}
+
+			public bool IsSkeleton {
+				get {
+					foreach (CompilationUnit comp_unit in compile_units) {
+						if (comp_unit.IsSkeleton)
+							return true;
+					}
+					return false;
+				}
+			}
+
+			public void ReadSourceFiles ()
+			{
+				foreach (CompilationUnit comp_unit in compile_units)
+					comp_unit.DieCompileUnit.ReadSourceFile ();
+			}
+
+			// <summary>
+			//   Get the unit containing `offset' after reading all its DIE's.
+			// </summary>
+			public CompilationUnit GetCompilationUnit (long offset)
+			{
+				CompilationUnit comp_unit = get_comp_unit (offset);
+				if (comp_unit != null)
+					read_children ();
+				return comp_unit;
+			}
+
 			void read_children ()
 			{
 				// If we're already initialized, we don't need to do any locking,
@@ -409,14 +916,29 @@ namespace Mono.Debugger.Backend
 				lock (this) {
 					// We need to check this again after we acquired the thread
 					// lock to avoid a race condition.
-					if (initialized)
-						return;
+					if (!children_read) {
+						foreach (CompilationUnit comp_unit in compile_units)
+							comp_unit.DieCompileUnit.ReadChildren ();
 
-					foreach (CompilationUnit comp_unit in compile_units)
-						comp_unit.DieCompileUnit.ReadChildren ();
+						children_read = true;
+					}
+				}
 
+				//
+				// Only resolve references into other units after releasing
+				// our lock: ReadTypes() reads the blocks in parallel, and the
+				// other unit's block may be read on another thread right now,
+				// with its DIE's referring back to us.
+				//
+				foreach (CompilationUnit comp_unit in compile_units)
+					comp_unit.ResolveDeferredTypes ();
+
+				//
+				// If we're called while resolving a reference, some of our
+				// types may still be unresolved further up the stack.
+				//
+				if (!CompilationUnit.IsResolving)
 					initialized = true;
-				}
 			}
 
 			void build_symtabs ()
@@ -451,24 +973,11 @@ namespace Mono.Debugger.Backend
 
 				DwarfBinaryReader reader = dwarf.DebugInfoReader;
 				reader.Position = offset;
-				long length_field = reader.ReadInitialLength ();
-				long stop = reader.Position + length_field;
+				UnitHeader header = new UnitHeader (dwarf.bfd, reader);
+				long stop = header.EndOffset;
 				length = stop - offset;
-				int version = reader.ReadInt16 ();
-
-				if (version < 2)
-					throw new DwarfException (
-						dwarf.bfd, "Wrong DWARF version: {0}", version);
-
-				reader.ReadOffset ();
-				int address_size = reader.ReadByte ();
 				reader.Position = offset;
 
-				if ((address_size != 4) && (address_size != 8))
-					throw new DwarfException (
-						dwarf.bfd, "Unknown address size: {0}",
-						address_size);
-
 				compile_units = new ArrayList ();
 
 				while (reader.Position < stop) {
@@ -578,10 +1087,26 @@ namespace Mono.Debugger.Backend
 
 		ArrayList read_aranges ()
 		{
-			ArrayList ranges = new ArrayList ();
+			long[] raw = (index != null) ? index.ARanges : read_raw_aranges ();
+
+			ArrayList ranges = new ArrayList (raw.Length / 3);
+			for (int i = 0; i < raw.Length; i += 3) {
+				TargetAddress taddress = GetAddress (raw [i+1]);
+				ranges.Add (new RangeEntry (this, raw [i], taddress, raw [i+2]));
+			}
+
+			return ranges;
+		}
+
+		// <summary>
+		//   Returns (compile unit offset, address, size) triples.
+		// </summary>
+		long[] read_raw_aranges ()
+		{
+			List<long> ranges = new List<long> ();
 
 			if (debug_aranges_reader == null)
-				return ranges;
+				return ranges.ToArray ();
 
 			DwarfBinaryReader reader = new DwarfBinaryReader (
 				bfd, (TargetBlob) debug_aranges_reader.Data, Is64Bit);
@@ -618,12 +1143,13 @@ namespace Mono.Debugger.Backend
 					if ((address == 0) && (size == 0))
 						break;
 
-					TargetAddress taddress = GetAddress (address);
-					ranges.Add (new RangeEntry (this, offset, taddress, size));
+					ranges.Add (offset);
+					ranges.Add (address);
+					ranges.Add (size);
 				}
 			}
 
-			return ranges;
+			return ranges.ToArray ();
 		}
 
 		private class NameEntry
@@ -648,40 +1174,654 @@ namespace Mono.Debugger.Backend
 			}
 		}
 
-		Hashtable read_pubnames ()
-		{
-			if (debug_pubnames_reader == null)
-				return null;
+		protected enum NameKind {
+			Function		= 1,
+			Type			= 2
+		}
 
-			DwarfBinaryReader reader = new DwarfBinaryReader (
-				bfd, (TargetBlob) debug_pubnames_reader.Data, Is64Bit);
+		static bool is_type_tag (DwarfTag tag)
+		{
+			switch (tag) {
+			case DwarfTag.base_type:
+			case DwarfTag.class_type:
+			case DwarfTag.structure_type:
+			case DwarfTag.union_type:
+			case DwarfTag.enumeration_type:
+			case DwarfTag.typedef:
+				return true;
 
-			Hashtable names = Hashtable.Synchronized (new Hashtable ());
+			default:
+				return false;
+			}
+		}
 
-			while (!reader.IsEof) {
-				long length = reader.ReadInitialLength ();
+		static bool is_kind (DwarfTag tag, NameKind kind)
+		{
+			if (kind == NameKind.Function)
+				return tag == DwarfTag.subprogram;
+			else
+				return is_type_tag (tag);
+		}
+
+		// <summary>
+		//   An accelerated name table, which maps a name to the DIE's defining
+		//   it without reading any compile units.
+		// </summary>
+		protected abstract class NameIndex
+		{
+			// <summary>
+			//   Add a NameEntry to `entries' for each DIE of the given kind
+			//   called `name'.  Some indices only know the compile unit; the
+			//   entry's Offset is -1 in this case.
+			// </summary>
+			public abstract void Lookup (string name, NameKind kind, ArrayList entries);
+		}
+
+		protected class PubNamesIndex : NameIndex
+		{
+			Hashtable names;
+
+			public PubNamesIndex (Hashtable names)
+			{
+				this.names = names;
+			}
+
+			public override void Lookup (string name, NameKind kind, ArrayList entries)
+			{
+				if (kind != NameKind.Function)
+					return;
+
+				NameEntry entry = (NameEntry) names [name];
+				if (entry != null)
+					entries.Add (entry);
+			}
+		}
+
+		// <summary>
+		//   The DWARF 5 .debug_names section.  It contains one name index per
+		//   object file unless the linker merged them.
+		// </summary>
+		protected class DebugNamesIndex : NameIndex
+		{
+			const int DW_IDX_compile_unit = 1;
+			const int DW_IDX_type_unit = 2;
+			const int DW_IDX_die_offset = 3;
+
+			class Abbrev
+			{
+				public DwarfTag Tag;
+				public int[] Indices;
+				public DwarfForm[] Forms;
+			}
+
+			class Unit
+			{
+				public bool Is64Bit;
+				public long[] CompileUnits;
+				public int BucketCount, NameCount;
+				public long Buckets, Hashes, StringOffsets, EntryOffsets, EntryPool;
+				public Hashtable Abbrevs;
+			}
+
+			DwarfReader dwarf;
+			TargetBlob blob;
+			ArrayList units;
+
+			public DebugNamesIndex (DwarfReader dwarf, TargetBlob blob)
+			{
+				this.dwarf = dwarf;
+				this.blob = blob;
+
+				if (dwarf.DebugStrReader == null)
+					throw new DwarfException (
+						dwarf.bfd, "Got .debug_names, but '.debug_str' " +
+						"section is missing.");
+
+				units = new ArrayList ();
+
+				DwarfBinaryReader reader = get_reader ();
+				while (!reader.IsEof)
+					units.Add (read_unit (reader));
+			}
+
+			DwarfBinaryReader get_reader ()
+			{
+				return new DwarfBinaryReader (dwarf.bfd, blob, dwarf.Is64Bit);
+			}
+
+			static long read_offset (DwarfBinaryReader reader, bool is64bit)
+			{
+				return is64bit ? reader.ReadInt64 () : reader.ReadUInt32 ();
+			}
+
+			Unit read_unit (DwarfBinaryReader reader)
+			{
+				Unit unit = new Unit ();
+
+				long length = reader.ReadInitialLength (out unit.Is64Bit);
 				long stop = reader.Position + length;
 				int version = reader.ReadInt16 ();
-				long debug_offset = reader.ReadOffset ();
-				reader.ReadOffset ();
+				reader.ReadInt16 ();
 
-				if (version != 2)
+				if (version != 5)
 					throw new DwarfException (
-						bfd, "Wrong version in .debug_pubnames: {0}",
-						version);
+						dwarf.bfd, "Wrong version in .debug_names: {0}", version);
+
+				int cu_count = reader.ReadInt32 ();
+				int local_tu_count = reader.ReadInt32 ();
+				int foreign_tu_count = reader.ReadInt32 ();
+				unit.BucketCount = reader.ReadInt32 ();
+				unit.NameCount = reader.ReadInt32 ();
+				int abbrev_table_size = reader.ReadInt32 ();
+				int augmentation_size = reader.ReadInt32 ();
+				reader.Position += augmentation_size;
+
+				unit.CompileUnits = new long [cu_count];
+				for (int i = 0; i < cu_count; i++)
+					unit.CompileUnits [i] = read_offset (reader, unit.Is64Bit);
+
+				int offset_size = unit.Is64Bit ? 8 : 4;
+				reader.Position += local_tu_count * offset_size + foreign_tu_count * 8;
+
+				unit.Buckets = reader.Position;
+				unit.Hashes = unit.Buckets + 4 * unit.BucketCount;
+				unit.StringOffsets = unit.Hashes;
+				if (unit.BucketCount > 0)
+					unit.StringOffsets += 4 * unit.NameCount;
+				unit.EntryOffsets = unit.StringOffsets + offset_size * unit.NameCount;
+
+				long abbrev_table = unit.EntryOffsets + offset_size * unit.NameCount;
+				unit.EntryPool = abbrev_table + abbrev_table_size;
+
+				unit.Abbrevs = new Hashtable ();
+				reader.Position = abbrev_table;
+				while (true) {
+					int code = reader.ReadLeb128 ();
+					if (code == 0)
+						break;
 
-				while (reader.Position < stop) {
-					long offset = reader.ReadInt32 ();
-					if (offset == 0)
+					Abbrev abbrev = new Abbrev ();
+					abbrev.Tag = (DwarfTag) reader.ReadLeb128 ();
+
+					List<int> indices = new List<int> ();
+					List<DwarfForm> forms = new List<DwarfForm> ();
+					while (true) {
+						int index = reader.ReadLeb128 ();
+						int form = reader.ReadLeb128 ();
+						if ((index == 0) && (form == 0))
+							break;
+
+						indices.Add (index);
+						forms.Add ((DwarfForm) form);
+					}
+
+					abbrev.Indices = indices.ToArray ();
+					abbrev.Forms = forms.ToArray ();
+					unit.Abbrevs [code] = abbrev;
+				}
+
+				reader.Position = stop;
+				return unit;
+			}
+
+			//
+			// The DJB hash from the DWARF 5 spec; both gcc and LLVM fold
+			// ASCII names to lower case before hashing them.
+			//
+			static uint hash_name (byte[] name)
+			{
+				uint hash = 5381;
+				foreach (byte b in name) {
+					byte c = ((b >= 'A') && (b <= 'Z')) ? (byte) (b + 32) : b;
+					hash = hash * 33 + c;
+				}
+				return hash;
+			}
+
+			public override void Lookup (string name, NameKind kind, ArrayList entries)
+			{
+				DwarfBinaryReader reader = get_reader ();
+				uint hash = hash_name (Encoding.UTF8.GetBytes (name));
+
+				foreach (Unit unit in units) {
+					if (unit.BucketCount == 0) {
+						for (int i = 0; i < unit.NameCount; i++) {
+							if (get_name (reader, unit, i) == name)
+								read_entries (reader, unit, i, kind, entries);
+						}
+						continue;
+					}
+
+					uint bucket = hash % (uint) unit.BucketCount;
+					int index = reader.PeekInt32 (unit.Buckets + 4 * bucket);
+					if (index == 0)
+						continue;
+
+					for (int i = index - 1; i < unit.NameCount; i++) {
+						uint h = reader.PeekUInt32 (unit.Hashes + 4 * i);
+						if (h % (uint) unit.BucketCount != bucket)
+							break;
+
+						if ((h == hash) && (get_name (reader, unit, i) == name))
+							read_entries (reader, unit, i, kind, entries);
+					}
+				}
+			}
+
+			long peek_offset (DwarfBinaryReader reader, Unit unit, long table, int i)
+			{
+				if (unit.Is64Bit)
+					return reader.PeekInt64 (table + 8 * i);
+				else
+					return reader.PeekUInt32 (table + 4 * i);
+			}
+
+			string get_name (DwarfBinaryReader reader, Unit unit, int i)
+			{
+				long offset = peek_offset (reader, unit, unit.StringOffsets, i);
+				return dwarf.DebugStrReader.PeekString (offset);
+			}
+
+			void read_entries (DwarfBinaryReader reader, Unit unit, int i,
+					   NameKind kind, ArrayList entries)
+			{
+				reader.Position = unit.EntryPool +
+					peek_offset (reader, unit, unit.EntryOffsets, i);
+
+				while (true) {
+					int code = reader.ReadLeb128 ();
+					if (code == 0)
 						break;
 
-					string name = reader.ReadString ();
-					if (!names.Contains (name))
-						names.Add (name, new NameEntry (debug_offset, offset));
+					Abbrev abbrev = (Abbrev) unit.Abbrevs [code];
+					if (abbrev == null)
+						throw new DwarfException (
+							dwarf.bfd, "Unknown abbreviation {0} in " +
+							".debug_names", code);
+
+					long cu_index = -1;
+					long die_offset = -1;
+					bool is_type_unit = false;
+
+					for (int j = 0; j < abbrev.Indices.Length; j++) {
+						long value = dwarf.read_form_value (
+							reader, abbrev.Forms [j], unit.Is64Bit);
+
+						if (abbrev.Indices [j] == DW_IDX_compile_unit)
+							cu_index = value;
+						else if (abbrev.Indices [j] == DW_IDX_type_unit)
+							is_type_unit = true;
+						else if (abbrev.Indices [j] == DW_IDX_die_offset)
+							die_offset = value;
+					}
+
+					//
+					// The DIE offset of an entry in a type unit is relative to
+					// that unit, which we don't index; skip these.  Otherwise,
+					// an index with only one CU may omit DW_IDX_compile_unit.
+					//
+					if (is_type_unit)
+						continue;
+					if ((cu_index < 0) && (unit.CompileUnits.Length == 1))
+						cu_index = 0;
+
+					if (!is_kind (abbrev.Tag, kind) || (die_offset < 0) ||
+					    (cu_index < 0) || (cu_index >= unit.CompileUnits.Length))
+						continue;
+
+					entries.Add (new NameEntry (unit.CompileUnits [cu_index], die_offset));
 				}
 			}
+		}
 
-			return names;
+		// <summary>
+		//   The .gdb_index section which gdb-add-index creates; it only
+		//   tells us the compile unit, not the DIE.
+		// </summary>
+		protected class GdbIndex : NameIndex
+		{
+			const int GDB_INDEX_SYMBOL_KIND_TYPE = 1;
+			const int GDB_INDEX_SYMBOL_KIND_FUNCTION = 3;
+
+			DwarfReader dwarf;
+			TargetBlob blob;
+			int version;
+			long[] compile_units;
+			long symbol_table, constant_pool;
+			int num_slots;
+
+			public GdbIndex (DwarfReader dwarf, TargetBlob blob)
+			{
+				this.dwarf = dwarf;
+				this.blob = blob;
+
+				// This is always little-endian.
+				DwarfBinaryReader reader = get_reader ();
+				version = reader.ReadInt32 ();
+				if (version < 5)
+					throw new DwarfException (
+						dwarf.bfd, "Unsupported .gdb_index version: {0}", version);
+
+				long cu_list = reader.ReadUInt32 ();
+				long types_list = reader.ReadUInt32 ();
+				reader.ReadUInt32 ();
+				symbol_table = reader.ReadUInt32 ();
+				constant_pool = reader.ReadUInt32 ();
+
+				compile_units = new long [(types_list - cu_list) / 16];
+				reader.Position = cu_list;
+				for (int i = 0; i < compile_units.Length; i++) {
+					compile_units [i] = reader.ReadInt64 ();
+					reader.ReadInt64 ();
+				}
+
+				num_slots = (int) ((constant_pool - symbol_table) / 8);
+			}
+
+			DwarfBinaryReader get_reader ()
+			{
+				return new DwarfBinaryReader (dwarf.bfd, blob, dwarf.Is64Bit);
+			}
+
+			static uint hash_name (byte[] name)
+			{
+				uint hash = 0;
+				foreach (byte b in name) {
+					byte c = ((b >= 'A') && (b <= 'Z')) ? (byte) (b + 32) : b;
+					hash = hash * 67 + c - 113;
+				}
+				return hash;
+			}
+
+			public override void Lookup (string name, NameKind kind, ArrayList entries)
+			{
+				if (num_slots == 0)
+					return;
+
+				DwarfBinaryReader reader = get_reader ();
+
+				uint hash = hash_name (Encoding.UTF8.GetBytes (name));
+				uint mask = (uint) num_slots - 1;
+				uint slot = hash & mask;
+				uint step = ((hash * 17) & mask) | 1;
+
+				for (int i = 0; i < num_slots; i++) {
+					long pos = symbol_table + 8 * slot;
+					long name_offset = reader.PeekUInt32 (pos);
+					long vector_offset = reader.PeekUInt32 (pos + 4);
+					if ((name_offset == 0) && (vector_offset == 0))
+						return;
+
+					if (reader.PeekString (constant_pool + name_offset) == name) {
+						read_cu_vector (reader, constant_pool + vector_offset,
+								kind, entries);
+						return;
+					}
+
+					slot = (slot + step) & mask;
+				}
+			}
+
+			void read_cu_vector (DwarfBinaryReader reader, long pos, NameKind kind,
+					     ArrayList entries)
+			{
+				int count = reader.PeekInt32 (pos);
+
+				long last = -1;
+				for (int i = 0; i < count; i++) {
+					uint value = reader.PeekUInt32 (pos + 4 + 4 * i);
+					int cu_index = (int) (value & 0xffffff);
+					int symbol_kind = (int) ((value >> 28) & 7);
+
+					// Older versions don't record the symbol kind.
+					if ((version >= 7) && (symbol_kind != 0)) {
+						int wanted = (kind == NameKind.Function) ?
+							GDB_INDEX_SYMBOL_KIND_FUNCTION :
+							GDB_INDEX_SYMBOL_KIND_TYPE;
+						if (symbol_kind != wanted)
+							continue;
+					}
+
+					if ((cu_index >= compile_units.Length) ||
+					    (compile_units [cu_index] == last))
+						continue;
+
+					last = compile_units [cu_index];
+					entries.Add (new NameEntry (last, -1));
+				}
+			}
+		}
+
+		// <summary>
+		//   The name index we build ourselves if there's neither .debug_names
+		//   nor .gdb_index; see build_name_table().
+		// </summary>
+		protected class DwarfNameTable : NameIndex
+		{
+			DwarfNameIndex data;
+
+			// Maps each name to the first of its entries in `data'.
+			Hashtable names;
+			int[] next;
+
+			public DwarfNameTable (DwarfNameIndex data)
+			{
+				this.data = data;
+
+				names = new Hashtable (data.Names.Length);
+				next = new int [data.Names.Length];
+
+				for (int i = data.Names.Length - 1; i >= 0; i--) {
+					object first = names [data.Names [i]];
+					next [i] = (first != null) ? (int) first : -1;
+					names [data.Names [i]] = i;
+				}
+			}
+
+			public override void Lookup (string name, NameKind kind, ArrayList entries)
+			{
+				object first = names [name];
+				if (first == null)
+					return;
+
+				for (int i = (int) first; i >= 0; i = next [i]) {
+					if (data.Entries [3*i+2] != (long) kind)
+						continue;
+
+					entries.Add (new NameEntry (data.Entries [3*i], data.Entries [3*i+1]));
+				}
+			}
+		}
+
+		protected class NameTableBuilder
+		{
+			public readonly List<string> Names = new List<string> ();
+			public readonly List<long> Entries = new List<long> ();
+
+			public void Add (string name, long file_offset, long offset, NameKind kind)
+			{
+				Names.Add (name);
+				Entries.Add (file_offset);
+				Entries.Add (offset);
+				Entries.Add ((long) kind);
+			}
+		}
+
+		// <summary>
+		//   Read an attribute value of the given form which we're not
+		//   interested in, or which we know to be an integer.
+		// </summary>
+		long read_form_value (DwarfBinaryReader reader, DwarfForm form, bool is64bit)
+		{
+			switch (form) {
+			case DwarfForm.flag:
+			case DwarfForm.data1:
+			case DwarfForm.ref1:
+			case DwarfForm.strx1:
+			case DwarfForm.addrx1:
+				return reader.ReadByte ();
+
+			case DwarfForm.data2:
+			case DwarfForm.ref2:
+			case DwarfForm.strx2:
+			case DwarfForm.addrx2:
+				return (ushort) reader.ReadInt16 ();
+
+			case DwarfForm.strx3:
+			case DwarfForm.addrx3: {
+				long low = (ushort) reader.ReadInt16 ();
+				return low | ((long) reader.ReadByte () << 16);
+			}
+
+			case DwarfForm.data4:
+			case DwarfForm.ref4:
+			case DwarfForm.ref_sup4:
+			case DwarfForm.strx4:
+			case DwarfForm.addrx4:
+				return reader.ReadUInt32 ();
+
+			case DwarfForm.data8:
+			case DwarfForm.ref8:
+			case DwarfForm.ref_sig8:
+			case DwarfForm.ref_sup8:
+				return reader.ReadInt64 ();
+
+			case DwarfForm.data16:
+				reader.Position += 16;
+				return 0;
+
+			case DwarfForm.addr:
+				return reader.ReadAddress ();
+
+			case DwarfForm.ref_addr:
+				return (AddressSize == 8) ? reader.ReadInt64 () : reader.ReadUInt32 ();
+
+			case DwarfForm.strp:
+			case DwarfForm.line_strp:
+			case DwarfForm.strp_sup:
+			case DwarfForm.sec_offset:
+				return is64bit ? reader.ReadInt64 () : reader.ReadUInt32 ();
+
+			case DwarfForm.udata:
+			case DwarfForm.ref_udata:
+			case DwarfForm.strx:
+			case DwarfForm.addrx:
+			case DwarfForm.loclistx:
+			case DwarfForm.rnglistx:
+			case DwarfForm.GNU_addr_index:
+			case DwarfForm.GNU_str_index:
+				return reader.ReadLeb128 ();
+
+			case DwarfForm.sdata:
+				return reader.ReadSLeb128 ();
+
+			case DwarfForm.flag_present:
+				return 1;
+
+			// The value is in the abbreviation.
+			case DwarfForm.implicit_const:
+				return 0;
+
+			case DwarfForm.cstring:
+				// Skip it without creating a string.
+				while (reader.ReadByte () != 0)
+					;
+				return 0;
+
+			case DwarfForm.block1:
+				reader.Position += reader.ReadByte ();
+				return 0;
+
+			case DwarfForm.block2:
+				reader.Position += (ushort) reader.ReadInt16 ();
+				return 0;
+
+			case DwarfForm.block4:
+				reader.Position += reader.ReadUInt32 ();
+				return 0;
+
+			case DwarfForm.block:
+			case DwarfForm.exprloc:
+				reader.Position += reader.ReadLeb128 ();
+				return 0;
+
+			case DwarfForm.indirect:
+				return read_form_value (
+					reader, (DwarfForm) reader.ReadLeb128 (), is64bit);
+
+			default:
+				throw new DwarfException (
+					bfd, "Unknown DW_FORM: 0x{0:x}", (int) form);
+			}
+		}
+
+		NameIndex read_pubnames ()
+		{
+			string[] names;
+			long[] offsets;
+
+			if (index != null) {
+				names = index.PubNames;
+				offsets = index.PubNameOffsets;
+			} else {
+				if (debug_pubnames_reader == null)
+					return null;
+
+				read_raw_pubnames (out names, out offsets);
+			}
+
+			if (names.Length == 0)
+				return null;
+
+			Hashtable hash = new Hashtable ();
+			for (int i = 0; i < names.Length; i++) {
+				if (!hash.Contains (names [i]))
+					hash.Add (names [i], new NameEntry (offsets [2*i], offsets [2*i+1]));
+			}
+
+			return new PubNamesIndex (hash);
+		}
+
+		// <summary>
+		//   Read all of .debug_pubnames; `offsets' contains a
+		//   (compile unit offset, die offset) pair for each name.
+		// </summary>
+		void read_raw_pubnames (out string[] names, out long[] offsets)
+		{
+			List<string> name_list = new List<string> ();
+			List<long> offset_list = new List<long> ();
+
+			if (debug_pubnames_reader != null) {
+				DwarfBinaryReader reader = new DwarfBinaryReader (
+					bfd, (TargetBlob) debug_pubnames_reader.Data, Is64Bit);
+
+				while (!reader.IsEof) {
+					long length = reader.ReadInitialLength ();
+					long stop = reader.Position + length;
+					int version = reader.ReadInt16 ();
+					long debug_offset = reader.ReadOffset ();
+					reader.ReadOffset ();
+
+					// Skip anything we don't understand; it's just an index.
+					if (version != 2) {
+						reader.Position = stop;
+						continue;
+					}
+
+					while (reader.Position < stop) {
+						long offset = reader.ReadInt32 ();
+						if (offset == 0)
+							break;
+
+						name_list.Add (reader.ReadString ());
+						offset_list.Add (debug_offset);
+						offset_list.Add (offset);
+					}
+				}
+			}
+
+			names = name_list.ToArray ();
+			offsets = offset_list.ToArray ();
 		}
 
 		Hashtable read_pubtypes ()
@@ -701,10 +1841,10 @@ namespace Mono.Debugger.Backend
 				long debug_offset = reader.ReadOffset ();
 				reader.ReadOffset ();
 
-				if (version != 2)
-					throw new DwarfException (
-						bfd, "Wrong version in .debug_pubtypes: {0}",
-						version);
+				if (version != 2) {
+					reader.Position = stop;
+					continue;
+				}
 
 				while (reader.Position < stop) {
 					long offset = reader.ReadInt32 ();
@@ -723,8 +1863,7 @@ namespace Mono.Debugger.Backend
 		object create_reader_func (object user_data)
 		{
 			try {
-				byte[] contents = bfd.GetSectionContents ((string) user_data);
-				return new TargetBlob (contents, bfd.TargetMemoryInfo);
+				return bfd.GetSectionBlob ((string) user_data);
 			} catch {
 				Report.Debug (DebugFlags.DwarfReader,
 					      "{1} Can't find DWARF 2 debugging info in section `{0}'",
@@ -784,6 +1923,8 @@ namespace Mono.Debugger.Backend
 
 		public DwarfBinaryReader DebugLocationReader {
 			get {
+				if (debug_loc_reader == null)
+					return null;
 				return new DwarfBinaryReader (
 					bfd, (TargetBlob) debug_loc_reader.Data, Is64Bit);
 			}
@@ -791,44 +1932,91 @@ namespace Mono.Debugger.Backend
 
 		public DwarfBinaryReader DebugRangesReader {
 			get {
+				if (debug_ranges_reader == null)
+					return null;
 				return new DwarfBinaryReader (
 					bfd, (TargetBlob) debug_ranges_reader.Data, Is64Bit);
 			}
 		}
 
-		public string FileName {
+		public DwarfBinaryReader DebugStrOffsetsReader {
 			get {
-				return filename;
+				if (debug_str_offsets_reader == null)
+					return null;
+				return new DwarfBinaryReader (
+					bfd, (TargetBlob) debug_str_offsets_reader.Data, Is64Bit);
 			}
 		}
 
-		public bool Is64Bit {
+		public DwarfBinaryReader DebugAddrReader {
 			get {
-				return is64bit;
+				if (debug_addr_reader == null)
+					return null;
+				return new DwarfBinaryReader (
+					bfd, (TargetBlob) debug_addr_reader.Data, Is64Bit);
 			}
 		}
 
-		public byte AddressSize {
+		public DwarfBinaryReader DebugLineStrReader {
 			get {
-				return address_size;
+				if (debug_line_str_reader == null)
+					return null;
+				return new DwarfBinaryReader (
+					bfd, (TargetBlob) debug_line_str_reader.Data, Is64Bit);
 			}
 		}
 
-		[Conditional("REAL_DEBUG")]
-		static void debug (string message, params object[] args)
-		{
-			// Console.WriteLine (String.Format (message, args));
+		public DwarfBinaryReader DebugLocListsReader {
+			get {
+				if (debug_loclists_reader == null)
+					return null;
+				return new DwarfBinaryReader (
+					bfd, (TargetBlob) debug_loclists_reader.Data, Is64Bit);
+			}
 		}
 
-		protected enum DwarfLang {
-			C89         = 0x0001,
-			C           = 0x0002,
-			Ada83       = 0x0003,
-			C_plus_plus = 0x0004,
-			Cobol74     = 0x0005,
-			Cobol85     = 0x0006,
-			Fortran77   = 0x0007,
-			Fortran90   = 0x0008,
+		public DwarfBinaryReader DebugRngListsReader {
+			get {
+				if (debug_rnglists_reader == null)
+					return null;
+				return new DwarfBinaryReader (
+					bfd, (TargetBlob) debug_rnglists_reader.Data, Is64Bit);
+			}
+		}
+
+		public string FileName {
+			get {
+				return filename;
+			}
+		}
+
+		public bool Is64Bit {
+			get {
+				return is64bit;
+			}
+		}
+
+		public byte AddressSize {
+			get {
+				return address_size;
+			}
+		}
+
+		[Conditional("REAL_DEBUG")]
+		static void debug (string message, params object[] args)
+		{
+			// Console.WriteLine (String.Format (message, args));
+		}
+
+		protected enum DwarfLang {
+			C89         = 0x0001,
+			C           = 0x0002,
+			Ada83       = 0x0003,
+			C_plus_plus = 0x0004,
+			Cobol74     = 0x0005,
+			Cobol85     = 0x0006,
+			Fortran77   = 0x0007,
+			Fortran90   = 0x0008,
 			Pascal83    = 0x0009,
 			Modula2     = 0x000a,
 			None        = 0x8001
@@ -882,7 +2070,10 @@ namespace Mono.Debugger.Backend
 			variant_block           = 0x33,
 			variable		= 0x34,
 			volatile_type           = 0x35,
-			dwarf3_namespace        = 0x39
+			dwarf3_namespace        = 0x39,
+			partial_unit		= 0x3c,
+			type_unit		= 0x41,
+			skeleton_unit		= 0x4a
 		}
 
 		protected enum DwarfAttribute {
@@ -947,7 +2138,16 @@ namespace Mono.Debugger.Backend
 			vtable_elem_location	= 0x4d,
 			entry_pc		= 0x52,
 			extension		= 0x54,
-			ranges			= 0x55
+			ranges			= 0x55,
+			str_offsets_base	= 0x72,
+			addr_base		= 0x73,
+			rnglists_base		= 0x74,
+			dwo_name		= 0x76,
+			loclists_base		= 0x8c,
+			GNU_dwo_name		= 0x2130,
+			GNU_dwo_id		= 0x2131,
+			GNU_ranges_base		= 0x2132,
+			GNU_addr_base		= 0x2133
 		}
 
 		protected enum DwarfBaseTypeEncoding {
@@ -983,7 +2183,63 @@ namespace Mono.Debugger.Backend
 			ref4			= 0x13,
 			ref8			= 0x14,
 			ref_udata		= 0x15,
-			indirect                = 0x16
+			indirect                = 0x16,
+			sec_offset		= 0x17,
+			exprloc			= 0x18,
+			flag_present		= 0x19,
+			strx			= 0x1a,
+			addrx			= 0x1b,
+			ref_sup4		= 0x1c,
+			strp_sup		= 0x1d,
+			data16			= 0x1e,
+			line_strp		= 0x1f,
+			ref_sig8		= 0x20,
+			implicit_const		= 0x21,
+			loclistx		= 0x22,
+			rnglistx		= 0x23,
+			ref_sup8		= 0x24,
+			strx1			= 0x25,
+			strx2			= 0x26,
+			strx3			= 0x27,
+			strx4			= 0x28,
+			addrx1			= 0x29,
+			addrx2			= 0x2a,
+			addrx3			= 0x2b,
+			addrx4			= 0x2c,
+			GNU_addr_index		= 0x1f01,
+			GNU_str_index		= 0x1f02
+		}
+
+		protected enum DwarfUnitType {
+			compile			= 0x01,
+			type			= 0x02,
+			partial			= 0x03,
+			skeleton		= 0x04,
+			split_compile		= 0x05,
+			split_type		= 0x06
+		}
+
+		protected enum DwarfRangeListEntry {
+			end_of_list		= 0x00,
+			base_addressx		= 0x01,
+			startx_endx		= 0x02,
+			startx_length		= 0x03,
+			offset_pair		= 0x04,
+			base_address		= 0x05,
+			start_end		= 0x06,
+			start_length		= 0x07
+		}
+
+		protected enum DwarfLocationListEntry {
+			end_of_list		= 0x00,
+			base_addressx		= 0x01,
+			startx_endx		= 0x02,
+			startx_length		= 0x03,
+			offset_pair		= 0x04,
+			default_location	= 0x05,
+			base_address		= 0x06,
+			start_end		= 0x07,
+			start_length		= 0x08
 		}
 
 		protected enum DwarfInline {
@@ -1147,17 +2403,20 @@ namespace Mono.Debugger.Backend
 				public readonly SourceFile File;
 
 				public FileEntry (LineNumberEngine engine, DwarfBinaryReader reader)
+					: this (engine, reader.ReadString (), reader.ReadLeb128 ())
 				{
-					FileName = reader.ReadString ();
-					Directory = reader.ReadLeb128 ();
 					LastModificationTime = reader.ReadLeb128 ();
 					Length = reader.ReadLeb128 ();
+				}
 
-					string dir_name;
-					if (Directory > 0)
-						dir_name = (string) engine.include_dirs [Directory - 1];
-					else
-						dir_name = engine.compilation_dir;
+				public FileEntry (LineNumberEngine engine, string file_name, int directory)
+				{
+					FileName = file_name;
+					Directory = directory;
+					LastModificationTime = 0;
+					Length = 0;
+
+					string dir_name = engine.get_directory (Directory);
 
 					string full_name;
 					if (dir_name != null)
@@ -1174,6 +2433,76 @@ namespace Mono.Debugger.Backend
 				}
 			}
 
+			//
+			// DWARF 5 numbers directories and files from 0, where entry 0
+			// is the compilation directory or the primary source file.
+			// Older versions start at 1 and use 0 for the compilation
+			// directory.
+			//
+
+			string get_directory (int index)
+			{
+				if (version < 5) {
+					if (index > 0)
+						return (string) include_dirs [index - 1];
+					return compilation_dir;
+				}
+
+				if ((index < 0) || (index >= include_dirs.Count))
+					return null;
+
+				string dir_name = (string) include_dirs [index];
+				if ((index > 0) && (dir_name != null) && !Path.IsPathRooted (dir_name) &&
+				    (include_dirs [0] != null))
+					dir_name = Path.Combine ((string) include_dirs [0], dir_name);
+				return dir_name;
+			}
+
+			FileEntry get_file (int index)
+			{
+				return (FileEntry) source_files [(version < 5) ? index - 1 : index];
+			}
+
+			const int DW_LNCT_path = 1;
+			const int DW_LNCT_directory_index = 2;
+
+			// <summary>
+			//   Read a DWARF 5 directory or file name table, which starts
+			//   with a description of its entries.
+			// </summary>
+			void read_entry_table (bool is_file_table)
+			{
+				CompilationUnit unit = comp_unit.comp_unit;
+
+				int format_count = reader.ReadByte ();
+				int[] content_types = new int [format_count];
+				DwarfForm[] forms = new DwarfForm [format_count];
+				for (int i = 0; i < format_count; i++) {
+					content_types [i] = reader.ReadLeb128 ();
+					forms [i] = (DwarfForm) reader.ReadLeb128 ();
+				}
+
+				int count = reader.ReadLeb128 ();
+				for (int i = 0; i < count; i++) {
+					string path = null;
+					int directory = 0;
+
+					for (int j = 0; j < format_count; j++) {
+						if (content_types [j] == DW_LNCT_path)
+							path = unit.ReadString (reader, forms [j]);
+						else if (content_types [j] == DW_LNCT_directory_index)
+							directory = (int) unit.ReadFormValue (reader, forms [j]);
+						else
+							unit.ReadFormValue (reader, forms [j]);
+					}
+
+					if (is_file_table)
+						source_files.Add (new FileEntry (this, path, directory));
+					else
+						include_dirs.Add (path);
+				}
+			}
+
 			void commit ()
 			{
 				debug ("COMMIT: {0:x} {1} {2} {3}", stm.st_address, stm.st_line,
@@ -1216,9 +2545,15 @@ namespace Mono.Debugger.Backend
 				length = reader.ReadInitialLength ();
 				end_offset = reader.Position + length;
 				version = reader.ReadInt16 ();
+				if (version >= 5) {
+					reader.ReadByte ();	// address_size
+					reader.ReadByte ();	// segment_selector_size
+				}
 				header_length = reader.ReadOffset ();
 				data_offset = reader.Position + header_length;
 				minimum_insn_length = reader.ReadByte ();
+				if (version >= 4)
+					reader.ReadByte ();	// maximum_operations_per_instruction
 				default_is_stmt = reader.ReadByte () != 0;
 				line_base = (sbyte) reader.ReadByte ();
 				line_range = reader.ReadByte ();
@@ -1227,13 +2562,18 @@ namespace Mono.Debugger.Backend
 				for (int i = 0; i < opcode_base - 1; i++)
 					standard_opcode_lengths [i] = reader.ReadByte ();
 				include_dirs = new ArrayList ();
-				while (reader.PeekByte () != 0)
-					include_dirs.Add (reader.ReadString ());
-				reader.Position++;
 				source_files = new ArrayList ();
-				while (reader.PeekByte () != 0)
-					source_files.Add (new FileEntry (this, reader));
-				reader.Position++;
+				if (version >= 5) {
+					read_entry_table (false);
+					read_entry_table (true);
+				} else {
+					while (reader.PeekByte () != 0)
+						include_dirs.Add (reader.ReadString ());
+					reader.Position++;
+					while (reader.PeekByte () != 0)
+						source_files.Add (new FileEntry (this, reader));
+					reader.Position++;
+				}
 
 				const_add_pc_range = ((0xff - opcode_base) / line_range) *
 					minimum_insn_length;
@@ -1357,63 +2697,71 @@ namespace Mono.Debugger.Backend
 				reader.Position = end_pos;
 			}
 
-			public override TargetAddress Lookup (int line)
-			{
-				for (int i = 0; i < addresses.Length; i++) {
-					LineNumber entry = (LineNumber) addresses [i];
+			//
+			// `addresses' sorted by line and then by address; each entry is
+			// ((long) line << 32) | index.  We build it the first time we
+			// look up a line.
+			//
+			long[] lines_index;
 
-					if (entry.Line != line)
-						continue;
+			long[] get_lines_index ()
+			{
+				if (lines_index != null)
+					return lines_index;
 
-					return comp_unit.dwarf.GetAddress (entry.Offset);
-				}
+				long[] index = new long [addresses.Length];
+				for (int i = 0; i < addresses.Length; i++)
+					index [i] = ((long) addresses [i].Line << 32) | (uint) i;
+				Array.Sort (index);
 
-				return TargetAddress.Null;
+				lines_index = index;
+				return index;
 			}
 
-			SourceAddress do_lookup (TargetAddress address, int start_pos, int end_pos)
+			public override TargetAddress Lookup (int line)
 			{
-				if (end_pos - start_pos >= 4) {
-					int middle_pos = (start_pos + end_pos) / 2;
-					LineNumber middle = (LineNumber) addresses [middle_pos];
-
-					TargetAddress maddr = comp_unit.dwarf.GetAddress (middle.Offset);
-					if (address < maddr)
-						return do_lookup (address, start_pos, middle_pos);
-					else
-						return do_lookup (address, middle_pos, end_pos);
-				}
-
-				TargetAddress next_address;
-				if (end_pos == addresses.Length)
-					next_address = comp_unit.EndAddress;
-				else {
-					LineNumber end_line = addresses [end_pos];
-					next_address = comp_unit.dwarf.GetAddress (end_line.Offset);
-				}
-
-				for (int i = end_pos-1; i >= start_pos; i--) {
-					LineNumber line = addresses [i];
-
-					int range = (int) (next_address - address);
-					next_address = comp_unit.dwarf.GetAddress (line.Offset);
-
-					if (next_address > address)
-						continue;
-
-					int offset = (int) (address - next_address);
+				long[] index = get_lines_index ();
 
-					FileEntry file = (FileEntry) source_files [line.File - 1];
-					return new SourceAddress (
-						file.File, null, line.Line, offset, range);
-				}
+				int pos = Array.BinarySearch (index, (long) line << 32);
+				if (pos < 0)
+					pos = ~pos;
+				if ((pos >= index.Length) || ((int) (index [pos] >> 32) != line))
+					return TargetAddress.Null;
 
-				return null;
+				LineNumber entry = addresses [(int) (index [pos] & 0xffffffff)];
+				return comp_unit.dwarf.GetAddress (entry.Offset);
 			}
 
 			public override SourceAddress Lookup (TargetAddress address)
 			{
-				return do_lookup (address, 0, addresses.Length-1);
+				//
+				// Find the last line which starts at or before `address';
+				// the last entry only marks the end of the previous one.
+				//
+				int lo = 0, hi = addresses.Length - 2, found = -1;
+				while (lo <= hi) {
+					int mid = (lo + hi) / 2;
+					TargetAddress maddr = comp_unit.dwarf.GetAddress (addresses [mid].Offset);
+					if (maddr <= address) {
+						found = mid;
+						lo = mid + 1;
+					} else
+						hi = mid - 1;
+				}
+
+				if (found < 0)
+					return null;
+
+				LineNumber line = addresses [found];
+				TargetAddress start = comp_unit.dwarf.GetAddress (line.Offset);
+				TargetAddress next_address = comp_unit.dwarf.GetAddress (
+					addresses [found + 1].Offset);
+
+				int offset = (int) (address - start);
+				int range = (int) (next_address - address);
+
+				FileEntry file = get_file (line.File);
+				return new SourceAddress (file.File, null, line.Line, offset, range);
 			}
 
 			public override bool HasMethodBounds {
@@ -1452,15 +2800,15 @@ namespace Mono.Debugger.Backend
 
 		protected struct AttributeEntry
 		{
-			DwarfReader dwarf;
 			DwarfAttribute attr;
 			DwarfForm form;
+			long implicit_const;
 
-			public AttributeEntry (DwarfReader dwarf, DwarfAttribute attr, DwarfForm form)
+			public AttributeEntry (DwarfAttribute attr, DwarfForm form, long implicit_const)
 			{
-				this.dwarf = dwarf;
 				this.attr = attr;
 				this.form = form;
+				this.implicit_const = implicit_const;
 			}
 
 			public DwarfAttribute DwarfAttribute {
@@ -1475,9 +2823,10 @@ namespace Mono.Debugger.Backend
 				}
 			}
 
-			public Attribute ReadAttribute (long offset)
+			public Attribute ReadAttribute (CompilationUnit comp_unit, DwarfBinaryReader reader,
+							long offset)
 			{
-				return new Attribute (dwarf, offset, attr, form);
+				return new Attribute (comp_unit, reader, offset, attr, form, implicit_const);
 			}
 
 			public override string ToString ()
@@ -1490,21 +2839,31 @@ namespace Mono.Debugger.Backend
 		protected class Attribute
 		{
 			DwarfReader dwarf;
+			CompilationUnit comp_unit;
+			DwarfBinaryReader reader;
 			DwarfAttribute attr;
 			DwarfForm form;
 			long offset;
+			long implicit_const;
 
 			bool has_datasize, has_data;
 			int data_size;
 			object data;
 
-			public Attribute (DwarfReader dwarf, long offset,
-					  DwarfAttribute attr, DwarfForm form)
+			//
+			// We only peek at `reader', so we can share the reader of the
+			// DIE instead of creating a new one for each attribute.
+			//
+			public Attribute (CompilationUnit comp_unit, DwarfBinaryReader reader, long offset,
+					  DwarfAttribute attr, DwarfForm form, long implicit_const)
 			{
-				this.dwarf = dwarf;
+				this.dwarf = comp_unit.DwarfReader;
+				this.comp_unit = comp_unit;
+				this.reader = reader;
 				this.offset = offset;
 				this.attr = attr;
 				this.form = form;
+				this.implicit_const = implicit_const;
 			}
 
 			public DwarfAttribute DwarfAttribute {
@@ -1519,58 +2878,122 @@ namespace Mono.Debugger.Backend
 				}
 			}
 
+			// <summary>
+			//   Whether this is a constant rather than an address or a
+			//   reference into some other section; since DWARF 4, a constant
+			//   DW_AT_high_pc is relative to DW_AT_low_pc.
+			// </summary>
+			public bool IsConstant {
+				get {
+					switch (form) {
+					case DwarfForm.data1:
+					case DwarfForm.data2:
+					case DwarfForm.data4:
+					case DwarfForm.data8:
+					case DwarfForm.sdata:
+					case DwarfForm.udata:
+					case DwarfForm.implicit_const:
+						return true;
+
+					default:
+						return false;
+					}
+				}
+			}
+
+			int offset_size {
+				get { return dwarf.Is64Bit ? 8 : 4; }
+			}
+
+			// DWARF 2 used the address size for DW_FORM_ref_addr.
+			int ref_addr_size {
+				get { return (comp_unit.Version < 3) ? dwarf.AddressSize : offset_size; }
+			}
+
 			int get_datasize ()
 			{
 				switch (form) {
+				case DwarfForm.flag_present:
+				case DwarfForm.implicit_const:
+					return 0;
+
 				case DwarfForm.ref1:
 				case DwarfForm.data1:
 				case DwarfForm.flag:
+				case DwarfForm.strx1:
+				case DwarfForm.addrx1:
 					return 1;
 
 				case DwarfForm.ref2:
 				case DwarfForm.data2:
+				case DwarfForm.strx2:
+				case DwarfForm.addrx2:
 					return 2;
 
+				case DwarfForm.strx3:
+				case DwarfForm.addrx3:
+					return 3;
+
 				case DwarfForm.ref4:
 				case DwarfForm.data4:
+				case DwarfForm.ref_sup4:
+				case DwarfForm.strx4:
+				case DwarfForm.addrx4:
 					return 4;
 
 				case DwarfForm.ref8:
 				case DwarfForm.data8:
+				case DwarfForm.ref_sig8:
+				case DwarfForm.ref_sup8:
 					return 8;
 
+				case DwarfForm.data16:
+					return 16;
+
 				case DwarfForm.addr:
-				case DwarfForm.ref_addr:
 					return dwarf.AddressSize;
 
+				case DwarfForm.ref_addr:
+					return ref_addr_size;
+
 				case DwarfForm.block1:
-					return dwarf.DebugInfoReader.PeekByte (offset) + 1;
+					return reader.PeekByte (offset) + 1;
 
 				case DwarfForm.block2:
-					return dwarf.DebugInfoReader.PeekInt16 (offset) + 2;
+					return reader.PeekInt16 (offset) + 2;
 
 				case DwarfForm.block4:
-					return dwarf.DebugInfoReader.PeekInt32 (offset) + 4;
+					return reader.PeekInt32 (offset) + 4;
 
 				case DwarfForm.block:
-				case DwarfForm.ref_udata: {
+				case DwarfForm.exprloc: {
 					int size, size2;
-					size2 = dwarf.DebugInfoReader.PeekLeb128 (offset, out size);
+					size2 = reader.PeekLeb128 (offset, out size);
 					return size + size2;
 				}
 
+				case DwarfForm.ref_udata:
 				case DwarfForm.udata:
-				case DwarfForm.sdata: {
+				case DwarfForm.sdata:
+				case DwarfForm.strx:
+				case DwarfForm.addrx:
+				case DwarfForm.loclistx:
+				case DwarfForm.rnglistx:
+				case DwarfForm.GNU_addr_index:
+				case DwarfForm.GNU_str_index: {
 					int size;
-					dwarf.DebugInfoReader.PeekLeb128 (offset, out size);
+					reader.PeekLeb128 (offset, out size);
 					return size;
 				}
 
 				case DwarfForm.strp:
-					return dwarf.Is64Bit ? 8 : 4;
+				case DwarfForm.line_strp:
+				case DwarfForm.strp_sup:
+				case DwarfForm.sec_offset:
+					return offset_size;
 
 				case DwarfForm.cstring: {
-					string str = dwarf.DebugInfoReader.PeekString (offset);
+					string str = reader.PeekString (offset);
 					return str.Length + 1;
 				}
 
@@ -1592,15 +3015,50 @@ namespace Mono.Debugger.Backend
 				}
 			}
 
-			object read_data ()
+			long peek_index (DwarfBinaryReader reader)
 			{
-				DwarfBinaryReader reader = dwarf.DebugInfoReader;
+				switch (form) {
+				case DwarfForm.strx1:
+				case DwarfForm.addrx1:
+					data_size = 1;
+					return reader.PeekByte (offset);
+
+				case DwarfForm.strx2:
+				case DwarfForm.addrx2:
+					data_size = 2;
+					return (ushort) reader.PeekInt16 (offset);
+
+				case DwarfForm.strx3:
+				case DwarfForm.addrx3:
+					data_size = 3;
+					return (ushort) reader.PeekInt16 (offset) |
+						((long) reader.PeekByte (offset + 2) << 16);
 
+				case DwarfForm.strx4:
+				case DwarfForm.addrx4:
+					data_size = 4;
+					return reader.PeekUInt32 (offset);
+
+				default:
+					return reader.PeekLeb128 (offset, out data_size);
+				}
+			}
+
+			object read_data ()
+			{
 				switch (form) {
 				case DwarfForm.flag:
 					data_size = 1;
 					return reader.PeekByte (offset) != 0;
 
+				case DwarfForm.flag_present:
+					data_size = 0;
+					return true;
+
+				case DwarfForm.implicit_const:
+					data_size = 0;
+					return implicit_const;
+
 				case DwarfForm.ref1:
 				case DwarfForm.data1:
 					data_size = 1;
@@ -1613,14 +3071,20 @@ namespace Mono.Debugger.Backend
 
 				case DwarfForm.ref4:
 				case DwarfForm.data4:
+				case DwarfForm.ref_sup4:
 					data_size = 4;
 					return (long) reader.PeekInt32 (offset);
 
 				case DwarfForm.ref8:
 				case DwarfForm.data8:
+				case DwarfForm.ref_sup8:
 					data_size = 8;
 					return (long) reader.PeekInt64 (offset);
 
+				case DwarfForm.data16:
+					data_size = 16;
+					return reader.PeekBuffer (offset, 16);
+
 				case DwarfForm.addr:
 					data_size = dwarf.AddressSize;
 					return (long) reader.PeekAddress (offset);
@@ -1643,29 +3107,83 @@ namespace Mono.Debugger.Backend
 					data_size = reader.PeekInt32 (offset) + 4;
 					return reader.PeekBuffer (offset + 4, data_size - 4);
 
-				case DwarfForm.block: {
+				case DwarfForm.block:
+				case DwarfForm.exprloc: {
 					int size;
-					data_size = reader.PeekLeb128 (offset, out size);
-					return reader.PeekBuffer (offset + size, data_size);
+					int length = reader.PeekLeb128 (offset, out size);
+					data_size = size + length;
+					return reader.PeekBuffer (offset + size, length);
 				}
 
 				case DwarfForm.strp: {
-					if (dwarf.DebugStrReader == null)
+					DwarfBinaryReader str_reader = comp_unit.DebugStrReader;
+					if (str_reader == null)
 						throw new DwarfException (
 							dwarf.bfd, "Got DW_FORM_strp, but " +
 							"'.debug_str' section is missing.");
 					long str_offset = reader.PeekOffset (offset, out data_size);
-					return dwarf.DebugStrReader.PeekString (str_offset);
+					return str_reader.PeekString (str_offset);
+				}
+
+				case DwarfForm.line_strp: {
+					DwarfBinaryReader str_reader = dwarf.DebugLineStrReader;
+					if (str_reader == null)
+						throw new DwarfException (
+							dwarf.bfd, "Got DW_FORM_line_strp, but " +
+							"'.debug_line_str' section is missing.");
+					long str_offset = reader.PeekOffset (offset, out data_size);
+					return str_reader.PeekString (str_offset);
 				}
 
+				case DwarfForm.strx:
+				case DwarfForm.strx1:
+				case DwarfForm.strx2:
+				case DwarfForm.strx3:
+				case DwarfForm.strx4:
+				case DwarfForm.GNU_str_index:
+					return comp_unit.GetIndexedString (peek_index (reader));
+
+				case DwarfForm.addrx:
+				case DwarfForm.addrx1:
+				case DwarfForm.addrx2:
+				case DwarfForm.addrx3:
+				case DwarfForm.addrx4:
+				case DwarfForm.GNU_addr_index:
+					return comp_unit.GetIndexedAddress (peek_index (reader));
+
 				case DwarfForm.ref_udata:
 				case DwarfForm.udata:
-				case DwarfForm.sdata:
+				case DwarfForm.loclistx:
+				case DwarfForm.rnglistx:
 					return (long) reader.PeekLeb128 (offset, out data_size);
 
-				case DwarfForm.ref_addr:
+				case DwarfForm.sdata:
+					return (long) reader.PeekSLeb128 (offset, out data_size);
+
+				case DwarfForm.sec_offset:
+				case DwarfForm.strp_sup:
 					return (long) reader.PeekOffset (offset, out data_size);
 
+				//
+				// These point into other units; we return an offset
+				// relative to our own unit, just like the other
+				// references, and CompilationUnit.GetType() finds the
+				// right unit.
+				//
+				case DwarfForm.ref_addr: {
+					long ref_offset;
+					data_size = ref_addr_size;
+					if (data_size == 8)
+						ref_offset = reader.PeekInt64 (offset);
+					else
+						ref_offset = reader.PeekUInt32 (offset);
+					return ref_offset - comp_unit.RealStartOffset;
+				}
+
+				case DwarfForm.ref_sig8:
+					data_size = 8;
+					return comp_unit.GetTypeUnitReference (reader.PeekInt64 (offset));
+
 				default:
 					throw new DwarfException (
 						dwarf.bfd, "Unknown DW_FORM: 0x{0:x}",
@@ -1698,15 +3216,15 @@ namespace Mono.Debugger.Backend
 			DwarfTag tag;
 			bool has_children;
 
-			public readonly ArrayList Attributes;
+			public readonly AttributeEntry[] Attributes;
 
-			public AbbrevEntry (DwarfReader dwarf, DwarfBinaryReader reader)
+			public AbbrevEntry (DwarfBinaryReader reader)
 			{
 				abbrev_id = reader.ReadLeb128 ();
 				tag = (DwarfTag) reader.ReadLeb128 ();
 				has_children = reader.ReadByte () != 0;
 
-				Attributes = new ArrayList ();
+				List<AttributeEntry> list = new List<AttributeEntry> ();
 
 				do {
 					int attr = reader.ReadLeb128 ();
@@ -1715,9 +3233,15 @@ namespace Mono.Debugger.Backend
 					if ((attr == 0) && (form == 0))
 						break;
 
-					Attributes.Add (new AttributeEntry (
-						dwarf, (DwarfAttribute) attr, (DwarfForm) form));
+					long implicit_const = 0;
+					if ((DwarfForm) form == DwarfForm.implicit_const)
+						implicit_const = reader.ReadSLeb128 ();
+
+					list.Add (new AttributeEntry (
+						(DwarfAttribute) attr, (DwarfForm) form, implicit_const));
 				} while (true);
+
+				Attributes = list.ToArray ();
 			}
 
 			public int ID {
@@ -1745,6 +3269,75 @@ namespace Mono.Debugger.Backend
 			}
 		}
 
+		// <summary>
+		//   An abbreviation table from .debug_abbrev.  Most compile units
+		//   share their table with other units, so we cache them by their
+		//   offset; see AbbrevTable.Get().
+		// </summary>
+		protected class AbbrevTable
+		{
+			AbbrevEntry[] entries;
+			Hashtable sparse;
+
+			AbbrevTable (DwarfBinaryReader reader)
+			{
+				ArrayList list = new ArrayList ();
+				int max_id = 0;
+
+				while (reader.PeekByte () != 0) {
+					AbbrevEntry entry = new AbbrevEntry (reader);
+					max_id = Math.Max (max_id, entry.ID);
+					list.Add (entry);
+				}
+
+				//
+				// The compiler numbers abbreviations 1, 2, 3, ..., so we
+				// can usually use an array instead of a hash table.
+				//
+				if (max_id <= 2 * list.Count + 16) {
+					entries = new AbbrevEntry [max_id + 1];
+					foreach (AbbrevEntry entry in list)
+						entries [entry.ID] = entry;
+				} else {
+					sparse = new Hashtable ();
+					foreach (AbbrevEntry entry in list)
+						sparse [entry.ID] = entry;
+				}
+			}
+
+			// <summary>
+			//   Get the table at `offset' in `reader', which is cached in
+			//   `cache'.
+			// </summary>
+			public static AbbrevTable Get (Hashtable cache, DwarfBinaryReader reader,
+						       long offset)
+			{
+				lock (cache) {
+					AbbrevTable table = (AbbrevTable) cache [offset];
+					if (table != null)
+						return table;
+
+					reader.Position = offset;
+					table = new AbbrevTable (reader);
+					cache.Add (offset, table);
+					return table;
+				}
+			}
+
+			// <summary>
+			//   Returns null if there's no such entry.
+			// </summary>
+			public AbbrevEntry this [int abbrev_id] {
+				get {
+					if (entries == null)
+						return (AbbrevEntry) sparse [abbrev_id];
+					if ((abbrev_id < 0) || (abbrev_id >= entries.Length))
+						return null;
+					return entries [abbrev_id];
+				}
+			}
+		}
+
 		// <summary>
 		// Base class for all DIE's - The DWARF Debugging Information Entry.
 		// </summary>
@@ -1761,7 +3354,8 @@ namespace Mono.Debugger.Backend
 				int total_size = 0;
 
 				foreach (AttributeEntry entry in abbrev.Attributes) {
-					Attribute attribute = entry.ReadAttribute (Offset + total_size);
+					Attribute attribute = entry.ReadAttribute (
+						comp_unit, reader, Offset + total_size);
 					ProcessAttribute (attribute);
 					total_size += attribute.DataSize;
 				}
@@ -1774,20 +3368,30 @@ namespace Mono.Debugger.Backend
 
 			ArrayList children;
 
+			//
+			// Many DIE's have the DW_CHILDREN_yes flag, but no children;
+			// they all share this list.
+			//
+			static readonly ArrayList no_children = ArrayList.ReadOnly (new ArrayList ());
+
 			protected virtual ArrayList ReadChildren (DwarfBinaryReader reader)
 			{
 				if (!abbrev.HasChildren)
 					return null;
 
-				children = new ArrayList ();
+				ArrayList list = null;
 
 				while (reader.PeekByte () != 0) {
 					Die child = CreateDie (reader, comp_unit);
 					child.ReadChildren (reader);
-					children.Add (child);
+
+					if (list == null)
+						list = new ArrayList ();
+					list.Add (child);
 				}
 
 				reader.Position++;
+				children = (list != null) ? list : no_children;
 				return children;
 			}
 
@@ -1797,7 +3401,7 @@ namespace Mono.Debugger.Backend
 						return null;
 
 					if (children == null) {
-						DwarfBinaryReader reader = dwarf.DebugInfoReader;
+						DwarfBinaryReader reader = comp_unit.DebugInfoReader;
 
 						long old_pos = reader.Position;
 						reader.Position = ChildrenOffset;
@@ -1922,24 +3526,30 @@ namespace Mono.Debugger.Backend
 					       AbbrevEntry abbrev)
 				: base (reader, comp_unit, abbrev)
 			{
+				if (high_pc_is_offset && (start_pc != null) && (end_pc != null))
+					end_pc += start_pc;
+
 				if ((start_pc != null) && (end_pc != null))
 					is_continuous = true;
 
-				string file_name;
-				if (comp_dir != null)
-					file_name = String.Concat (
-						comp_dir, Path.DirectorySeparatorChar, name);
-				else
-					file_name = name;
-				file = dwarf.GetSourceFile (file_name);
+				//
+				// Skeleton units leave the name to their split unit and type
+				// units don't have one; we find their source file when
+				// somebody asks for it.
+				//
+				if ((name != null) && !comp_unit.IsSplitUnit)
+					ReadSourceFile ();
 			}
 
 			long? start_pc, end_pc, entry_pc;
+			bool high_pc_is_offset;
 			string name;
 			string comp_dir;
+			string dwo_name;
 			bool is_continuous;
 			DwarfLang language;
 			SourceFile file;
+			bool file_initialized;
 			CompileUnitSymbolTable symtab;
 			ArrayList children;
 			LineNumberEngine engine;
@@ -1955,15 +3565,53 @@ namespace Mono.Debugger.Backend
 
 				children = new ArrayList ();
 
-				if (abbrev.HasChildren) {
-					foreach (Die child in Children) {
-						DieSubprogram subprog = child as DieSubprogram;
-						if ((subprog == null) || !subprog.IsContinuous)
-							continue;
+				//
+				// If we're a skeleton unit, this is the time to load
+				// our split unit from the .dwo or .dwp file.
+				//
+				ArrayList dies = null;
+				if (comp_unit.IsSkeleton) {
+					CompilationUnit split_unit = comp_unit.SplitUnit;
+					if (split_unit != null)
+						dies = split_unit.UnitDie.Children;
+				} else if (abbrev.HasChildren)
+					dies = Children;
+
+				if (dies == null)
+					return;
+
+				foreach (Die child in dies) {
+					DieSubprogram subprog = child as DieSubprogram;
+					if ((subprog == null) || !subprog.IsContinuous)
+						continue;
+
+					children.Add (subprog);
+				}
+			}
+
+			public void ReadSourceFile ()
+			{
+				if (file_initialized)
+					return;
 
-						children.Add (subprog);
+				string file_name = name, dir_name = comp_dir;
+				if ((file_name == null) && comp_unit.IsSkeleton) {
+					CompilationUnit split_unit = comp_unit.SplitUnit;
+					if (split_unit != null) {
+						file_name = split_unit.UnitDie.name;
+						if (dir_name == null)
+							dir_name = split_unit.UnitDie.comp_dir;
 					}
 				}
+
+				if (file_name != null) {
+					if (dir_name != null)
+						file_name = String.Concat (
+							dir_name, Path.DirectorySeparatorChar, file_name);
+					file = dwarf.GetSourceFile (file_name);
+				}
+
+				file_initialized = true;
 			}
 
 			void initialize_children ()
@@ -2033,6 +3681,12 @@ namespace Mono.Debugger.Backend
 
 				case DwarfAttribute.high_pc:
 					end_pc = (long) attribute.Data;
+					high_pc_is_offset = attribute.IsConstant;
+					break;
+
+				case DwarfAttribute.dwo_name:
+				case DwarfAttribute.GNU_dwo_name:
+					dwo_name = (string) attribute.Data;
 					break;
 
 				case DwarfAttribute.entry_pc:
@@ -2073,6 +3727,12 @@ namespace Mono.Debugger.Backend
 				}
 			}
 
+			public string DwoName {
+				get {
+					return dwo_name;
+				}
+			}
+
 			public bool IsContinuous {
 				get {
 					return is_continuous;
@@ -2126,6 +3786,7 @@ namespace Mono.Debugger.Backend
 
 			public SourceFile SourceFile {
 				get {
+					ReadSourceFile ();
 					return file;
 				}
 			}
@@ -2181,7 +3842,7 @@ namespace Mono.Debugger.Backend
 		{
 			long abstract_origin, specification;
 			long real_offset, start_pc, end_pc;
-			bool is_continuous, resolved;
+			bool high_pc_is_offset, is_continuous, resolved;
 			string full_name, name;
 			DwarfTargetMethod method;
 			LineNumberEngine engine;
@@ -2202,6 +3863,7 @@ namespace Mono.Debugger.Backend
 
 				case DwarfAttribute.high_pc:
 					end_pc = (long) attribute.Data;
+					high_pc_is_offset = attribute.IsConstant;
 					debug ("{0}: end_pc = {1:x}", Offset, end_pc);
 					break;
 
@@ -2264,6 +3926,8 @@ namespace Mono.Debugger.Backend
 				: base (reader, comp_unit, abbrev)
 			{
 				this.real_offset = offset;
+				if (high_pc_is_offset && (end_pc != 0))
+					end_pc += start_pc;
 				if ((start_pc != 0) && (end_pc != 0))
 					is_continuous = true;
 
@@ -2345,6 +4009,16 @@ namespace Mono.Debugger.Backend
 				}
 			}
 
+			// <summary>
+			//   A key which is unique within the DwarfReader, even if we're
+			//   in a split unit.
+			// </summary>
+			internal long Handle {
+				get {
+					return comp_unit.OffsetBias + Offset;
+				}
+			}
+
 			public int CompareTo (object obj)
 			{
 				DieSubprogram die = (DieSubprogram) obj;
@@ -2544,7 +4218,7 @@ namespace Mono.Debugger.Backend
 			}
 
 			internal long Handle {
-				get { return subprog.Offset; }
+				get { return subprog.Handle; }
 			}
 
 			public override Module Module {
@@ -2721,160 +4395,1213 @@ namespace Mono.Debugger.Backend
 				SetMethodBounds (StartAddress + start.LineRange,
 						 EndAddress - end.LineOffset);
 
-				source = subprog.dwarf.GetMethodSource (subprog, start_row, end_row);
+				source = subprog.dwarf.GetMethodSource (subprog, start_row, end_row);
+
+				lock (subprog.dwarf.method_hash) {
+					subprog.dwarf.method_hash.Add (source.Handle, this);
+				}
+			}
+
+			public bool CheckLoaded ()
+			{
+				if (!subprog.dwarf.bfd.IsLoaded)
+					return false;
+
+				ISymbolContainer sc = (ISymbolContainer) subprog;
+				if (sc.IsContinuous)
+					SetAddresses (sc.StartAddress, sc.EndAddress);
+
+				SetLineNumbers (engine);
+
+				read_line_numbers ();
+
+				return true;
+			}
+
+			internal override MethodSource GetTrampoline (TargetMemoryAccess memory,
+								      TargetAddress address)
+			{
+				return null;
+			}
+		}
+
+		// <summary>
+		//   The header at the start of each unit in .debug_info.  DWARF 5
+		//   changed its layout and added type, skeleton and split units.
+		// </summary>
+		protected class UnitHeader
+		{
+			public readonly long RealStartOffset, StartOffset, UnitLength;
+			public readonly bool Is64Bit;
+			public readonly int Version, AddressSize;
+			public readonly DwarfUnitType UnitType;
+			public readonly long AbbrevOffset;
+			public readonly long DwoId, TypeSignature, TypeOffset;
+
+			public UnitHeader (Bfd bfd, DwarfBinaryReader reader)
+			{
+				RealStartOffset = reader.Position;
+				UnitLength = reader.ReadInitialLength (out Is64Bit);
+				StartOffset = reader.Position;
+				Version = reader.ReadInt16 ();
+
+				if ((Version < 2) || (Version > 5))
+					throw new DwarfException (
+						bfd, "Wrong DWARF version: {0}", Version);
+
+				if (Version >= 5) {
+					UnitType = (DwarfUnitType) reader.ReadByte ();
+					AddressSize = reader.ReadByte ();
+					AbbrevOffset = read_offset (reader);
+				} else {
+					UnitType = DwarfUnitType.compile;
+					AbbrevOffset = read_offset (reader);
+					AddressSize = reader.ReadByte ();
+				}
+
+				switch (UnitType) {
+				case DwarfUnitType.skeleton:
+				case DwarfUnitType.split_compile:
+					DwoId = reader.ReadInt64 ();
+					break;
+
+				case DwarfUnitType.type:
+				case DwarfUnitType.split_type:
+					TypeSignature = reader.ReadInt64 ();
+					TypeOffset = read_offset (reader);
+					break;
+				}
+
+				if ((AddressSize != 4) && (AddressSize != 8))
+					throw new DwarfException (
+						bfd, "Unknown address size: {0}", AddressSize);
+			}
+
+			long read_offset (DwarfBinaryReader reader)
+			{
+				return Is64Bit ? reader.ReadInt64 () : reader.ReadUInt32 ();
+			}
+
+			public long EndOffset {
+				get { return StartOffset + UnitLength; }
+			}
+
+			public bool IsTypeUnit {
+				get {
+					return (UnitType == DwarfUnitType.type) ||
+						(UnitType == DwarfUnitType.split_type);
+				}
+			}
+		}
+
+		// <summary>
+		//   A flat table of the DIE's in a unit, which we can read without
+		//   creating any Die or Attribute objects.  Each entry has the DIE's
+		//   offset relative to the start of the unit, its tag, and the index
+		//   of its parent and of its next sibling; both are -1 if there is
+		//   none.  Children of the unit's DIE have no parent.
+		// </summary>
+		protected class DieTable
+		{
+			public struct Entry
+			{
+				public long Offset;
+				public DwarfTag Tag;
+				public int Parent;
+				public int Sibling;
+			}
+
+			Entry[] entries = new Entry [64];
+			int count;
+
+			public int Count {
+				get { return count; }
+			}
+
+			public Entry this [int index] {
+				get { return entries [index]; }
+			}
+
+			internal int Add (long offset, DwarfTag tag, int parent)
+			{
+				if (count == entries.Length)
+					Array.Resize (ref entries, 2 * count);
+
+				entries [count].Offset = offset;
+				entries [count].Tag = tag;
+				entries [count].Parent = parent;
+				entries [count].Sibling = -1;
+				return count++;
+			}
+
+			internal void SetSibling (int index, int sibling)
+			{
+				entries [index].Sibling = sibling;
+			}
+		}
+
+		protected class CompilationUnit
+		{
+			DwarfReader dwarf;
+			long real_start_offset, start_offset, unit_length, abbrev_offset;
+			int version, address_size;
+			UnitHeader header;
+			DieCompileUnit comp_unit_die;
+			AbbrevTable abbrevs;
+			Hashtable types;
+			Hashtable subprogs;
+			Dictionary<long,DieNamespace> namespaces;
+
+			//
+			// DWARF 5 and the GNU split-DWARF extension put strings,
+			// addresses, range and location lists into tables which the
+			// unit's DIE's index into.
+			//
+			long str_offsets_base, addr_base, rnglists_base, loclists_base;
+			long gnu_ranges_base;
+			long dwo_id;
+			bool has_dwo_name;
+
+			//
+			// For units in a .dwo or .dwp file: the file and the skeleton
+			// unit in the executable.  For skeleton units: the split unit,
+			// which we only load on demand.
+			//
+			DwarfSplitFile split_file;
+			CompilationUnit skeleton;
+			CompilationUnit split_unit;
+			bool split_unit_loaded;
+			bool children_read;
+			long offset_bias;
+
+			//
+			// Types whose DW_AT_specification is in another unit; see
+			// ResolveDeferredTypes().
+			//
+			ArrayList deferred_types;
+
+			//
+			// The number of threads which are currently resolving our
+			// deferred types, and how many units the current thread is
+			// resolving.
+			//
+			int resolving;
+			[ThreadStatic]
+			static int resolve_depth;
+
+			public CompilationUnit (DwarfReader dwarf, DwarfBinaryReader reader)
+				: this (dwarf, null, null, null, reader)
+			{ }
+
+			public CompilationUnit (DwarfReader dwarf, DwarfSplitFile split_file,
+						long[] section_offsets, CompilationUnit skeleton,
+						DwarfBinaryReader reader)
+			{
+				this.dwarf = dwarf;
+				this.split_file = split_file;
+				this.skeleton = skeleton;
+
+				header = new UnitHeader (dwarf.bfd, reader);
+				real_start_offset = header.RealStartOffset;
+				unit_length = header.UnitLength;
+				start_offset = header.StartOffset;
+				version = header.Version;
+				address_size = header.AddressSize;
+				abbrev_offset = header.AbbrevOffset;
+				dwo_id = header.DwoId;
+
+				if (split_file != null) {
+					abbrev_offset += get_section_offset (
+						section_offsets, DwarfSplitFile.DW_SECT_ABBREV);
+
+					//
+					// Split units don't have any DW_AT_*_base attributes;
+					// their tables start right after the header of their
+					// contribution to the section.
+					//
+					int offset_size = header.Is64Bit ? 8 : 4;
+					str_offsets_base = get_section_offset (
+						section_offsets, DwarfSplitFile.DW_SECT_STR_OFFSETS);
+					if (version >= 5)
+						str_offsets_base += 2 * offset_size;
+					rnglists_base = get_section_offset (
+						section_offsets, DwarfSplitFile.DW_SECT_RNGLISTS) +
+						2 * offset_size + 4;
+					loclists_base = get_section_offset (
+						section_offsets, DwarfSplitFile.DW_SECT_LOCLISTS) +
+						2 * offset_size + 4;
+
+					// The DIE offsets in the .dwo file overlap the ones in
+					// the executable.
+					if (skeleton != null)
+						offset_bias = (skeleton.real_start_offset + 1) << 32;
+				}
+
+				types = new Hashtable ();
+				subprogs = new Hashtable ();
+				namespaces = new Dictionary<long,DieNamespace> ();
+
+				if (split_file != null)
+					abbrevs = split_file.GetAbbrevTable (abbrev_offset);
+				else
+					abbrevs = dwarf.get_abbrev_table (abbrev_offset);
+
+				long die_offset = reader.Position;
+				read_base_attributes (reader);
+				reader.Position = die_offset;
+
+				comp_unit_die = Die.CreateDieCompileUnit (reader, this);
+
+				reader.Position = start_offset + unit_length;
+			}
+
+			static long get_section_offset (long[] section_offsets, int section)
+			{
+				return (section_offsets != null) ? section_offsets [section] : 0;
+			}
+
+			// <summary>
+			//   We need to know the DW_AT_*_base attributes to decode the
+			//   other attributes of our DIE, so read them first.
+			// </summary>
+			void read_base_attributes (DwarfBinaryReader reader)
+			{
+				AbbrevEntry abbrev = this [reader.ReadLeb128 ()];
+
+				foreach (AttributeEntry entry in abbrev.Attributes) {
+					long value = ReadFormValue (reader, entry.DwarfForm);
+
+					switch (entry.DwarfAttribute) {
+					case DwarfAttribute.str_offsets_base:
+						str_offsets_base = value;
+						break;
+
+					case DwarfAttribute.addr_base:
+					case DwarfAttribute.GNU_addr_base:
+						addr_base = value;
+						break;
+
+					case DwarfAttribute.rnglists_base:
+						rnglists_base = value;
+						break;
+
+					case DwarfAttribute.loclists_base:
+						loclists_base = value;
+						break;
+
+					case DwarfAttribute.GNU_ranges_base:
+						gnu_ranges_base = value;
+						break;
+
+					case DwarfAttribute.GNU_dwo_id:
+						dwo_id = value;
+						break;
+
+					case DwarfAttribute.dwo_name:
+					case DwarfAttribute.GNU_dwo_name:
+						has_dwo_name = true;
+						break;
+					}
+				}
+			}
+
+			public DwarfReader DwarfReader {
+				get {
+					return dwarf;
+				}
+			}
+
+			// <summary>
+			//   The DIE describing the compile unit; for split units, this is
+			//   the skeleton unit's DIE, which has the addresses and the line
+			//   number program.
+			// </summary>
+			public DieCompileUnit DieCompileUnit {
+				get {
+					if (skeleton != null)
+						return skeleton.DieCompileUnit;
+					return comp_unit_die;
+				}
+			}
+
+			// <summary>
+			//   The DIE at the start of this unit.
+			// </summary>
+			public DieCompileUnit UnitDie {
+				get {
+					return comp_unit_die;
+				}
+			}
+
+			public ISymbolTable SymbolTable {
+				get {
+					return DieCompileUnit.SymbolTable;
+				}
+			}
+
+			internal long RealStartOffset {
+				get {
+					return real_start_offset;
+				}
+			}
+
+			internal long UnitLength {
+				get {
+					return unit_length;
+				}
+			}
+
+			internal int Version {
+				get {
+					return version;
+				}
+			}
+
+			internal long OffsetBias {
+				get {
+					return offset_bias;
+				}
+			}
+
+			internal long DwoId {
+				get {
+					return dwo_id;
+				}
+			}
+
+			internal bool IsTypeUnit {
+				get {
+					return header.IsTypeUnit;
+				}
+			}
+
+			internal long TypeSignature {
+				get {
+					return header.TypeSignature;
+				}
+			}
+
+			internal bool IsSkeleton {
+				get {
+					if (split_file != null)
+						return false;
+
+					return (header.UnitType == DwarfUnitType.skeleton) || has_dwo_name;
+				}
+			}
+
+			internal bool IsSplitUnit {
+				get {
+					return split_file != null;
+				}
+			}
+
+			// <summary>
+			//   The split unit of a skeleton unit; we load it from the .dwo
+			//   or .dwp file the first time somebody asks for it.  Returns
+			//   null if we can't find it, or if we aren't a skeleton unit.
+			// </summary>
+			internal CompilationUnit SplitUnit {
+				get {
+					if (!IsSkeleton)
+						return null;
+
+					lock (this) {
+						if (!split_unit_loaded) {
+							split_unit = dwarf.load_split_unit (this);
+							split_unit_loaded = true;
+						}
+
+						return split_unit;
+					}
+				}
+			}
+
+			internal bool Contains (long offset)
+			{
+				return (offset >= real_start_offset) && (offset < start_offset + unit_length);
+			}
+
+			// <summary>
+			//   Whether the unit-relative reference `offset' points into
+			//   this unit.
+			// </summary>
+			internal bool IsLocalReference (long offset)
+			{
+				return Contains (real_start_offset + offset);
+			}
+
+			// <summary>
+			//   Read all our DIE's, so we know all our types.
+			// </summary>
+			internal void ReadChildren ()
+			{
+				lock (this) {
+					if (children_read)
+						return;
+
+					children_read = true;
+					comp_unit_die.ReadChildren ();
+				}
+
+				ResolveDeferredTypes ();
+			}
+
+			internal void AddDeferredType (DieType type)
+			{
+				lock (this) {
+					if (deferred_types == null)
+						deferred_types = new ArrayList ();
+					deferred_types.Add (type);
+				}
+			}
+
+			// <summary>
+			//   Resolve the references of our types into other units.
+			// </summary>
+			// <remarks>
+			//   This must not be called while reading our DIE's: resolving
+			//   such a reference reads the other unit, and its DIE's may
+			//   refer back to us.
+			// </remarks>
+			// <remarks>
+			//   When this returns, all our types are resolved - unless
+			//   we're called while resolving a reference from another unit
+			//   which refers back to us.  Then we must not wait for the
+			//   other thread since it may be waiting for us.
+			// </remarks>
+			internal void ResolveDeferredTypes ()
+			{
+				ArrayList list;
+				lock (this) {
+					list = deferred_types;
+					deferred_types = null;
+
+					if (list != null)
+						resolving++;
+					else if (resolve_depth == 0) {
+						while (resolving > 0)
+							ST.Monitor.Wait (this);
+					}
+				}
+
+				if (list != null) {
+					resolve_depth++;
+					try {
+						foreach (DieType type in list)
+							type.ResolveSpecification ();
+					} finally {
+						resolve_depth--;
+						lock (this) {
+							resolving--;
+							ST.Monitor.PulseAll (this);
+						}
+					}
+				}
+
+				// A skeleton unit's DIE's live in its split unit.
+				if (split_unit_loaded && (split_unit != null))
+					split_unit.ResolveDeferredTypes ();
+			}
+
+			// <summary>
+			//   Whether the current thread is resolving references into
+			//   another unit.
+			// </summary>
+			internal static bool IsResolving {
+				get { return resolve_depth > 0; }
+			}
+
+			internal string CurrentNamespace {
+				get; set;
+			}
+
+			//
+			// The sections our DIE's refer to; split units keep most of them
+			// in the .dwo file, but their addresses are in the executable.
+			//
+
+			public DwarfBinaryReader DebugInfoReader {
+				get {
+					if (split_file != null)
+						return split_file.DebugInfoReader;
+					return dwarf.DebugInfoReader;
+				}
+			}
+
+			public DwarfBinaryReader DebugAbbrevReader {
+				get {
+					if (split_file != null)
+						return split_file.DebugAbbrevReader;
+					return dwarf.DebugAbbrevReader;
+				}
+			}
+
+			public DwarfBinaryReader DebugStrReader {
+				get {
+					if (split_file != null)
+						return split_file.DebugStrReader;
+					return dwarf.DebugStrReader;
+				}
+			}
+
+			public DwarfBinaryReader DebugStrOffsetsReader {
+				get {
+					if (split_file != null)
+						return split_file.DebugStrOffsetsReader;
+					return dwarf.DebugStrOffsetsReader;
+				}
+			}
+
+			public DwarfBinaryReader DebugLocListsReader {
+				get {
+					if (split_file != null)
+						return split_file.DebugLocListsReader;
+					return dwarf.DebugLocListsReader;
+				}
+			}
+
+			public DwarfBinaryReader DebugRngListsReader {
+				get {
+					if (split_file != null)
+						return split_file.DebugRngListsReader;
+					return dwarf.DebugRngListsReader;
+				}
+			}
+
+			// <summary>
+			//   Read an attribute value of the given form as an integer.
+			// </summary>
+			public long ReadFormValue (DwarfBinaryReader reader, DwarfForm form)
+			{
+				// DWARF 2 used the address size for DW_FORM_ref_addr.
+				if ((form == DwarfForm.ref_addr) && (version >= 3))
+					form = DwarfForm.sec_offset;
+
+				return dwarf.read_form_value (reader, form, header.Is64Bit);
+			}
+
+			// <summary>
+			//   Read an attribute value of the given form as a string;
+			//   returns null if it isn't a string.
+			// </summary>
+			public string ReadString (DwarfBinaryReader reader, DwarfForm form)
+			{
+				DwarfBinaryReader str_reader;
+
+				switch (form) {
+				case DwarfForm.cstring:
+					return reader.ReadString ();
+
+				case DwarfForm.strp:
+					str_reader = DebugStrReader;
+					break;
+
+				case DwarfForm.line_strp:
+					str_reader = dwarf.DebugLineStrReader;
+					break;
+
+				case DwarfForm.strx:
+				case DwarfForm.strx1:
+				case DwarfForm.strx2:
+				case DwarfForm.strx3:
+				case DwarfForm.strx4:
+				case DwarfForm.GNU_str_index:
+					return GetIndexedString (ReadFormValue (reader, form));
+
+				default:
+					ReadFormValue (reader, form);
+					return null;
+				}
+
+				long offset = ReadFormValue (reader, form);
+				if (str_reader == null)
+					return null;
+
+				return str_reader.PeekString (offset);
+			}
+
+			public string GetIndexedString (long index)
+			{
+				DwarfBinaryReader offsets = DebugStrOffsetsReader;
+				DwarfBinaryReader strings = DebugStrReader;
+				if ((offsets == null) || (strings == null))
+					throw new DwarfException (
+						dwarf.bfd, "Got an indexed string, but '.debug_str' " +
+						"or '.debug_str_offsets' section is missing.");
+
+				int offset_size = header.Is64Bit ? 8 : 4;
+				long offset = offsets.PeekOffset (str_offsets_base + index * offset_size);
+				return strings.PeekString (offset);
+			}
+
+			// <summary>
+			//   Get an (unrelocated) address from .debug_addr.  Split units
+			//   use the skeleton unit's table.
+			// </summary>
+			public long GetIndexedAddress (long index)
+			{
+				DwarfBinaryReader reader = dwarf.DebugAddrReader;
+				if (reader == null)
+					throw new DwarfException (
+						dwarf.bfd, "Got an indexed address, but '.debug_addr' " +
+						"section is missing.");
+
+				long table = (skeleton != null) ? skeleton.addr_base : addr_base;
+				return reader.PeekAddress (table + index * address_size);
+			}
+
+			//
+			// DW_FORM_rnglistx and DW_FORM_loclistx are indices into the
+			// offset table at the start of the list table.
+			//
+			long get_list_offset (DwarfBinaryReader reader, long table, long index)
+			{
+				int offset_size = header.Is64Bit ? 8 : 4;
+				return table + reader.PeekOffset (table + index * offset_size);
+			}
+
+			// <summary>
+			//   The offset of a DW_AT_ranges list in .debug_rnglists, or in
+			//   .debug_ranges before DWARF 5.
+			// </summary>
+			public long GetRangeListOffset (Attribute attribute)
+			{
+				long value = (long) attribute.Data;
+				if (attribute.DwarfForm == DwarfForm.rnglistx)
+					return get_list_offset (DebugRngListsReader, rnglists_base, value);
+
+				// GNU split units keep their ranges in the executable.
+				if ((skeleton != null) && (version < 5))
+					return skeleton.gnu_ranges_base + value;
+
+				return value;
+			}
+
+			// <summary>
+			//   The offset of a location list in .debug_loclists, or in
+			//   .debug_loc before DWARF 5.
+			// </summary>
+			public long GetLocationListOffset (Attribute attribute)
+			{
+				long value = (long) attribute.Data;
+				if (attribute.DwarfForm == DwarfForm.loclistx)
+					return get_list_offset (DebugLocListsReader, loclists_base, value);
+
+				return value;
+			}
+
+			// <summary>
+			//   Resolve a DW_FORM_ref_sig8 reference.  Like DW_FORM_ref_addr,
+			//   we return an offset relative to our own unit, which
+			//   GetType() knows to be in another unit.
+			// </summary>
+			public long GetTypeUnitReference (long signature)
+			{
+				CompilationUnit unit;
+				if (split_file != null)
+					unit = split_file.GetTypeUnit (signature, skeleton);
+				else
+					unit = dwarf.get_type_unit (signature);
+
+				if (unit == null) {
+					debug ("{0}: unknown type signature {1:x}", this, signature);
+					return 0;
+				}
+
+				return unit.real_start_offset + unit.header.TypeOffset - real_start_offset;
+			}
+
+			public AbbrevEntry this [int abbrev_id] {
+				get {
+					AbbrevEntry entry = abbrevs [abbrev_id];
+					if (entry != null)
+						return entry;
+
+					throw new DwarfException (
+						dwarf.bfd, "{0} does not contain an " +
+						"abbreviation entry {1}", this, abbrev_id);
+				}
+			}
+
+			public void AddType (long offset, DieType type)
+			{
+				types.Add (offset, type);
+			}
+
+			public void AddSubprogram (long offset, DieSubprogram subprog)
+			{
+				subprogs.Add (offset, subprog);
+			}
+
+			public void AddNamespace (long offset, DieNamespace ns)
+			{
+				namespaces.Add (offset, ns);
+			}
+
+			public DieType GetType (long offset)
+			{
+				long absolute = real_start_offset + offset;
+				if (Contains (absolute))
+					return (DieType) types [absolute];
+
+				CompilationUnit unit;
+				if (split_file != null) {
+					unit = split_file.GetUnit (absolute);
+					if (unit != null)
+						unit.ReadChildren ();
+				} else
+					unit = dwarf.get_compilation_unit (absolute);
+
+				if (unit == null)
+					return null;
+
+				return unit.GetType (absolute - unit.real_start_offset);
+			}
+
+			public DieSubprogram GetSubprogram (long offset)
+			{
+				return (DieSubprogram) subprogs [real_start_offset + offset];
+			}
+
+			public DieNamespace GetNamespace (long offset)
+			{
+				return namespaces [real_start_offset + offset];
+			}
+
+			// <summary>
+			//   Add all functions and types to `builder' without creating
+			//   any Die's.  We only look at the DIE's which we'd add to the
+			//   symbol table or to the NativeLanguage's types: functions at
+			//   the top-level and types outside of any function or type,
+			//   qualified with their namespace.
+			// </summary>
+			public void IndexNames (NameTableBuilder builder)
+			{
+				if (!IsSkeleton) {
+					index_names (builder, real_start_offset, false);
+					return;
+				}
+
+				//
+				// The DIE's of a skeleton unit are in its split unit, whose
+				// offsets are relative to the .dwo file; we only record the
+				// compile unit and let it look up the name itself.
+				//
+				CompilationUnit split = SplitUnit;
+				if (split != null)
+					split.index_names (builder, real_start_offset, true);
+			}
+
+			// <summary>
+			//   Read the DieTable of this unit.
+			// </summary>
+			public DieTable ReadDieTable ()
+			{
+				DieTable table = new DieTable ();
+				if (!comp_unit_die.abbrev.HasChildren)
+					return table;
+
+				DwarfBinaryReader reader = DebugInfoReader;
+				reader.Position = comp_unit_die.ChildrenOffset;
+				long end = start_offset + unit_length;
+
+				//
+				// `parent' is the DIE whose children we're reading and
+				// `previous' the last one of them we read; `levels' has
+				// the parents of the enclosing levels.
+				//
+				Stack<int> levels = new Stack<int> ();
+				int parent = -1, previous = -1;
+
+				while (reader.Position < end) {
+					long offset = reader.Position - real_start_offset;
+					int abbrev_id = reader.ReadLeb128 ();
+					if (abbrev_id == 0) {
+						if (levels.Count == 0)
+							break;
+
+						previous = parent;
+						parent = levels.Pop ();
+						continue;
+					}
+
+					AbbrevEntry abbrev = this [abbrev_id];
+					int index = table.Add (offset, abbrev.Tag, parent);
+					if (previous >= 0)
+						table.SetSibling (previous, index);
+
+					foreach (AttributeEntry entry in abbrev.Attributes)
+						ReadFormValue (reader, entry.DwarfForm);
+
+					if (abbrev.HasChildren) {
+						levels.Push (parent);
+						parent = index;
+						previous = -1;
+					} else
+						previous = index;
+				}
 
-				subprog.dwarf.method_hash.Add (source.Handle, this);
+				return table;
 			}
 
-			public bool CheckLoaded ()
+			void index_names (NameTableBuilder builder, long file_offset, bool unit_only)
 			{
-				if (!subprog.dwarf.bfd.IsLoaded)
-					return false;
+				DieTable table = ReadDieTable ();
+				DwarfBinaryReader reader = DebugInfoReader;
 
-				ISymbolContainer sc = (ISymbolContainer) subprog;
-				if (sc.IsContinuous)
-					SetAddresses (sc.StartAddress, sc.EndAddress);
+				//
+				// The namespace of the children of each DIE, or null if
+				// we're not interested in them.
+				//
+				string[] scopes = new string [table.Count];
 
-				SetLineNumbers (engine);
+				for (int i = 0; i < table.Count; i++) {
+					DieTable.Entry die = table [i];
+					string scope = (die.Parent < 0) ? "" : scopes [die.Parent];
+					if (scope == null)
+						continue;
 
-				read_line_numbers ();
+					bool is_namespace = die.Tag == DwarfTag.dwarf3_namespace;
+					bool is_function = (die.Tag == DwarfTag.subprogram) && (die.Parent < 0);
+					if (!is_namespace && !is_function && !is_type_tag (die.Tag))
+						continue;
 
-				return true;
+					reader.Position = real_start_offset + die.Offset;
+					AbbrevEntry abbrev = this [reader.ReadLeb128 ()];
+
+					string name = null;
+					bool has_pc = false;
+					foreach (AttributeEntry entry in abbrev.Attributes) {
+						if (entry.DwarfAttribute == DwarfAttribute.name) {
+							name = ReadString (reader, entry.DwarfForm);
+							continue;
+						}
+
+						if (entry.DwarfAttribute == DwarfAttribute.low_pc)
+							has_pc = true;
+						ReadFormValue (reader, entry.DwarfForm);
+					}
+
+					string full_name = null;
+					if (name != null)
+						full_name = (scope != "") ? scope + "::" + name : name;
+
+					if (is_namespace) {
+						// Like DieNamespace, anonymous namespaces reset it.
+						scopes [i] = (name != null) ? full_name : "";
+						continue;
+					}
+
+					if (name == null)
+						continue;
+
+					long offset = unit_only ? -1 : die.Offset;
+					if (is_function) {
+						if (has_pc)
+							builder.Add (name, file_offset, offset, NameKind.Function);
+					} else
+						builder.Add (full_name, file_offset, offset, NameKind.Type);
+				}
 			}
 
-			internal override MethodSource GetTrampoline (TargetMemoryAccess memory,
-								      TargetAddress address)
+			public override string ToString ()
 			{
-				return null;
+				return String.Format ("CompilationUnit ({0},{1},{2} - {3},{4},{5})",
+						      dwarf.Is64Bit ? "64-bit" : "32-bit", version,
+						      address_size, real_start_offset,
+						      unit_length, abbrev_offset);
 			}
 		}
 
-		protected class CompilationUnit
+		// <summary>
+		//   A .dwo or .dwp file with the split DWARF of some of our skeleton
+		//   units.  A .dwp file contains the .dwo files of several compile
+		//   units; its .debug_cu_index and .debug_tu_index tell us where
+		//   each unit's contributions to the sections are.
+		// </summary>
+		protected class DwarfSplitFile
 		{
+			public const int DW_SECT_INFO		= 1;
+			public const int DW_SECT_ABBREV		= 3;
+			public const int DW_SECT_LOCLISTS	= 5;
+			public const int DW_SECT_STR_OFFSETS	= 6;
+			public const int DW_SECT_RNGLISTS	= 8;
+			public const int DW_SECT_MAX		= 9;
+
+			static readonly string[] section_names = {
+				".debug_info.dwo", ".debug_abbrev.dwo", ".debug_str.dwo",
+				".debug_str_offsets.dwo", ".debug_loclists.dwo",
+				".debug_rnglists.dwo", ".debug_cu_index", ".debug_tu_index"
+			};
+
 			DwarfReader dwarf;
-			long real_start_offset, start_offset, unit_length, abbrev_offset;
-			int version, address_size;
-			DieCompileUnit comp_unit_die;
-			Hashtable abbrevs;
-			Hashtable types;
-			Hashtable subprogs;
-			Dictionary<long,DieNamespace> namespaces;
+			string filename;
+			TargetBlob info_blob, abbrev_blob, str_blob, str_offsets_blob;
+			TargetBlob loclists_blob, rnglists_blob;
+			UnitIndex cu_index, tu_index;
+			Hashtable units = new Hashtable ();
+			Hashtable abbrev_tables = new Hashtable ();
 
-			public CompilationUnit (DwarfReader dwarf, DwarfBinaryReader reader)
+			protected DwarfSplitFile (DwarfReader dwarf, string filename, TargetBlob[] blobs)
 			{
 				this.dwarf = dwarf;
+				this.filename = filename;
 
-				real_start_offset = reader.Position;
-				unit_length = reader.ReadInitialLength ();
-				start_offset = reader.Position;
-				version = reader.ReadInt16 ();
-				abbrev_offset = reader.ReadOffset ();
-				address_size = reader.ReadByte ();
+				info_blob = blobs [0];
+				abbrev_blob = blobs [1];
+				str_blob = blobs [2];
+				str_offsets_blob = blobs [3];
+				loclists_blob = blobs [4];
+				rnglists_blob = blobs [5];
 
-				if (version < 2)
-					throw new DwarfException (
-						dwarf.bfd, "Wrong DWARF version: {0}",
-						version);
+				if (blobs [6] != null)
+					cu_index = new UnitIndex (get_reader (blobs [6]));
+				if (blobs [7] != null)
+					tu_index = new UnitIndex (get_reader (blobs [7]));
+			}
 
-				abbrevs = new Hashtable ();
-				types = new Hashtable ();
-				subprogs = new Hashtable ();
-				namespaces = new Dictionary<long,DieNamespace> ();
+			// <summary>
+			//   Returns null if `filename' doesn't exist or doesn't contain
+			//   any split DWARF.
+			// </summary>
+			public static DwarfSplitFile Open (DwarfReader dwarf, string filename)
+			{
+				if (!File.Exists (filename))
+					return null;
 
-				DwarfBinaryReader abbrev_reader = dwarf.DebugAbbrevReader;
+				try {
+					TargetBlob[] blobs = Bfd.GetSectionBlobs (
+						filename, dwarf.TargetMemoryInfo, section_names);
+					if ((blobs == null) || (blobs [0] == null) || (blobs [1] == null))
+						return null;
 
-				abbrev_reader.Position = abbrev_offset;
-				while (abbrev_reader.PeekByte () != 0) {
-					AbbrevEntry entry = new AbbrevEntry (dwarf, abbrev_reader);
-					abbrevs.Add (entry.ID, entry);
+					return new DwarfSplitFile (dwarf, filename, blobs);
+				} catch (Exception ex) {
+					Report.Debug (DebugFlags.DwarfReader,
+						      "Can't read split DWARF file {0}: {1}",
+						      filename, ex.Message);
+					return null;
 				}
-
-				comp_unit_die = Die.CreateDieCompileUnit (reader, this);
-
-				reader.Position = start_offset + unit_length;
 			}
 
-			public DwarfReader DwarfReader {
-				get {
-					return dwarf;
-				}
+			public string FileName {
+				get { return filename; }
 			}
 
-			public DieCompileUnit DieCompileUnit {
-				get {
-					return comp_unit_die;
-				}
+			DwarfBinaryReader get_reader (TargetBlob blob)
+			{
+				if (blob == null)
+					return null;
+
+				return new DwarfBinaryReader (dwarf.bfd, blob, dwarf.Is64Bit);
 			}
 
-			public ISymbolTable SymbolTable {
-				get {
-					return DieCompileUnit.SymbolTable;
-				}
+			public DwarfBinaryReader DebugInfoReader {
+				get { return get_reader (info_blob); }
 			}
 
-			internal long RealStartOffset {
-				get {
-					return real_start_offset;
-				}
+			public DwarfBinaryReader DebugAbbrevReader {
+				get { return get_reader (abbrev_blob); }
 			}
 
-			internal long UnitLength {
-				get {
-					return unit_length;
-				}
+			public DwarfBinaryReader DebugStrReader {
+				get { return get_reader (str_blob); }
 			}
 
-			internal string CurrentNamespace {
-				get; set;
+			public DwarfBinaryReader DebugStrOffsetsReader {
+				get { return get_reader (str_offsets_blob); }
 			}
 
-			public AbbrevEntry this [int abbrev_id] {
-				get {
-					if (abbrevs.Contains (abbrev_id))
-						return (AbbrevEntry) abbrevs [abbrev_id];
+			public DwarfBinaryReader DebugLocListsReader {
+				get { return get_reader (loclists_blob); }
+			}
 
-					throw new DwarfException (
-						dwarf.bfd, "{0} does not contain an " +
-						"abbreviation entry {1}", this, abbrev_id);
-				}
+			public DwarfBinaryReader DebugRngListsReader {
+				get { return get_reader (rnglists_blob); }
 			}
 
-			public void AddType (long offset, DieType type)
+			public AbbrevTable GetAbbrevTable (long offset)
 			{
-				types.Add (offset, type);
+				return AbbrevTable.Get (abbrev_tables, DebugAbbrevReader, offset);
 			}
 
-			public void AddSubprogram (long offset, DieSubprogram subprog)
+			// <summary>
+			//   Get the split unit of `skeleton'; returns null if it's not
+			//   in this file.
+			// </summary>
+			public CompilationUnit GetCompileUnit (CompilationUnit skeleton)
 			{
-				subprogs.Add (offset, subprog);
+				if (cu_index == null)
+					return find_unit (skeleton.DwoId, false, skeleton);
+
+				long[] offsets = cu_index.Lookup (skeleton.DwoId);
+				if (offsets == null)
+					return null;
+
+				return read_unit (offsets [DW_SECT_INFO], offsets, skeleton);
 			}
 
-			public void AddNamespace (long offset, DieNamespace ns)
+			// <summary>
+			//   Get the type unit with signature `signature'.  We don't read
+			//   the DWARF 4 .debug_types.dwo section, so this only finds
+			//   DWARF 5 type units.
+			// </summary>
+			public CompilationUnit GetTypeUnit (long signature, CompilationUnit skeleton)
 			{
-				namespaces.Add (offset, ns);
+				if (tu_index == null)
+					return find_unit (signature, true, skeleton);
+
+				if (tu_index.Version < 5)
+					return null;
+
+				long[] offsets = tu_index.Lookup (signature);
+				if (offsets == null)
+					return null;
+
+				return read_unit (offsets [DW_SECT_INFO], offsets, skeleton);
 			}
 
-			public DieType GetType (long offset)
+			// <summary>
+			//   Get the unit containing `offset', which must be one we
+			//   already read.
+			// </summary>
+			public CompilationUnit GetUnit (long offset)
 			{
-				return (DieType) types [real_start_offset + offset];
+				lock (this) {
+					foreach (CompilationUnit unit in units.Values) {
+						if (unit.Contains (offset))
+							return unit;
+					}
+				}
+
+				return null;
 			}
 
-			public DieSubprogram GetSubprogram (long offset)
+			//
+			// A plain .dwo file has no index, but only contains the units
+			// of one compile unit.  Before DWARF 5, the dwo id is an
+			// attribute of the unit's DIE, so we just take the first one.
+			//
+			CompilationUnit find_unit (long id, bool type_unit, CompilationUnit skeleton)
 			{
-				return (DieSubprogram) subprogs [real_start_offset + offset];
+				DwarfBinaryReader reader = DebugInfoReader;
+
+				while (!reader.IsEof) {
+					long offset = reader.Position;
+					UnitHeader header = new UnitHeader (dwarf.bfd, reader);
+					reader.Position = header.EndOffset;
+
+					bool found;
+					if (type_unit)
+						found = header.IsTypeUnit && (header.TypeSignature == id);
+					else
+						found = !header.IsTypeUnit &&
+							((header.Version < 5) || (header.DwoId == id));
+
+					if (found)
+						return read_unit (offset, null, skeleton);
+				}
+
+				return null;
 			}
 
-			public DieNamespace GetNamespace (long offset)
+			CompilationUnit read_unit (long offset, long[] section_offsets,
+						   CompilationUnit skeleton)
 			{
-				return namespaces [real_start_offset + offset];
+				lock (this) {
+					CompilationUnit unit = (CompilationUnit) units [offset];
+					if (unit != null)
+						return unit;
+
+					DwarfBinaryReader reader = DebugInfoReader;
+					reader.Position = offset;
+					unit = new CompilationUnit (
+						dwarf, this, section_offsets, skeleton, reader);
+					units.Add (offset, unit);
+					return unit;
+				}
 			}
 
 			public override string ToString ()
 			{
-				return String.Format ("CompilationUnit ({0},{1},{2} - {3},{4},{5})",
-						      dwarf.Is64Bit ? "64-bit" : "32-bit", version,
-						      address_size, real_start_offset,
-						      unit_length, abbrev_offset);
+				return String.Format ("DwarfSplitFile ({0})", filename);
+			}
+
+			// <summary>
+			//   A .debug_cu_index or .debug_tu_index section: a hash table
+			//   which maps unit ids to each unit's offsets in the sections.
+			// </summary>
+			protected class UnitIndex
+			{
+				public readonly int Version;
+
+				DwarfBinaryReader reader;
+				int section_count, unit_count, slot_count;
+				long hash_offset, index_offset, offsets_offset;
+				int[] section_ids;
+
+				public UnitIndex (DwarfBinaryReader reader)
+				{
+					this.reader = reader;
+
+					// DWARF 5 has a 2-byte version and 2 bytes of padding.
+					Version = reader.ReadInt32 () & 0xffff;
+					section_count = reader.ReadInt32 ();
+					unit_count = reader.ReadInt32 ();
+					slot_count = reader.ReadInt32 ();
+
+					hash_offset = reader.Position;
+					index_offset = hash_offset + 8 * (long) slot_count;
+
+					long row = index_offset + 4 * (long) slot_count;
+					section_ids = new int [section_count];
+					for (int i = 0; i < section_count; i++)
+						section_ids [i] = reader.PeekInt32 (row + 4 * i);
+					offsets_offset = row + 4 * (long) section_count;
+				}
+
+				// <summary>
+				//   Returns the unit's offset in each section, indexed by
+				//   DW_SECT_*, or null if it's not in the index.
+				// </summary>
+				public long[] Lookup (long id)
+				{
+					if (slot_count == 0)
+						return null;
+
+					long mask = slot_count - 1;
+					long slot = id & mask;
+					long step = ((id >> 32) & mask) | 1;
+
+					for (int i = 0; i < slot_count; i++) {
+						int row = reader.PeekInt32 (index_offset + 4 * slot);
+						if (row == 0)
+							return null;
+
+						if (reader.PeekInt64 (hash_offset + 8 * slot) == id)
+							return read_row (row);
+
+						slot = (slot + step) & mask;
+					}
+
+					return null;
+				}
+
+				long[] read_row (int row)
+				{
+					if ((row < 1) || (row > unit_count))
+						return null;
+
+					long[] offsets = new long [DW_SECT_MAX];
+					long pos = offsets_offset + 4 * (long) (row - 1) * section_count;
+					for (int i = 0; i < section_count; i++) {
+						int id = section_ids [i];
+						if ((id > 0) && (id < DW_SECT_MAX))
+							offsets [id] = (uint) reader.PeekInt32 (pos + 4 * i);
+					}
+					return offsets;
+				}
 			}
 		}
 
@@ -2884,6 +5611,8 @@ namespace Mono.Debugger.Backend
 			DwarfLocation frame_base;
 			byte[] location_block;
 			long loclist_offset;
+			long member_offset;
+			bool is_constant;
 			bool is_byref;
 
 			public DwarfLocation (DieSubprogram subprog, Attribute attribute, bool is_byref)
@@ -2902,13 +5631,35 @@ namespace Mono.Debugger.Backend
 
 				switch (attribute.DwarfForm) {
 				case DwarfForm.block1:
+				case DwarfForm.block2:
+				case DwarfForm.block4:
+				case DwarfForm.block:
+				case DwarfForm.exprloc:
 					location_block = (byte []) attribute.Data;
 					break;
-				case DwarfForm.data1:
-				case DwarfForm.data2:
 				case DwarfForm.data4:
 				case DwarfForm.data8:
-					loclist_offset = (long) attribute.Data;
+					//
+					// Before DWARF 4, these were also used for location
+					// list offsets; DW_FORM_sec_offset replaced them.
+					//
+					if (comp_unit.Version < 4) {
+						loclist_offset = (long) attribute.Data;
+						break;
+					}
+					goto case DwarfForm.data1;
+				case DwarfForm.data1:
+				case DwarfForm.data2:
+				case DwarfForm.udata:
+				case DwarfForm.sdata:
+				case DwarfForm.implicit_const:
+					// A DW_AT_data_member_location which is just a constant.
+					member_offset = (long) attribute.Data;
+					is_constant = true;
+					break;
+				case DwarfForm.sec_offset:
+				case DwarfForm.loclistx:
+					loclist_offset = comp_unit.GetLocationListOffset (attribute);
 					break;
 				default:
 					throw new InternalError  ();
@@ -2955,9 +5706,15 @@ namespace Mono.Debugger.Backend
 					reg = locreader.ReadLeb128 () + 3;
 					off = locreader.ReadSLeb128 ();
 					is_regoffset = true;
-				} else if (opcode == 0x03) { // DW_OP_addr
-					TargetAddress addr = new TargetAddress (
-						memory.AddressDomain, locreader.ReadAddress ());
+				} else if ((opcode == 0x03) || (opcode == 0xa1) || (opcode == 0xfb)) {
+					// DW_OP_addr, DW_OP_addrx or DW_OP_GNU_addr_index
+					long value;
+					if (opcode == 0x03)
+						value = locreader.ReadAddress ();
+					else
+						value = comp_unit.GetIndexedAddress (locreader.ReadLeb128 ());
+
+					TargetAddress addr = new TargetAddress (memory.AddressDomain, value);
 					TargetLocation aloc = new AbsoluteTargetLocation (addr);
 					if (is_byref)
 						return new DereferencedTargetLocation (aloc);
@@ -2986,8 +5743,19 @@ namespace Mono.Debugger.Backend
 			{
 				if (location_block != null)
 					return GetLocation (frame, memory, location_block);
+				if (is_constant)
+					return null;
+
+				if (comp_unit.Version >= 5)
+					return read_location_list (frame, memory);
+
+				// GCC's pre-standard .debug_loc.dwo format isn't supported.
+				if (comp_unit.IsSplitUnit)
+					return null;
 
 				DwarfBinaryReader reader = comp_unit.DwarfReader.DebugLocationReader;
+				if (reader == null)
+					return null;
 				reader.Position = loclist_offset;
 
 				TargetAddress address = frame.TargetAddress;
@@ -3019,8 +5787,92 @@ namespace Mono.Debugger.Backend
 				return null;
 			}
 
+			// <summary>
+			//   Find the entry in a DWARF 5 location list which covers the
+			//   current address.
+			// </summary>
+			TargetLocation read_location_list (StackFrame frame, TargetMemoryAccess memory)
+			{
+				DwarfBinaryReader reader = comp_unit.DebugLocListsReader;
+				if (reader == null)
+					return null;
+				reader.Position = loclist_offset;
+
+				DwarfReader dwarf = comp_unit.DwarfReader;
+				TargetAddress address = frame.TargetAddress;
+				TargetAddress base_address = comp_unit.DieCompileUnit.BaseAddress;
+				byte[] default_location = null;
+
+				while (true) {
+					DwarfLocationListEntry kind = (DwarfLocationListEntry) reader.ReadByte ();
+					TargetAddress start, end;
+
+					switch (kind) {
+					case DwarfLocationListEntry.end_of_list:
+						if (default_location == null)
+							return null;
+						return GetLocation (frame, memory, default_location);
+
+					case DwarfLocationListEntry.base_addressx:
+						base_address = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						continue;
+
+					case DwarfLocationListEntry.base_address:
+						base_address = dwarf.GetAddress (reader.ReadAddress ());
+						continue;
+
+					case DwarfLocationListEntry.startx_endx:
+						start = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						end = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						break;
+
+					case DwarfLocationListEntry.startx_length:
+						start = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						end = start + reader.ReadLeb128 ();
+						break;
+
+					case DwarfLocationListEntry.offset_pair:
+						start = base_address + reader.ReadLeb128 ();
+						end = base_address + reader.ReadLeb128 ();
+						break;
+
+					case DwarfLocationListEntry.default_location:
+						default_location = reader.ReadBuffer (reader.ReadLeb128 ());
+						continue;
+
+					case DwarfLocationListEntry.start_end:
+						start = dwarf.GetAddress (reader.ReadAddress ());
+						end = dwarf.GetAddress (reader.ReadAddress ());
+						break;
+
+					case DwarfLocationListEntry.start_length:
+						start = dwarf.GetAddress (reader.ReadAddress ());
+						end = start + reader.ReadLeb128 ();
+						break;
+
+					default:
+						throw new DwarfException (
+							dwarf.bfd, "Unknown location list entry {0}", kind);
+					}
+
+					int size = reader.ReadLeb128 ();
+					byte[] data = reader.ReadBuffer (size);
+
+					if ((address < start) || (address >= end))
+						continue;
+
+					return GetLocation (frame, memory, data);
+				}
+			}
+
 			public TargetLocation GetLocation (TargetLocation location)
 			{
+				if (is_constant)
+					return new RelativeTargetLocation (location, member_offset);
 				if (location_block == null)
 					throw new NotImplementedException ();
 
@@ -3193,6 +6045,8 @@ namespace Mono.Debugger.Backend
 			string name;
 			protected long offset;
 			DieType specification;
+			long deferred_specification;
+			string deferred_namespace;
 			bool resolved, type_created;
 			protected readonly Language language;
 			TargetType type;
@@ -3214,6 +6068,9 @@ namespace Mono.Debugger.Backend
 					if (comp_unit.CurrentNamespace != null)
 						name = comp_unit.CurrentNamespace + "::" + name;
 					comp_unit.DwarfReader.AddType (this);
+				} else if (deferred_specification != 0) {
+					deferred_namespace = comp_unit.CurrentNamespace;
+					comp_unit.AddDeferredType (this);
 				}
 			}
 
@@ -3224,11 +6081,34 @@ namespace Mono.Debugger.Backend
 					name = (string) attribute.Data;
 					break;
 				case DwarfAttribute.specification:
-					specification = comp_unit.GetType ((long) attribute.Data);
+					//
+					// Don't read another unit while we're reading this
+					// one; see CompilationUnit.ResolveDeferredTypes().
+					//
+					long spec_offset = (long) attribute.Data;
+					if (comp_unit.IsLocalReference (spec_offset))
+						specification = comp_unit.GetType (spec_offset);
+					else
+						deferred_specification = spec_offset;
 					break;
 				}
 			}
 
+			// <summary>
+			//   Get our name from a DW_AT_specification in another unit.
+			// </summary>
+			internal void ResolveSpecification ()
+			{
+				specification = comp_unit.GetType (deferred_specification);
+				if ((specification == null) || (specification.name == null))
+					return;
+
+				name = specification.Name;
+				if (deferred_namespace != null)
+					name = deferred_namespace + "::" + name;
+				comp_unit.DwarfReader.AddType (this);
+			}
+
 			protected DieType GetReference (long offset)
 			{
 				return comp_unit.GetType (offset);
@@ -4114,7 +6994,7 @@ namespace Mono.Debugger.Backend
 			{
 				switch (attribute.DwarfAttribute) {
 				case DwarfAttribute.ranges:
-					ranges_offset = (long) attribute.Data;
+					ranges_offset = comp_unit.GetRangeListOffset (attribute);
 					break;
 
 				default:
@@ -4129,7 +7009,12 @@ namespace Mono.Debugger.Backend
 				if (ranges_offset == null)
 					return true;
 
+				if (comp_unit.Version >= 5)
+					return read_range_list (address);
+
 				DwarfBinaryReader reader = comp_unit.DwarfReader.DebugRangesReader;
+				if (reader == null)
+					return true;
 				reader.Position = (long) ranges_offset;
 
 				TargetAddress base_address = comp_unit.DieCompileUnit.BaseAddress;
@@ -4155,6 +7040,74 @@ namespace Mono.Debugger.Backend
 
 				return false;
 			}
+
+			// <summary>
+			//   DWARF 5 range lists in .debug_rnglists.
+			// </summary>
+			bool read_range_list (TargetAddress address)
+			{
+				DwarfBinaryReader reader = comp_unit.DebugRngListsReader;
+				if (reader == null)
+					return true;
+				reader.Position = (long) ranges_offset;
+
+				DwarfReader dwarf = comp_unit.DwarfReader;
+				TargetAddress base_address = comp_unit.DieCompileUnit.BaseAddress;
+
+				while (true) {
+					DwarfRangeListEntry kind = (DwarfRangeListEntry) reader.ReadByte ();
+					TargetAddress start, end;
+
+					switch (kind) {
+					case DwarfRangeListEntry.end_of_list:
+						return false;
+
+					case DwarfRangeListEntry.base_addressx:
+						base_address = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						continue;
+
+					case DwarfRangeListEntry.base_address:
+						base_address = dwarf.GetAddress (reader.ReadAddress ());
+						continue;
+
+					case DwarfRangeListEntry.startx_endx:
+						start = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						end = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						break;
+
+					case DwarfRangeListEntry.startx_length:
+						start = dwarf.GetAddress (
+							comp_unit.GetIndexedAddress (reader.ReadLeb128 ()));
+						end = start + reader.ReadLeb128 ();
+						break;
+
+					case DwarfRangeListEntry.offset_pair:
+						start = base_address + reader.ReadLeb128 ();
+						end = base_address + reader.ReadLeb128 ();
+						break;
+
+					case DwarfRangeListEntry.start_end:
+						start = dwarf.GetAddress (reader.ReadAddress ());
+						end = dwarf.GetAddress (reader.ReadAddress ());
+						break;
+
+					case DwarfRangeListEntry.start_length:
+						start = dwarf.GetAddress (reader.ReadAddress ());
+						end = start + reader.ReadLeb128 ();
+						break;
+
+					default:
+						throw new DwarfException (
+							dwarf.bfd, "Unknown range list entry {0}", kind);
+					}
+
+					if ((address >= start) && (address < end))
+						return true;
+				}
+			}
 		}
 
 		protected abstract class DieVariableBase : Die
@@ -4335,7 +7288,12 @@ namespace Mono.Debugger.Backend
 			{
 				switch (attribute.DwarfAttribute) {
 				case DwarfAttribute.data_member_location:
-					location = (byte []) attribute.Data;
+					// Since DWARF 3, this may be a constant offset.
+					if (attribute.IsConstant) {
+						offset = (int) (long) attribute.Data;
+						has_offset = true;
+					} else
+						location = (byte []) attribute.Data;
 					break;
 
 				case DwarfAttribute.bit_offset:
@@ -4358,6 +7316,7 @@ namespace Mono.Debugger.Backend
 			TargetType type;
 			TargetMemoryInfo target_info;
 			int bit_offset, bit_size;
+			bool has_offset;
 			int offset;
 
 			public bool Resolve (DieStructureType die_struct)
@@ -4403,7 +7362,7 @@ namespace Mono.Debugger.Backend
 				if ((TypeOffset == 0) || (Name == null))
 					return null;
 
-				if ((location == null) && !die_struct.IsUnion)
+				if ((location == null) && !has_offset && !die_struct.IsUnion)
 					return null;
 
 				type_die = comp_unit.GetType (TypeOffset);
@@ -1,5 +1,6 @@
 using System;
 using System.IO;
+using System.Text;
 using System.Collections;
 
 using Mono.Debugger;
@@ -24,6 +25,12 @@ namespace Mono.Debugger.Backend
 				bfd.ReadTypes ();
 		}
 
+		internal override void ReadNativeTypes (string name)
+		{
+			foreach (Bfd bfd in bfd_hash.Values)
+				bfd.ReadTypes (name);
+		}
+
 		public override NativeExecutableReader LookupLibrary (TargetAddress address)
 		{
 			foreach (Bfd bfd in bfd_hash.Values) {
@@ -259,8 +266,17 @@ namespace Mono.Debugger.Backend
 			return false;
 		}
 
+		const int MaxShlibNameLength = 256;
+
 		void do_update_shlib_info (Inferior inferior)
 		{
+			ArrayList addresses = new ArrayList ();
+			ArrayList names = new ArrayList ();
+
+			//
+			// Walk the link map first and then fetch all the library names
+			// with a single vectored read; the first entry is the executable.
+			//
 			bool first = true;
 			TargetAddress map = first_link_map;
 			while (!map.IsNull) {
@@ -271,17 +287,6 @@ namespace Mono.Debugger.Backend
 				TargetAddress l_name = map_reader.ReadAddress ();
 				map_reader.ReadAddress ();
 
-				string name;
-				try {
-					name = inferior.ReadString (l_name);
-					// glibc 2.3.x uses the empty string for the virtual
-					// "linux-gate.so.1".
-					if ((name != null) && (name == ""))
-						name = null;
-				} catch {
-					name = null;
-				}
-
 				map = map_reader.ReadAddress ();
 
 				if (first) {
@@ -289,14 +294,56 @@ namespace Mono.Debugger.Backend
 					continue;
 				}
 
-				if (name == null)
+				if (l_name.IsNull)
+					continue;
+
+				addresses.Add (l_addr);
+				names.Add (l_name);
+			}
+
+			if (names.Count == 0)
+				return;
+
+			TargetAddress[] name_addrs = new TargetAddress [names.Count];
+			int[] sizes = new int [names.Count];
+			for (int i = 0; i < names.Count; i++) {
+				name_addrs [i] = (TargetAddress) names [i];
+
+				// Don't let the window cross a page boundary, the next page
+				// may not be mapped.
+				long page_left = 4096 - (name_addrs [i].Address & 4095);
+				sizes [i] = (int) System.Math.Min (MaxShlibNameLength, page_left);
+			}
+
+			byte[][] buffers = inferior.ReadBuffers (name_addrs, sizes);
+
+			for (int i = 0; i < names.Count; i++) {
+				string name = read_shlib_name (inferior, name_addrs [i], buffers [i]);
+				// glibc 2.3.x uses the empty string for the virtual
+				// "linux-gate.so.1".
+				if ((name == null) || (name == ""))
 					continue;
 
 				if (bfd_hash.Contains (name))
 					continue;
 
 				bool step_into = Process.ProcessStart.LoadNativeSymbolTable;
-				AddExecutableFile (inferior, name, l_addr, step_into, true);
+				AddExecutableFile (inferior, name, (TargetAddress) addresses [i], step_into, true);
+			}
+		}
+
+		static string read_shlib_name (Inferior inferior, TargetAddress address, byte[] buffer)
+		{
+			if (buffer != null) {
+				int pos = Array.IndexOf (buffer, (byte) 0);
+				if (pos >= 0)
+					return Encoding.UTF8.GetString (buffer, 0, pos);
+			}
+
+			try {
+				return inferior.ReadString (address);
+			} catch {
+				return null;
 			}
 		}
 
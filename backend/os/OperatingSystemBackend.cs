@@ -34,6 +34,12 @@ namespace Mono.Debugger.Backend
 
 		internal abstract void ReadNativeTypes ();
 
+		// <summary>
+		//   Like ReadNativeTypes(), but we may only read the types which
+		//   could be called `name'.
+		// </summary>
+		internal abstract void ReadNativeTypes (string name);
+
 #region IDisposable
 
 		//
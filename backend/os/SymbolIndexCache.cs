@@ -0,0 +1,398 @@
+using System;
+using System.IO;
+using System.Text;
+using System.Collections;
+using System.Security.Cryptography;
+
+namespace Mono.Debugger.Backend
+{
+	// <summary>
+	//   The parts of a DwarfReader which we'd otherwise have to recompute
+	//   each time we load a symbol file; all addresses are unrelocated.
+	// </summary>
+	internal class DwarfIndex
+	{
+		// Offsets of all the compile unit blocks in .debug_info.
+		public long[] CompileUnits;
+
+		// .debug_aranges: (compile unit offset, address, size) triples.
+		public long[] ARanges;
+
+		// .debug_pubnames: names and (compile unit offset, die offset) pairs.
+		public string[] PubNames;
+		public long[] PubNameOffsets;
+	}
+
+	// <summary>
+	//   The name index which the DwarfReader builds if there's no
+	//   .debug_names or .gdb_index: a (compile unit offset, die offset,
+	//   kind) triple in `Entries' for each of the `Names'.
+	// </summary>
+	internal class DwarfNameIndex
+	{
+		public string[] Names;
+		public long[] Entries;
+	}
+
+	// <summary>
+	//   A persistent on-disk cache of symbol tables, DWARF indices and name
+	//   indices.
+	//
+	//   Entries are keyed by the ELF build-id, or by the file name if there
+	//   is none, together with the file's size and modification time; each
+	//   entry is a flat binary file
+	//   which is written atomically.  Once the cache grows beyond its size
+	//   limit, we remove the least recently used entries.
+	// </summary>
+	internal class SymbolIndexCache
+	{
+		const int Magic = 0x4942444d;		// "MDBI"
+		const int Version = 1;
+
+		const int KindSymbols = 1;
+		const int KindDwarf = 2;
+		const int KindNames = 3;
+
+		const string Extension = ".idx";
+
+		readonly string directory;
+		readonly long size_limit;
+
+		static Hashtable caches = Hashtable.Synchronized (new Hashtable ());
+
+		protected SymbolIndexCache (string directory, long size_limit)
+		{
+			this.directory = directory;
+			this.size_limit = size_limit;
+		}
+
+		public static SymbolIndexCache GetCache (DebuggerConfiguration config)
+		{
+			if (!config.SymbolIndexCache)
+				return null;
+
+			string directory = config.SymbolIndexCacheDirectory;
+			long size_limit = (long) config.SymbolIndexCacheSize << 20;
+
+			lock (caches.SyncRoot) {
+				SymbolIndexCache cache = (SymbolIndexCache) caches [directory];
+				if ((cache == null) || (cache.size_limit != size_limit)) {
+					cache = new SymbolIndexCache (directory, size_limit);
+					caches [directory] = cache;
+				}
+				return cache;
+			}
+		}
+
+		// <summary>
+		//   Compute the cache key for `filename', whose .note.gnu.build-id
+		//   section contains `build_id_note' (which may be null).
+		// </summary>
+		// <remarks>
+		//   strip and objcopy keep the build-id, so it alone doesn't tell a
+		//   stripped binary from its original; we always add the size and
+		//   modification time.
+		// </remarks>
+		public static string GetKey (string filename, byte[] build_id_note)
+		{
+			FileInfo info = new FileInfo (filename);
+			if (!info.Exists)
+				return null;
+
+			string build_id = parse_build_id (build_id_note);
+
+			string prefix, id;
+			if (build_id != null) {
+				prefix = "b-" + build_id + "-";
+				id = String.Format ("{0}:{1}", info.Length, info.LastWriteTimeUtc.Ticks);
+			} else {
+				prefix = "f-";
+				id = String.Format ("{0}:{1}:{2}", info.FullName, info.Length,
+						    info.LastWriteTimeUtc.Ticks);
+			}
+
+			MD5 md5 = MD5.Create ();
+			return prefix + to_hex (md5.ComputeHash (Encoding.UTF8.GetBytes (id)));
+		}
+
+		static string parse_build_id (byte[] note)
+		{
+			if ((note == null) || (note.Length < 16))
+				return null;
+
+			int namesz = BitConverter.ToInt32 (note, 0);
+			int descsz = BitConverter.ToInt32 (note, 4);
+			int type = BitConverter.ToInt32 (note, 8);
+
+			const int NT_GNU_BUILD_ID = 3;
+			if ((type != NT_GNU_BUILD_ID) || (namesz != 4) || (descsz <= 0))
+				return null;
+
+			int desc_offset = 12 + ((namesz + 3) & ~3);
+			if (desc_offset + descsz > note.Length)
+				return null;
+
+			byte[] desc = new byte [descsz];
+			Array.Copy (note, desc_offset, desc, 0, descsz);
+			return to_hex (desc);
+		}
+
+		static string to_hex (byte[] data)
+		{
+			StringBuilder sb = new StringBuilder (data.Length * 2);
+			foreach (byte b in data)
+				sb.Append (b.ToString ("x2"));
+			return sb.ToString ();
+		}
+
+		string get_filename (string key, int kind)
+		{
+			string suffix;
+			if (kind == KindSymbols)
+				suffix = "-symbols";
+			else if (kind == KindDwarf)
+				suffix = "-dwarf";
+			else
+				suffix = "-names";
+			return Path.Combine (directory, key + suffix + Extension);
+		}
+
+		BinaryReader open_entry (string key, int kind)
+		{
+			string filename = get_filename (key, kind);
+			if (!File.Exists (filename))
+				return null;
+
+			BinaryReader reader = new BinaryReader (
+				new MemoryStream (File.ReadAllBytes (filename)));
+
+			if ((reader.ReadInt32 () != Magic) || (reader.ReadInt32 () != Version) ||
+			    (reader.ReadInt32 () != kind) || (reader.ReadString () != key)) {
+				reader.Close ();
+				return null;
+			}
+
+			// Entries are evicted by last write time, so mark it as used.
+			try {
+				File.SetLastWriteTimeUtc (filename, DateTime.UtcNow);
+			} catch {
+			}
+
+			return reader;
+		}
+
+		void write_entry (string key, int kind, byte[] contents)
+		{
+			Directory.CreateDirectory (directory);
+
+			string filename = get_filename (key, kind);
+			string temp = filename + "." + Guid.NewGuid ().ToString ("N");
+
+			using (FileStream stream = new FileStream (temp, FileMode.CreateNew)) {
+				BinaryWriter writer = new BinaryWriter (stream);
+				writer.Write (Magic);
+				writer.Write (Version);
+				writer.Write (kind);
+				writer.Write (key);
+				writer.Write (contents);
+				writer.Flush ();
+			}
+
+			try {
+				if (File.Exists (filename))
+					File.Delete (filename);
+				File.Move (temp, filename);
+			} catch {
+				// Somebody else was faster.
+				File.Delete (temp);
+			}
+
+			enforce_size_limit ();
+		}
+
+		void enforce_size_limit ()
+		{
+			FileInfo[] files = new DirectoryInfo (directory).GetFiles ("*" + Extension);
+
+			long total = 0;
+			DateTime[] times = new DateTime [files.Length];
+			for (int i = 0; i < files.Length; i++) {
+				total += files [i].Length;
+				times [i] = files [i].LastWriteTimeUtc;
+			}
+
+			if (total <= size_limit)
+				return;
+
+			Array.Sort (times, files);
+
+			foreach (FileInfo file in files) {
+				if (total <= size_limit)
+					break;
+
+				try {
+					long length = file.Length;
+					file.Delete ();
+					total -= length;
+				} catch {
+				}
+			}
+		}
+
+		// <summary>
+		//   Load the symbol table which bfd_glue_export_symbols() created
+		//   for this file; see Bfd.SymbolArena for the format.
+		// </summary>
+		public byte[] LoadSymbols (string key, out int num_symbols)
+		{
+			num_symbols = 0;
+			try {
+				BinaryReader reader = open_entry (key, KindSymbols);
+				if (reader == null)
+					return null;
+
+				using (reader) {
+					num_symbols = reader.ReadInt32 ();
+					int size = reader.ReadInt32 ();
+					byte[] data = reader.ReadBytes (size);
+					if (data.Length != size)
+						return null;
+					return data;
+				}
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "Can't read symbol cache entry {0}: {1}", key, ex.Message);
+				return null;
+			}
+		}
+
+		public void SaveSymbols (string key, int num_symbols, byte[] data)
+		{
+			try {
+				MemoryStream stream = new MemoryStream ();
+				BinaryWriter writer = new BinaryWriter (stream);
+				writer.Write (num_symbols);
+				writer.Write (data.Length);
+				writer.Write (data);
+				writer.Flush ();
+
+				write_entry (key, KindSymbols, stream.ToArray ());
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "Can't write symbol cache entry {0}: {1}", key, ex.Message);
+			}
+		}
+
+		public void RemoveSymbols (string key)
+		{
+			try {
+				File.Delete (get_filename (key, KindSymbols));
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "Can't remove symbol cache entry {0}: {1}", key, ex.Message);
+			}
+		}
+
+		static long[] read_longs (BinaryReader reader)
+		{
+			int count = reader.ReadInt32 ();
+			long[] retval = new long [count];
+			for (int i = 0; i < count; i++)
+				retval [i] = reader.ReadInt64 ();
+			return retval;
+		}
+
+		static void write_longs (BinaryWriter writer, long[] values)
+		{
+			writer.Write (values.Length);
+			foreach (long value in values)
+				writer.Write (value);
+		}
+
+		public DwarfIndex LoadDwarfIndex (string key)
+		{
+			try {
+				BinaryReader reader = open_entry (key, KindDwarf);
+				if (reader == null)
+					return null;
+
+				using (reader) {
+					DwarfIndex index = new DwarfIndex ();
+					index.CompileUnits = read_longs (reader);
+					index.ARanges = read_longs (reader);
+					index.PubNameOffsets = read_longs (reader);
+
+					index.PubNames = new string [index.PubNameOffsets.Length / 2];
+					for (int i = 0; i < index.PubNames.Length; i++)
+						index.PubNames [i] = reader.ReadString ();
+
+					return index;
+				}
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "Can't read DWARF cache entry {0}: {1}", key, ex.Message);
+				return null;
+			}
+		}
+
+		public void SaveDwarfIndex (string key, DwarfIndex index)
+		{
+			try {
+				MemoryStream stream = new MemoryStream ();
+				BinaryWriter writer = new BinaryWriter (stream);
+				write_longs (writer, index.CompileUnits);
+				write_longs (writer, index.ARanges);
+				write_longs (writer, index.PubNameOffsets);
+				foreach (string name in index.PubNames)
+					writer.Write (name);
+				writer.Flush ();
+
+				write_entry (key, KindDwarf, stream.ToArray ());
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "Can't write DWARF cache entry {0}: {1}", key, ex.Message);
+			}
+		}
+
+		public DwarfNameIndex LoadNameIndex (string key)
+		{
+			try {
+				BinaryReader reader = open_entry (key, KindNames);
+				if (reader == null)
+					return null;
+
+				using (reader) {
+					DwarfNameIndex index = new DwarfNameIndex ();
+					index.Entries = read_longs (reader);
+
+					index.Names = new string [index.Entries.Length / 3];
+					for (int i = 0; i < index.Names.Length; i++)
+						index.Names [i] = reader.ReadString ();
+
+					return index;
+				}
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "Can't read name index cache entry {0}: {1}", key, ex.Message);
+				return null;
+			}
+		}
+
+		public void SaveNameIndex (string key, DwarfNameIndex index)
+		{
+			try {
+				MemoryStream stream = new MemoryStream ();
+				BinaryWriter writer = new BinaryWriter (stream);
+				write_longs (writer, index.Entries);
+				foreach (string name in index.Names)
+					writer.Write (name);
+				writer.Flush ();
+
+				write_entry (key, KindNames, stream.ToArray ());
+			} catch (Exception ex) {
+				Report.Debug (DebugFlags.SymbolTable,
+					      "Can't write name index cache entry {0}: {1}", key, ex.Message);
+			}
+		}
+	}
+}
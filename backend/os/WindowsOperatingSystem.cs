@@ -19,6 +19,11 @@ namespace Mono.Debugger.Backend
 			throw new NotImplementedException();
 		}
 
+		internal override void ReadNativeTypes (string name)
+		{
+			throw new NotImplementedException();
+		}
+
 		public override NativeExecutableReader LookupLibrary (TargetAddress address)
 		{
 			throw new NotImplementedException();
@@ -17,8 +17,19 @@ namespace Mono.Debugger
 	// </summary>
 	public abstract class Breakpoint : Event
 	{
+		BreakpointCondition condition;
+
 		internal abstract BreakpointHandle Resolve (Thread target, StackFrame frame);
 
+		// <summary>
+		//   If this is not null, the breakpoint only stops the target if the
+		//   condition is true.  Should be set before the breakpoint is activated.
+		// </summary>
+		public BreakpointCondition Condition {
+			get { return condition; }
+			set { condition = value; }
+		}
+
 		public override bool NeedsActivation {
 			get { return true; }
 		}
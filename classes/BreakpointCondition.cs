@@ -0,0 +1,540 @@
+using System;
+using System.IO;
+using System.Collections;
+
+using Mono.Debugger.Backend;
+using Mono.Debugger.Languages;
+
+namespace Mono.Debugger
+{
+	public enum BreakpointConditionOperator
+	{
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Remainder,
+		Equal,
+		NotEqual,
+		Less,
+		LessOrEqual,
+		Greater,
+		GreaterOrEqual,
+		LogicalNot
+	}
+
+	// <summary>
+	//   A condition which decides whether a breakpoint actually stops the
+	//   target.  It is provided by the user interface.
+	// </summary>
+	// <remarks>
+	//   The first time the breakpoint is hit, we try to Compile() the
+	//   condition; if that succeeds, the server evaluates it on its own and
+	//   only reports the breakpoint if the condition is true.  Otherwise,
+	//   Evaluate() is called each time the breakpoint is hit.
+	// </remarks>
+	public abstract class BreakpointCondition : DebuggerMarshalByRefObject
+	{
+		public abstract string Text {
+			get;
+		}
+
+		// <summary>
+		//   Evaluate the condition in @frame, which is the frame of the
+		//   thread which hit the breakpoint.
+		// </summary>
+		public abstract bool Evaluate (StackFrame frame);
+
+		// <summary>
+		//   Compile the condition with @builder; returns false if it can't
+		//   be compiled.
+		// </summary>
+		public virtual bool Compile (BreakpointConditionBuilder builder)
+		{
+			return false;
+		}
+
+		public override string ToString ()
+		{
+			return Text;
+		}
+	}
+
+	// <summary>
+	//   Compiles a breakpoint condition into the code which is evaluated by
+	//   the server; see sysdeps/server/breakpoints.h for the format.
+	// </summary>
+	// <remarks>
+	//   Values are emitted in postfix order.  Each Emit method returns false
+	//   if we can't compile the operation, in which case the whole condition
+	//   must be evaluated by the debugger.
+	// </remarks>
+	public sealed class BreakpointConditionBuilder
+	{
+		const byte OP_END		= 0;
+		const byte OP_CONST		= 1;
+		const byte OP_REGISTER		= 2;
+		const byte OP_LOAD		= 3;
+		const byte OP_EXTEND		= 4;
+		const byte OP_ADD		= 5;
+		const byte OP_SUB		= 6;
+		const byte OP_MUL		= 7;
+		const byte OP_DIV		= 8;
+		const byte OP_REM		= 9;
+		const byte OP_LOGICAL_NOT	= 17;
+		const byte OP_EQ		= 18;
+		const byte OP_NE		= 19;
+		const byte OP_LT		= 20;
+		const byte OP_LE		= 21;
+		const byte OP_GT		= 22;
+		const byte OP_GE		= 23;
+		const byte OP_AND_THEN		= 24;
+		const byte OP_OR_ELSE		= 25;
+		const byte OP_LT_UN		= 26;
+		const byte OP_LE_UN		= 27;
+		const byte OP_GT_UN		= 28;
+		const byte OP_GE_UN		= 29;
+		const byte OP_DIV_UN		= 30;
+		const byte OP_REM_UN		= 31;
+
+		// <summary>
+		//   A value on the evaluation stack: either the address of an
+		//   object of type `Type' or - if `IsAddress' is false - its
+		//   contents.  `Type' is null for integers.  `IsUnsigned' is set
+		//   for loaded 64-bit values which the server must not treat as
+		//   signed, like pointers or UInt64's.
+		// </summary>
+		class Value
+		{
+			public readonly TargetType Type;
+			public readonly bool IsAddress;
+			public readonly bool IsUnsigned;
+
+			public Value (TargetType type, bool is_address, bool is_unsigned)
+			{
+				this.Type = type;
+				this.IsAddress = is_address;
+				this.IsUnsigned = is_unsigned;
+			}
+		}
+
+		readonly Inferior inferior;
+		readonly Thread thread;
+		readonly Method method;
+		readonly TargetAddress address;
+
+		MemoryStream code = new MemoryStream ();
+		ArrayList stack = new ArrayList ();
+		ArrayList labels = new ArrayList ();
+
+		internal BreakpointConditionBuilder (Inferior inferior, Thread thread,
+						     Method method, TargetAddress address)
+		{
+			this.inferior = inferior;
+			this.thread = thread;
+			this.method = method;
+			this.address = address;
+		}
+
+		public TargetAddress Address {
+			get { return address; }
+		}
+
+		public Method Method {
+			get { return method; }
+		}
+
+		void emit (byte opcode)
+		{
+			code.WriteByte (opcode);
+		}
+
+		void emit (byte opcode, byte arg1, byte arg2)
+		{
+			code.WriteByte (opcode);
+			code.WriteByte (arg1);
+			code.WriteByte (arg2);
+		}
+
+		void emit_const (long value)
+		{
+			code.WriteByte (OP_CONST);
+			for (int i = 0; i < 8; i++)
+				code.WriteByte ((byte) (value >> (8 * i)));
+		}
+
+		void push (TargetType type, bool is_address)
+		{
+			stack.Add (new Value (type, is_address, false));
+		}
+
+		void push_integer (bool is_unsigned)
+		{
+			stack.Add (new Value (null, false, is_unsigned));
+		}
+
+		Value pop ()
+		{
+			Value value = (Value) stack [stack.Count - 1];
+			stack.RemoveAt (stack.Count - 1);
+			return value;
+		}
+
+		bool is_signed (FundamentalKind kind)
+		{
+			switch (kind) {
+			case FundamentalKind.SByte:
+			case FundamentalKind.Int16:
+			case FundamentalKind.Int32:
+			case FundamentalKind.Int64:
+			case FundamentalKind.IntPtr:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		bool is_integer (FundamentalKind kind)
+		{
+			switch (kind) {
+			case FundamentalKind.Boolean:
+			case FundamentalKind.Char:
+			case FundamentalKind.SByte:
+			case FundamentalKind.Byte:
+			case FundamentalKind.Int16:
+			case FundamentalKind.UInt16:
+			case FundamentalKind.Int32:
+			case FundamentalKind.UInt32:
+			case FundamentalKind.Int64:
+			case FundamentalKind.UInt64:
+			case FundamentalKind.IntPtr:
+			case FundamentalKind.UIntPtr:
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		//
+		// Replace the value on top of the stack with its contents, so
+		// we can do arithmetic with it.
+		//
+		bool load_value ()
+		{
+			Value value = (Value) stack [stack.Count - 1];
+			if (value.Type == null)
+				return true;
+
+			int size;
+			bool signed;
+
+			TargetFundamentalType ftype = value.Type as TargetFundamentalType;
+			if ((ftype != null) && !ftype.IsByRef) {
+				if (!is_integer (ftype.FundamentalKind))
+					return false;
+				size = ftype.Size;
+				signed = is_signed (ftype.FundamentalKind);
+			} else if ((value.Type is TargetPointerType) || value.Type.IsByRef) {
+				size = inferior.TargetAddressSize;
+				signed = false;
+			} else
+				return false;
+
+			if ((size < 1) || (size > 8))
+				return false;
+
+			emit (value.IsAddress ? OP_LOAD : OP_EXTEND, (byte) size, (byte) (signed ? 1 : 0));
+
+			pop ();
+			stack.Add (new Value (value.Type, false, (size == 8) && !signed));
+			return true;
+		}
+
+		//
+		// Before we push a new value, the one below it must be loaded,
+		// since we can only operate on the top of the stack.
+		//
+		bool prepare_push ()
+		{
+			if (stack.Count == 0)
+				return true;
+			if (stack.Count >= 16)
+				return false;
+			return load_value ();
+		}
+
+		public bool EmitConstant (long value)
+		{
+			if (!prepare_push ())
+				return false;
+
+			emit_const (value);
+			push (null, false);
+			return true;
+		}
+
+		public bool EmitRegister (string name)
+		{
+			int index = Array.IndexOf (inferior.Architecture.RegisterNames, name);
+			if ((index < 0) || (index > Byte.MaxValue) || !prepare_push ())
+				return false;
+
+			emit (OP_REGISTER);
+			code.WriteByte ((byte) index);
+			push (null, false);
+			return true;
+		}
+
+		TargetVariable lookup_variable (string name)
+		{
+			if (method == null)
+				return null;
+
+			if (name == "this")
+				return method.HasThis ? method.GetThis (thread) : null;
+
+			foreach (TargetVariable variable in method.GetLocalVariables (thread)) {
+				if ((variable.Name == name) && variable.IsInScope (address))
+					return variable;
+			}
+
+			foreach (TargetVariable variable in method.GetParameters (thread)) {
+				if (variable.Name == name)
+					return variable;
+			}
+
+			return null;
+		}
+
+		// <summary>
+		//   Emit a local variable or parameter of the breakpoint's method.
+		// </summary>
+		public bool EmitVariable (string name)
+		{
+			TargetVariable variable = lookup_variable (name);
+			if ((variable == null) || !variable.IsAlive (address) || !prepare_push ())
+				return false;
+
+			return variable.CompileLocation (this);
+		}
+
+		// <summary>
+		//   Called by TargetVariable.CompileLocation(): the variable is
+		//   the contents of @register plus @offset, or stored at that
+		//   address if @is_regoffset is true.  If @is_byref is true, that
+		//   holds the variable's address.
+		// </summary>
+		internal bool EmitLocation (int register, long offset, bool is_regoffset,
+					    bool is_byref, TargetType type)
+		{
+			if ((register < 0) || (register > Byte.MaxValue))
+				return false;
+
+			emit (OP_REGISTER);
+			code.WriteByte ((byte) register);
+
+			if (offset != 0) {
+				emit_const (offset);
+				emit (OP_ADD);
+			}
+
+			if (is_regoffset && is_byref)
+				emit (OP_LOAD, (byte) inferior.TargetAddressSize, 0);
+
+			push (type, is_regoffset || is_byref);
+			return true;
+		}
+
+		// <summary>
+		//   Emit instance field @name of the value on top of the stack.
+		// </summary>
+		public bool EmitMember (string name)
+		{
+			if (stack.Count == 0)
+				return false;
+
+			Value value = (Value) stack [stack.Count - 1];
+
+			TargetStructType stype;
+			TargetPointerType ptype = value.Type as TargetPointerType;
+			if ((ptype != null) && ptype.HasStaticType) {
+				stype = ptype.StaticType as TargetStructType;
+				if ((stype == null) || !load_value ())
+					return false;
+			} else {
+				stype = value.Type as TargetStructType;
+				if (stype == null)
+					return false;
+
+				if (stype.IsByRef) {
+					if (!load_value ())
+						return false;
+				} else if (!value.IsAddress)
+					return false;
+			}
+
+			TargetFieldInfo field = stype.FindMember (name, false, true) as TargetFieldInfo;
+			if ((field == null) || field.HasConstValue)
+				return false;
+
+			int offset = stype.GetFieldOffset (inferior, field);
+			if (offset < 0)
+				return false;
+
+			if (offset != 0) {
+				emit_const (offset);
+				emit (OP_ADD);
+			}
+
+			pop ();
+			push (field.Type, true);
+			return true;
+		}
+
+		// <summary>
+		//   Dereference the pointer on top of the stack.
+		// </summary>
+		public bool EmitDereference ()
+		{
+			if (stack.Count == 0)
+				return false;
+
+			Value value = (Value) stack [stack.Count - 1];
+			TargetPointerType ptype = value.Type as TargetPointerType;
+			if ((ptype == null) || !ptype.HasStaticType || !load_value ())
+				return false;
+
+			pop ();
+			push (ptype.StaticType, true);
+			return true;
+		}
+
+		public bool EmitOperator (BreakpointConditionOperator op)
+		{
+			if (stack.Count == 0)
+				return false;
+			if (!load_value ())
+				return false;
+
+			if (op == BreakpointConditionOperator.LogicalNot) {
+				emit (OP_LOGICAL_NOT);
+				pop ();
+				push (null, false);
+				return true;
+			}
+
+			if (stack.Count < 2)
+				return false;
+
+			//
+			// All values on the server's stack are 64-bit, so smaller
+			// unsigned ones are zero-extended and may be compared and
+			// divided as signed values; 64-bit ones may not.
+			//
+			bool is_unsigned = ((Value) stack [stack.Count - 1]).IsUnsigned ||
+				((Value) stack [stack.Count - 2]).IsUnsigned;
+			bool unsigned_result = false;
+
+			switch (op) {
+			case BreakpointConditionOperator.Add:
+				emit (OP_ADD);
+				unsigned_result = is_unsigned;
+				break;
+			case BreakpointConditionOperator.Subtract:
+				emit (OP_SUB);
+				unsigned_result = is_unsigned;
+				break;
+			case BreakpointConditionOperator.Multiply:
+				emit (OP_MUL);
+				unsigned_result = is_unsigned;
+				break;
+			case BreakpointConditionOperator.Divide:
+				emit (is_unsigned ? OP_DIV_UN : OP_DIV);
+				unsigned_result = is_unsigned;
+				break;
+			case BreakpointConditionOperator.Remainder:
+				emit (is_unsigned ? OP_REM_UN : OP_REM);
+				unsigned_result = is_unsigned;
+				break;
+			case BreakpointConditionOperator.Equal:
+				emit (OP_EQ);
+				break;
+			case BreakpointConditionOperator.NotEqual:
+				emit (OP_NE);
+				break;
+			case BreakpointConditionOperator.Less:
+				emit (is_unsigned ? OP_LT_UN : OP_LT);
+				break;
+			case BreakpointConditionOperator.LessOrEqual:
+				emit (is_unsigned ? OP_LE_UN : OP_LE);
+				break;
+			case BreakpointConditionOperator.Greater:
+				emit (is_unsigned ? OP_GT_UN : OP_GT);
+				break;
+			case BreakpointConditionOperator.GreaterOrEqual:
+				emit (is_unsigned ? OP_GE_UN : OP_GE);
+				break;
+			default:
+				return false;
+			}
+
+			pop ();
+			pop ();
+			push_integer (unsigned_result);
+			return true;
+		}
+
+		// <summary>
+		//   Start the right side of a `&&' (or `||' if @is_or is true)
+		//   whose left side is on top of the stack; call EndLogical()
+		//   with the return value once it has been emitted.
+		// </summary>
+		public int BeginLogical (bool is_or)
+		{
+			if ((stack.Count == 0) || !load_value ())
+				return -1;
+
+			emit (is_or ? OP_OR_ELSE : OP_AND_THEN);
+			labels.Add ((int) code.Position);
+			code.WriteByte (0);
+			code.WriteByte (0);
+
+			pop ();
+			return labels.Count - 1;
+		}
+
+		public bool EndLogical (int label)
+		{
+			if ((label < 0) || (label >= labels.Count) || (stack.Count == 0))
+				return false;
+			if (!load_value ())
+				return false;
+
+			// Both sides must leave either 0 or 1 on the stack.
+			emit (OP_LOGICAL_NOT);
+			emit (OP_LOGICAL_NOT);
+
+			int position = (int) labels [label];
+			long offset = code.Position - (position + 2);
+			if (offset > UInt16.MaxValue)
+				return false;
+
+			byte[] buffer = code.GetBuffer ();
+			buffer [position] = (byte) offset;
+			buffer [position + 1] = (byte) (offset >> 8);
+
+			pop ();
+			push (null, false);
+			return true;
+		}
+
+		internal byte[] GetCode ()
+		{
+			if ((stack.Count != 1) || !load_value ())
+				return null;
+
+			emit (OP_END);
+			return code.ToArray ();
+		}
+	}
+}
@@ -0,0 +1,27 @@
+using System;
+
+namespace Mono.Debugger
+{
+	// <summary>
+	//   How often a breakpoint was hit in one process; if the breakpoint has
+	//   more than one location, the counts are summed up.
+	// </summary>
+	[Serializable]
+	public class BreakpointStatistics
+	{
+		// Number of times the breakpoint was hit.
+		public int HitCount;
+
+		// Number of hits where the debugger server resumed the target on its
+		// own, because of the breakpoint's ignore count or condition.
+		public int FilteredCount;
+
+		// Number of hits which are still going to be ignored.
+		public int IgnoreCount;
+
+		// Number of hits which were reported to the debugger.
+		public int ReportedCount {
+			get { return HitCount - FilteredCount; }
+		}
+	}
+}
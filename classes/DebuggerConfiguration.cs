@@ -122,6 +122,14 @@ namespace Mono.Debugger
 					NestedBreakStates = Boolean.Parse (iter.Current.Value);
 				else if (iter.Current.Name == "RedirectOutput")
 					RedirectOutput = Boolean.Parse (iter.Current.Value);
+				else if (iter.Current.Name == "SymbolIndexCache")
+					SymbolIndexCache = Boolean.Parse (iter.Current.Value);
+				else if (iter.Current.Name == "SymbolTableStatistics")
+					SymbolTableStatistics = Boolean.Parse (iter.Current.Value);
+				else if (iter.Current.Name == "SymbolIndexCacheDirectory")
+					SymbolIndexCacheDirectory = iter.Current.Value;
+				else if (iter.Current.Name == "SymbolIndexCacheSize")
+					SymbolIndexCacheSize = Int32.Parse (iter.Current.Value);
 				else if (iter.Current.Name == "Martin_Boston_07102008") {
 					; // ignore, this is no longer in use.
 				} else if (iter.Current.Name == "BrokenThreading") {
@@ -219,6 +227,24 @@ namespace Mono.Debugger
 				redirect_output_e.InnerText = RedirectOutput ? "true" : "false";
 				element.AppendChild (redirect_output_e);
 
+				XmlElement symbol_index_cache_e = doc.CreateElement ("SymbolIndexCache");
+				symbol_index_cache_e.InnerText = SymbolIndexCache ? "true" : "false";
+				element.AppendChild (symbol_index_cache_e);
+
+				if (symbol_index_cache_directory != null) {
+					XmlElement symbol_index_cache_dir_e = doc.CreateElement ("SymbolIndexCacheDirectory");
+					symbol_index_cache_dir_e.InnerText = symbol_index_cache_directory;
+					element.AppendChild (symbol_index_cache_dir_e);
+				}
+
+				XmlElement symbol_index_cache_size_e = doc.CreateElement ("SymbolIndexCacheSize");
+				symbol_index_cache_size_e.InnerText = SymbolIndexCacheSize.ToString ();
+				element.AppendChild (symbol_index_cache_size_e);
+
+				XmlElement symtab_stats_e = doc.CreateElement ("SymbolTableStatistics");
+				symtab_stats_e.InnerText = SymbolTableStatistics ? "true" : "false";
+				element.AppendChild (symtab_stats_e);
+
 				XmlElement stop_daemon_threads_e = doc.CreateElement ("StopDaemonThreads");
 				stop_daemon_threads_e.InnerText = (ThreadingModel & ThreadingModel.StopDaemonThreads) != 0 ? "true" : "false";
 				element.AppendChild (stop_daemon_threads_e);
@@ -269,6 +295,10 @@ namespace Mono.Debugger
 		bool stop_on_managed_signals = true;
 		bool nested_break_states = false;
 		bool redirect_output = false;
+		bool symbol_index_cache = false;
+		string symbol_index_cache_directory = null;
+		int symbol_index_cache_size = 256;
+		bool symbol_table_statistics = false;
 		bool is_xsp = false;
 		bool is_cli = false;
 		UserNotificationType user_notifications = UserNotificationType.Threads;
@@ -404,6 +434,54 @@ namespace Mono.Debugger
 			set { redirect_output = value; }
 		}
 
+		/*
+		 * On-disk cache of symbol and DWARF indices, see
+		 * backend/os/SymbolIndexCache.cs.
+		 */
+		public bool SymbolIndexCache {
+			get { return symbol_index_cache; }
+			set { symbol_index_cache = value; }
+		}
+
+		// <summary>
+		//   Defaults to $XDG_CACHE_HOME/mdb (or ~/.cache/mdb).
+		// </summary>
+		public string SymbolIndexCacheDirectory {
+			get {
+				if (symbol_index_cache_directory != null)
+					return symbol_index_cache_directory;
+
+				string dir = Environment.GetEnvironmentVariable ("XDG_CACHE_HOME");
+				if ((dir == null) || (dir == ""))
+					dir = Path.Combine (
+						Environment.GetFolderPath (Environment.SpecialFolder.Personal),
+						".cache");
+				return Path.Combine (dir, "mdb");
+			}
+			set {
+				if ((value == null) || (value == ""))
+					symbol_index_cache_directory = null;
+				else
+					symbol_index_cache_directory = value;
+			}
+		}
+
+		// <summary>
+		//   Size limit of the symbol index cache in megabytes.
+		// </summary>
+		public int SymbolIndexCacheSize {
+			get { return symbol_index_cache_size; }
+			set { symbol_index_cache_size = value; }
+		}
+
+		// <summary>
+		//   Time symbol table updates for `show symtab-stats'.
+		// </summary>
+		public bool SymbolTableStatistics {
+			get { return symbol_table_statistics; }
+			set { symbol_table_statistics = value; }
+		}
+
 		/*
 		 * Configurable user notifications.
 		 */
@@ -465,6 +543,14 @@ namespace Mono.Debugger
 
 			sb.Append (String.Format ("  Redirect output (redirect-output):                  {0}\n",
 						  RedirectOutput ? "yes" : "no"));
+			sb.Append (String.Format ("  Symbol index cache (symbol-cache):                  {0}\n",
+						  SymbolIndexCache ? "yes" : "no"));
+			sb.Append (String.Format ("  Symbol index cache directory (symbol-cache-dir):    {0}\n",
+						  SymbolIndexCacheDirectory));
+			sb.Append (String.Format ("  Symbol index cache size (symbol-cache-size):        {0} MB\n",
+						  SymbolIndexCacheSize));
+			sb.Append (String.Format ("  Symbol table statistics (symtab-stats):             {0}\n",
+						  SymbolTableStatistics ? "yes" : "no"));
 
 			if (expert_mode) {
 				sb.Append ("\nExpert Settings:\n");
@@ -693,6 +693,17 @@ namespace Mono.Debugger
 			get { return mono_language != null; }
 		}
 
+		// <summary>
+		//   Returns null if this isn't a managed application.
+		// </summary>
+		public SymbolTableStatistics GetSymbolTableStatistics ()
+		{
+			if (mono_language == null)
+				return null;
+
+			return mono_language.GetStatistics ();
+		}
+
 		public Module[] Modules {
 			get { return session.Modules; }
 		}
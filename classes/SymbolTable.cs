@@ -67,6 +67,43 @@ namespace Mono.Debugger
 
 		ObjectCache method_table;
 
+		//
+		// Sorted copies of SymbolRanges and of the loaded methods, so we can
+		// binary-search them in Lookup().  `ranges_merged' is the number of
+		// entries from SymbolRanges we already merged into `range_index';
+		// symbol tables only ever append new ranges.
+		//
+		// Entries may enclose each other, so we also keep the running
+		// maximum of their end addresses: `range_max_ends [i]' is the
+		// largest end address of all entries up to and including `i'.
+		// When looking for an address, we walk back from the last entry
+		// starting at or below it for as long as this is above the address.
+		//
+		ISymbolRange[] range_index;
+		long[] range_starts;
+		long[] range_max_ends;
+		int ranges_merged;
+		bool ranges_dirty = true;
+
+		//
+		// Ranges which were added with RangeAdded() since the last merge;
+		// sorted like `range_index', but much smaller.  We merge them into
+		// `range_index' once there are more than `max_pending_ranges' or
+		// an eighth of the size of `range_index', so adding a range doesn't
+		// have to copy all the others each time.
+		//
+		ISymbolRange[] pending_ranges;
+		long[] pending_starts;
+		long[] pending_max_ends;
+		int pending_count;
+
+		const int max_pending_ranges = 256;
+
+		ArrayList method_index_source;
+		Method[] method_index;
+		long[] method_starts;
+		long[] method_max_ends;
+
 		protected SymbolTable (TargetAddress start_address, TargetAddress end_address)
 		{
 			this.is_continuous = true;
@@ -163,23 +200,243 @@ namespace Mono.Debugger
 			}
 		}
 
+		void merge_ranges ()
+		{
+			ISymbolRange[] ranges = SymbolRanges;
+			if (ranges == null) {
+				range_index = null;
+				range_starts = null;
+				range_max_ends = null;
+				ranges_merged = 0;
+				pending_count = 0;
+				return;
+			}
+
+			if ((range_index == null) || (ranges.Length < ranges_merged)) {
+				range_index = new ISymbolRange [0];
+				range_starts = new long [0];
+				range_max_ends = new long [0];
+				ranges_merged = 0;
+				pending_count = 0;
+			}
+
+			int new_count = ranges.Length - ranges_merged;
+			if (new_count == 0) {
+				merge_pending ();
+				return;
+			}
+
+			ISymbolRange[] new_ranges = new ISymbolRange [new_count];
+			Array.Copy (ranges, ranges_merged, new_ranges, 0, new_count);
+			Array.Sort (new_ranges);
+
+			merge_pending ();
+			merge_sorted (new_ranges, new_count);
+			ranges_merged = ranges.Length;
+		}
+
+		void merge_pending ()
+		{
+			if (pending_count == 0)
+				return;
+
+			merge_sorted (pending_ranges, pending_count);
+			pending_count = 0;
+		}
+
+		// <summary>
+		//   Merge the first `count' entries of the sorted `new_ranges'
+		//   into `range_index'.
+		// </summary>
+		void merge_sorted (ISymbolRange[] new_ranges, int new_count)
+		{
+			ISymbolRange[] merged = new ISymbolRange [range_index.Length + new_count];
+			int i = 0, j = 0, k = 0;
+			while ((i < range_index.Length) && (j < new_count)) {
+				if (new_ranges [j].StartAddress < range_index [i].StartAddress)
+					merged [k++] = new_ranges [j++];
+				else
+					merged [k++] = range_index [i++];
+			}
+			while (i < range_index.Length)
+				merged [k++] = range_index [i++];
+			while (j < new_count)
+				merged [k++] = new_ranges [j++];
+
+			range_starts = new long [merged.Length];
+			for (k = 0; k < merged.Length; k++)
+				range_starts [k] = merged [k].StartAddress.Address;
+
+			range_max_ends = new long [merged.Length];
+			compute_max_ends (merged, range_max_ends, 0, merged.Length);
+
+			range_index = merged;
+		}
+
+		// <summary>
+		//   Tell us that `range' was just appended to SymbolRanges.  This
+		//   is much cheaper than UpdateSymbolTable(), which makes us look
+		//   at all the SymbolRanges again.
+		// </summary>
+		protected void RangeAdded (ISymbolRange range)
+		{
+			lock (this) {
+				//
+				// If we haven't read SymbolRanges yet, or have to read it
+				// again anyways, that'll pick up the new range.
+				//
+				if (ranges_dirty || (range_index == null))
+					return;
+
+				if (pending_ranges == null) {
+					pending_ranges = new ISymbolRange [16];
+					pending_starts = new long [16];
+					pending_max_ends = new long [16];
+				} else if (pending_count == pending_ranges.Length) {
+					Array.Resize (ref pending_ranges, 2 * pending_count);
+					Array.Resize (ref pending_starts, 2 * pending_count);
+					Array.Resize (ref pending_max_ends, 2 * pending_count);
+				}
+
+				long start = range.StartAddress.Address;
+				int pos = find_start (pending_starts, pending_count, start) + 1;
+
+				Array.Copy (pending_ranges, pos, pending_ranges, pos + 1,
+					    pending_count - pos);
+				Array.Copy (pending_starts, pos, pending_starts, pos + 1,
+					    pending_count - pos);
+				pending_ranges [pos] = range;
+				pending_starts [pos] = start;
+				pending_count++;
+				compute_max_ends (pending_ranges, pending_max_ends, pos, pending_count);
+				ranges_merged++;
+
+				if (pending_count > Math.Max (max_pending_ranges, range_index.Length / 8))
+					merge_pending ();
+			}
+
+			if (SymbolTableChanged != null)
+				SymbolTableChanged ();
+		}
+
+		void create_method_index (ArrayList methods)
+		{
+			ArrayList loaded = new ArrayList ();
+			foreach (Method method in methods) {
+				if (method.IsLoaded)
+					loaded.Add (method);
+			}
+
+			method_index = new Method [loaded.Count];
+			loaded.CopyTo (method_index, 0);
+
+			method_starts = new long [method_index.Length];
+			method_max_ends = new long [method_index.Length];
+			long max_end = 0;
+			for (int i = 0; i < method_index.Length; i++) {
+				method_starts [i] = method_index [i].StartAddress.Address;
+				max_end = Math.Max (max_end, method_index [i].EndAddress.Address);
+				method_max_ends [i] = max_end;
+			}
+
+			method_index_source = methods;
+		}
+
+		// <summary>
+		//   Returns the index of the last entry in the sorted `starts' array
+		//   which is less than or equal to `address' or -1.
+		// </summary>
+		static int find_start (long[] starts, long address)
+		{
+			return find_start (starts, starts.Length, address);
+		}
+
+		// <summary>
+		//   Like find_start() above, but only look at the first `count'
+		//   entries of `starts'.
+		// </summary>
+		static int find_start (long[] starts, int count, long address)
+		{
+			int lo = 0, hi = count - 1;
+			int found = -1;
+
+			while (lo <= hi) {
+				int mid = (lo + hi) / 2;
+				if (starts [mid] <= address) {
+					found = mid;
+					lo = mid + 1;
+				} else
+					hi = mid - 1;
+			}
+
+			return found;
+		}
+
+		// <summary>
+		//   Recompute `max_ends' for the entries from `start' up to `count'.
+		// </summary>
+		static void compute_max_ends (ISymbolRange[] ranges, long[] max_ends,
+					      int start, int count)
+		{
+			long max_end = start > 0 ? max_ends [start - 1] : 0;
+			for (int i = start; i < count; i++) {
+				max_end = Math.Max (max_end, ranges [i].EndAddress.Address);
+				max_ends [i] = max_end;
+			}
+		}
+
+		// <summary>
+		//   Returns the entry with the lowest start address which contains
+		//   `address' or null.
+		// </summary>
+		static ISymbolRange find_range (ISymbolRange[] ranges, long[] starts,
+						long[] max_ends, int count, TargetAddress address)
+		{
+			if (count == 0)
+				return null;
+
+			ISymbolRange found = null;
+			int idx = find_start (starts, count, address.Address);
+			for (int i = idx; (i >= 0) && (max_ends [i] > address.Address); i--) {
+				if (address < ranges [i].EndAddress)
+					found = ranges [i];
+			}
+
+			return found;
+		}
+
 		public virtual Method Lookup (TargetAddress address)
 		{
 			if (IsContinuous && ((address < start_address) || (address >= end_address)))
 				return null;
 
 			if (HasRanges) {
-				if (SymbolRanges == null)
-					return null;
-
-				foreach (SymbolRangeEntry range in SymbolRanges) {
-					if ((address < range.StartAddress) || (address >= range.EndAddress))
-						continue;
-
-					return range.SymbolLookup.Lookup (address);
+				ISymbolRange range = null;
+
+				lock (this) {
+					if (ranges_dirty) {
+						merge_ranges ();
+						ranges_dirty = false;
+					}
+
+					if (range_index == null)
+						return null;
+
+					range = find_range (range_index, range_starts, range_max_ends,
+							    range_starts.Length, address);
+
+					ISymbolRange pending = find_range (
+						pending_ranges, pending_starts, pending_max_ends,
+						pending_count, address);
+					if ((pending != null) &&
+					    ((range == null) || (pending.StartAddress < range.StartAddress)))
+						range = pending;
 				}
 
-				return null;
+				if (range == null)
+					return null;
+
+				return range.SymbolLookup.Lookup (address);
 			}
 
 			if (!HasMethods)
@@ -189,17 +446,19 @@ namespace Mono.Debugger
 			if (methods == null)
 				return null;
 
-			foreach (Method method in methods) {
-				if (!method.IsLoaded)
-					continue;
-
-				if ((address < method.StartAddress) || (address >= method.EndAddress))
-					continue;
+			lock (this) {
+				if (methods != method_index_source)
+					create_method_index (methods);
+
+				Method found = null;
+				int idx = find_start (method_starts, address.Address);
+				for (int i = idx; (i >= 0) && (method_max_ends [i] > address.Address); i--) {
+					if (address < method_index [i].EndAddress)
+						found = method_index [i];
+				}
 
-				return method;
+				return found;
 			}
-
-			return null;
 		}
 
 		public virtual Symbol SimpleLookup (TargetAddress address, bool exact_match)
@@ -229,6 +488,10 @@ namespace Mono.Debugger
 
 		public virtual void UpdateSymbolTable ()
 		{
+			lock (this) {
+				ranges_dirty = true;
+			}
+
 			if (SymbolTableChanged != null)
 				SymbolTableChanged ();
 		}
@@ -0,0 +1,28 @@
+using System;
+
+namespace Mono.Debugger
+{
+	// <summary>
+	//   How much work we spent reading the JIT's symbol tables; all the
+	//   numbers are accumulated since the debugger started.
+	// </summary>
+	[Serializable]
+	public class SymbolTableStatistics
+	{
+		// Number of times we read the whole symbol table.
+		public int FullUpdateCount;
+		public TimeSpan UpdateTime;
+
+		// Number of times we looked at the data tables and how many of
+		// these actually had new data items.
+		public int DataTableCount;
+		public int UpdateCount;
+		public int DataItemCount;
+		public TimeSpan DataTableTime;
+
+		// Number of JIT-compiled methods we read.
+		public int RangeEntryCount;
+		public TimeSpan RangeEntryTime;
+		public TimeSpan RangeEntryMethodTime;
+	}
+}
@@ -1,28 +1,84 @@
 using System;
 using System.Text;
+using System.Runtime.InteropServices;
+using System.Runtime.Serialization;
 
 namespace Mono.Debugger
 {
 	[Serializable]
 	public sealed class TargetBlob
 	{
-		public readonly byte[] Contents;
+		byte[] contents;
+		int size;
+
+		//
+		// A blob may also point directly into memory which somebody else
+		// owns, for instance a read-only mapping of a section in a symbol
+		// file.  `owner' keeps that memory alive as long as we're using it;
+		// `Contents' makes a copy the first time it's accessed.
+		//
+		[NonSerialized] IntPtr data;
+		[NonSerialized] object owner;
+
 		public readonly TargetMemoryInfo TargetMemoryInfo;
 
 		public TargetBlob (byte[] contents, TargetMemoryInfo target_info)
 		{
-			this.Contents = contents;
+			this.contents = contents;
+			this.size = contents.Length;
 			this.TargetMemoryInfo = target_info;
 		}
 
 		public TargetBlob (int size, TargetMemoryInfo target_info)
+			: this (new byte [size], target_info)
+		{ }
+
+		internal TargetBlob (IntPtr data, int size, TargetMemoryInfo target_info,
+				     object owner)
 		{
-			this.Contents = new byte [size];
+			this.data = data;
+			this.size = size;
+			this.owner = owner;
 			this.TargetMemoryInfo = target_info;
 		}
 
+		public byte[] Contents {
+			get {
+				if (contents == null)
+					contents = copy_contents ();
+				return contents;
+			}
+		}
+
+		byte[] copy_contents ()
+		{
+			byte[] copy = new byte [size];
+			Marshal.Copy (data, copy, 0, size);
+			return copy;
+		}
+
 		public int Size {
-			get { return Contents.Length; }
+			get { return size; }
+		}
+
+		internal bool IsMapped {
+			get { return contents == null; }
+		}
+
+		internal IntPtr Data {
+			get { return data; }
+		}
+
+		internal object Owner {
+			get { return owner; }
+		}
+
+		[OnSerializing]
+		void OnSerializing (StreamingContext context)
+		{
+			// The mapping doesn't survive serialization.
+			if (contents == null)
+				contents = copy_contents ();
 		}
 
 		public TargetBinaryReader GetReader ()
@@ -38,10 +94,29 @@ namespace Mono.Debugger
 		protected int pos;
 		protected bool swap;
 
+		//
+		// Exactly one of these is set: `contents' for ordinary blobs and
+		// `mapped' for blobs which point directly into a mapped file.
+		//
+		protected byte[] contents;
+		[NonSerialized] protected IntPtr mapped;
+
 		public TargetBinaryAccess (TargetBlob blob)
 		{
 			this.blob = blob;
 			this.swap = blob.TargetMemoryInfo.IsBigEndian;
+
+			if (blob.IsMapped)
+				mapped = blob.Data;
+			else
+				contents = blob.Contents;
+		}
+
+		[OnSerializing]
+		void OnSerializing (StreamingContext context)
+		{
+			if (contents == null)
+				contents = blob.Contents;
 		}
 
 		public int AddressSize {
@@ -63,7 +138,7 @@ namespace Mono.Debugger
 
 		public long Size {
 			get {
-				return blob.Contents.Length;
+				return blob.Size;
 			}
 		}
 
@@ -79,19 +154,27 @@ namespace Mono.Debugger
 
 		public bool IsEof {
 			get {
-				return pos == blob.Contents.Length;
+				return pos == blob.Size;
+			}
+		}
+
+		public TargetBlob Blob {
+			get {
+				return blob;
 			}
 		}
 
 		public byte[] Contents {
 			get {
-				return blob.Contents;
+				if (contents == null)
+					contents = blob.Contents;
+				return contents;
 			}
 		}
 
 		public string HexDump ()
 		{
-			return HexDump (blob.Contents);
+			return HexDump (Contents);
 		}
 
 		public static string HexDump (byte[] data)
@@ -1,4 +1,5 @@
 using System;
+using System.Runtime.InteropServices;
 
 namespace Mono.Debugger
 {
@@ -17,39 +18,102 @@ namespace Mono.Debugger
 		{
 		}
 
+		//
+		// Accessors for blobs which point into a mapped file; the
+		// mapping is in host byte order.
+		//
+
+		void check_mapped (long pos, int size)
+		{
+			if ((pos < 0) || (pos + size > blob.Size))
+				throw new IndexOutOfRangeException ();
+		}
+
+		bool swap_mapped {
+			get { return swap == BitConverter.IsLittleEndian; }
+		}
+
+		static short swap16 (short value)
+		{
+			return (short) (((value & 0xff) << 8) | ((value >> 8) & 0xff));
+		}
+
+		static int swap32 (int value)
+		{
+			return (int) (((uint) swap16 ((short) value) << 16) |
+				      (ushort) swap16 ((short) (value >> 16)));
+		}
+
+		static long swap64 (long value)
+		{
+			return (long) (((ulong) (uint) swap32 ((int) value) << 32) |
+				       (uint) swap32 ((int) (value >> 32)));
+		}
+
+		byte peek_mapped_byte (long pos)
+		{
+			check_mapped (pos, 1);
+			return Marshal.ReadByte (mapped, (int) pos);
+		}
+
+		short peek_mapped_int16 (long pos)
+		{
+			check_mapped (pos, 2);
+			short value = Marshal.ReadInt16 (mapped, (int) pos);
+			return swap_mapped ? swap16 (value) : value;
+		}
+
+		int peek_mapped_int32 (long pos)
+		{
+			check_mapped (pos, 4);
+			int value = Marshal.ReadInt32 (mapped, (int) pos);
+			return swap_mapped ? swap32 (value) : value;
+		}
+
+		long peek_mapped_int64 (long pos)
+		{
+			check_mapped (pos, 8);
+			long value = Marshal.ReadInt64 (mapped, (int) pos);
+			return swap_mapped ? swap64 (value) : value;
+		}
+
 		public byte PeekByte (long pos)
 		{
-			return blob.Contents[pos];
+			if (contents == null)
+				return peek_mapped_byte (pos);
+			return contents[pos];
 		}
 
 		public byte PeekByte ()
 		{
-			return blob.Contents[pos];
+			return PeekByte (pos);
 		}
 
 		public byte ReadByte ()
 		{
-			return blob.Contents[pos++];
+			return PeekByte (pos++);
 		}
 
 		public sbyte PeekSByte ()
 		{
-			return (sbyte) blob.Contents[pos];
+			return (sbyte) PeekByte (pos);
 		}
 
 		public sbyte ReadSByte ()
 		{
-			return (sbyte) blob.Contents[pos++];
+			return (sbyte) PeekByte (pos++);
 		}
 
 		public short PeekInt16 (long pos)
 		{
-			if (swap)
-				return ((short) (blob.Contents[pos+1] |
-						 (blob.Contents[pos] << 8)));
+			if (contents == null)
+				return peek_mapped_int16 (pos);
+			else if (swap)
+				return ((short) (contents[pos+1] |
+						 (contents[pos] << 8)));
 			else
-				return ((short) (blob.Contents[pos] |
-						 (blob.Contents[pos+1] << 8)));
+				return ((short) (contents[pos] |
+						 (contents[pos+1] << 8)));
 		}
 
 		public short PeekInt16 ()
@@ -66,16 +130,18 @@ namespace Mono.Debugger
 
 		public int PeekInt32 (long pos)
 		{
-			if (swap)
-				return (blob.Contents[pos+3] |
-					(blob.Contents[pos+2] << 8) |
-					(blob.Contents[pos+1] << 16) |
-					(blob.Contents[pos] << 24));
+			if (contents == null)
+				return peek_mapped_int32 (pos);
+			else if (swap)
+				return (contents[pos+3] |
+					(contents[pos+2] << 8) |
+					(contents[pos+1] << 16) |
+					(contents[pos] << 24));
 			else
-				return (blob.Contents[pos] |
-					(blob.Contents[pos+1] << 8) |
-					(blob.Contents[pos+2] << 16) |
-					(blob.Contents[pos+3] << 24));
+				return (contents[pos] |
+					(contents[pos+1] << 8) |
+					(contents[pos+2] << 16) |
+					(contents[pos+3] << 24));
 		}
 
 		public int PeekInt32 ()
@@ -92,16 +158,7 @@ namespace Mono.Debugger
 
 		public uint PeekUInt32 (long pos)
 		{
-			if (swap)
-				return ((uint) blob.Contents[pos+3] |
-					((uint) blob.Contents[pos+2] << 8) |
-					((uint) blob.Contents[pos+1] << 16) |
-					((uint) blob.Contents[pos] << 24));
-			else
-				return ((uint) blob.Contents[pos] |
-					((uint) blob.Contents[pos+1] << 8) |
-					((uint) blob.Contents[pos+2] << 16) |
-					((uint) blob.Contents[pos+3] << 24));
+			return (uint) PeekInt32 (pos);
 		}
 
 		public uint PeekUInt32 ()
@@ -118,25 +175,28 @@ namespace Mono.Debugger
 
 		public long PeekInt64 (long pos)
 		{
+			if (contents == null)
+				return peek_mapped_int64 (pos);
+
 			uint ret_low, ret_high;
 			if (swap) {
-				ret_low  = (uint) (blob.Contents[pos+7]           |
-						   (blob.Contents[pos+6] << 8)  |
-						   (blob.Contents[pos+5] << 16) |
-						   (blob.Contents[pos+4] << 24));
-				ret_high = (uint) (blob.Contents[pos+3]         |
-						   (blob.Contents[pos+2] << 8)  |
-						   (blob.Contents[pos+1] << 16) |
-						   (blob.Contents[pos] << 24));
+				ret_low  = (uint) (contents[pos+7]           |
+						   (contents[pos+6] << 8)  |
+						   (contents[pos+5] << 16) |
+						   (contents[pos+4] << 24));
+				ret_high = (uint) (contents[pos+3]         |
+						   (contents[pos+2] << 8)  |
+						   (contents[pos+1] << 16) |
+						   (contents[pos] << 24));
 			} else {
-				ret_low  = (uint) (blob.Contents[pos]           |
-						   (blob.Contents[pos+1] << 8)  |
-						   (blob.Contents[pos+2] << 16) |
-						   (blob.Contents[pos+3] << 24));
-				ret_high = (uint) (blob.Contents[pos+4]         |
-						   (blob.Contents[pos+5] << 8)  |
-						   (blob.Contents[pos+6] << 16) |
-						   (blob.Contents[pos+7] << 24));
+				ret_low  = (uint) (contents[pos]           |
+						   (contents[pos+1] << 8)  |
+						   (contents[pos+2] << 16) |
+						   (contents[pos+3] << 24));
+				ret_high = (uint) (contents[pos+4]         |
+						   (contents[pos+5] << 8)  |
+						   (contents[pos+6] << 16) |
+						   (contents[pos+7] << 24));
 			}
 			return (long) ((((ulong) ret_high) << 32) | ret_low);
 		}
@@ -182,12 +242,12 @@ namespace Mono.Debugger
 		public string PeekString (long pos)
 		{
 			int length = 0;
-			while (blob.Contents[pos+length] != 0)
+			while (PeekByte (pos+length) != 0)
 				length++;
 
 			char[] retval = new char [length];
 			for (int i = 0; i < length; i++)
-				retval [i] = (char) blob.Contents[pos+i];
+				retval [i] = (char) PeekByte (pos+i);
 
 			return new String (retval);
 		}
@@ -208,7 +268,11 @@ namespace Mono.Debugger
 		{
 			byte[] buffer = new byte [size];
 
-			Array.Copy (blob.Contents, (int) offset, buffer, 0, size);
+			if (contents == null) {
+				check_mapped (offset, size);
+				Marshal.Copy ((IntPtr) ((long) mapped + offset), buffer, 0, size);
+			} else
+				Array.Copy (contents, (int) offset, buffer, 0, size);
 
 			return buffer;
 		}
@@ -220,11 +284,8 @@ namespace Mono.Debugger
 
 		public byte[] ReadBuffer (int size)
 		{
-			byte[] buffer = new byte [size];
-
-			Array.Copy (blob.Contents, pos, buffer, 0, size);
+			byte[] buffer = PeekBuffer (pos, size);
 			pos += size;
-
 			return buffer;
 		}
 
@@ -130,6 +130,17 @@ namespace Mono.Debugger
 			}
 		}
 
+		// <summary>
+		//   The number of times the target stopped during the last
+		//   stepping operation.
+		// </summary>
+		public int StepTrapCount {
+			get {
+				check_servant ();
+				return servant.StepTrapCount;
+			}
+		}
+
 		internal Architecture Architecture {
 			get {
 				check_servant ();
@@ -461,6 +472,26 @@ namespace Mono.Debugger
 				servant.RemoveBreakpoint (handle);
 		}
 
+		// <summary>
+		//   Don't stop the next @count times @breakpoint is hit in this
+		//   thread's process.
+		// </summary>
+		public void SetBreakpointIgnoreCount (Breakpoint breakpoint, int count)
+		{
+			check_alive ();
+			servant.SetBreakpointIgnoreCount (breakpoint, count);
+		}
+
+		// <summary>
+		//   Returns how often @breakpoint was hit in this thread's process or
+		//   null if it isn't inserted there.
+		// </summary>
+		public BreakpointStatistics GetBreakpointStatistics (Breakpoint breakpoint)
+		{
+			check_alive ();
+			return servant.GetBreakpointStatistics (breakpoint);
+		}
+
 		public string PrintObject (Style style, TargetObject obj, DisplayFormat format)
 		{
 			check_alive ();
@@ -738,6 +769,12 @@ namespace Mono.Debugger
 			return servant.ReadBuffer (address, size);
 		}
 
+		public byte[][] ReadBuffers (TargetAddress[] addresses, int[] sizes)
+		{
+			check_alive ();
+			return servant.ReadBuffers (addresses, sizes);
+		}
+
 		public bool CanWrite {
 			get {
 				check_servant ();
@@ -64,6 +64,7 @@ namespace Mono.Debugger.Frontend
 			RegisterCommand ("disable", typeof (BreakpointDisableCommand));
 			RegisterCommand ("activate", typeof (BreakpointActivateCommand));
 			RegisterCommand ("deactivate", typeof (BreakpointDeactivateCommand));
+			RegisterCommand ("ignore", typeof (BreakpointIgnoreCommand));
 			RegisterCommand ("delete", typeof (BreakpointDeleteCommand));
 			RegisterCommand ("list", typeof (ListCommand));
 			RegisterAlias   ("l", typeof (ListCommand));
@@ -2347,6 +2348,31 @@ namespace Mono.Debugger.Frontend
 			}
 		}
 
+		private class ShowSymbolTableStatisticsCommand : ProcessCommand
+		{
+			protected override object DoExecute (ScriptingContext context)
+			{
+				SymbolTableStatistics stats = CurrentProcess.GetSymbolTableStatistics ();
+				if (stats == null)
+					throw new ScriptingException (
+						"Current process is not a managed application.");
+
+				context.Print ("Full updates:       {0} ({1} ms)", stats.FullUpdateCount,
+					       (int) stats.UpdateTime.TotalMilliseconds);
+				context.Print ("Data table reads:   {0}, {1} with new data ({2} ms)",
+					       stats.DataTableCount, stats.UpdateCount,
+					       (int) stats.DataTableTime.TotalMilliseconds);
+				context.Print ("Data items read:    {0}", stats.DataItemCount);
+				context.Print ("Range entries:      {0} ({1} ms, {2} ms in GetMethod)",
+					       stats.RangeEntryCount,
+					       (int) stats.RangeEntryTime.TotalMilliseconds,
+					       (int) stats.RangeEntryMethodTime.TotalMilliseconds);
+				if (!context.Interpreter.DebuggerConfiguration.SymbolTableStatistics)
+					context.Print ("Timings are only recorded with `config +symtab-stats'.");
+				return null;
+			}
+		}
+
 		private class ShowStyleCommand : DebuggerCommand
 		{
 			protected override bool DoResolve (ScriptingContext context)
@@ -2451,6 +2477,7 @@ namespace Mono.Debugger.Frontend
 			RegisterSubcommand ("style", typeof (ShowStyleCommand));
 			RegisterSubcommand ("location", typeof (ShowLocationCommand));
 			RegisterSubcommand ("displays", typeof (ShowDisplaysCommand));
+			RegisterSubcommand ("symtab-stats", typeof (ShowSymbolTableStatisticsCommand));
 		}
 
 		// IDocumentableCommand
@@ -2795,6 +2822,60 @@ namespace Mono.Debugger.Frontend
 		public string Documentation { get { return ""; } }
 	}
 
+	public class BreakpointIgnoreCommand : DebuggerCommand, IDocumentableCommand
+	{
+		Breakpoint breakpoint;
+		int count;
+
+		protected override bool DoResolve (ScriptingContext context)
+		{
+			if ((Args == null) || (Args.Count != 2))
+				throw new ScriptingException ("Breakpoint number and ignore count expected.");
+
+			int id;
+			if (!Int32.TryParse ((string) Args [0], out id))
+				throw new ScriptingException ("Breakpoint number expected.");
+			if (!Int32.TryParse ((string) Args [1], out count) || (count < 0))
+				throw new ScriptingException ("Ignore count expected.");
+
+			breakpoint = context.Interpreter.GetEvent (id) as Breakpoint;
+			if (breakpoint == null)
+				throw new ScriptingException ("Event {0} is not a breakpoint.", id);
+
+			if (!context.Interpreter.HasTarget || !breakpoint.IsActivated)
+				throw new ScriptingException ("Breakpoint {0} is not active.", id);
+
+			return true;
+		}
+
+		protected override object DoExecute (ScriptingContext context)
+		{
+			context.Interpreter.CurrentThread.SetBreakpointIgnoreCount (breakpoint, count);
+
+			if (count == 0)
+				context.Print ("Breakpoint {0} will stop the next time it is reached.",
+					       breakpoint.Index);
+			else
+				context.Print ("Will ignore next {0} crossings of breakpoint {1}.",
+					       count, breakpoint.Index);
+			return null;
+		}
+
+		public override void Repeat (Interpreter interpreter)
+		{
+			// Do not repeat the ignore command.
+		}
+
+		// IDocumentableCommand
+		public CommandFamily Family { get { return CommandFamily.Breakpoints; } }
+		public string Description { get { return "Ignore the next N hits of a breakpoint."; } }
+		public string Documentation { get { return
+						"Usage: ignore <breakpoint> <count>\n\n" +
+						"The debugger server counts the hits without stopping\n" +
+						"the target, so this is much faster than a condition\n" +
+						"on a counter variable."; } }
+	}
+
 	public abstract class SourceCommand : FrameCommand
 	{
 		protected LocationType type = LocationType.Method;
@@ -3072,6 +3153,80 @@ namespace Mono.Debugger.Frontend
 		}
 	}
 
+	// <summary>
+	//   A breakpoint condition from `break <location> if <expression>'.
+	//   The debugger server evaluates it if the expression can be compiled,
+	//   otherwise we parse and evaluate it each time the breakpoint is hit.
+	// </summary>
+	public class ExpressionCondition : BreakpointCondition
+	{
+		Interpreter interpreter;
+		Expression expression;
+		Hashtable resolved_expressions = new Hashtable ();
+		string text;
+
+		public ExpressionCondition (Interpreter interpreter, string text,
+					    Expression expression)
+		{
+			this.interpreter = interpreter;
+			this.text = text;
+			this.expression = expression;
+		}
+
+		public override string Text {
+			get { return text; }
+		}
+
+		// <summary>
+		//   Resolving an expression binds its variables to `frame's method
+		//   and modifies the tree in place, so we keep the unresolved
+		//   `expression' for Compile() and resolve a copy once per method.
+		// </summary>
+		Expression get_resolved_expression (ScriptingContext context, StackFrame frame)
+		{
+			if (frame.Method == null)
+				return context.ParseExpression (Text).Resolve (context);
+
+			lock (this) {
+				Expression expr = (Expression) resolved_expressions [frame.Method];
+				if (expr != null)
+					return expr;
+
+				expr = context.ParseExpression (Text).Resolve (context);
+				resolved_expressions.Add (frame.Method, expr);
+				return expr;
+			}
+		}
+
+		public override bool Evaluate (StackFrame frame)
+		{
+			ScriptingContext context = new ScriptingContext (interpreter);
+			context.CurrentFrame = frame;
+
+			Expression expr = get_resolved_expression (context, frame);
+
+			object result = expr.Evaluate (context);
+			if (result is TargetFundamentalObject)
+				result = ((TargetFundamentalObject) result).GetObject (frame.Thread);
+
+			if (result is bool)
+				return (bool) result;
+			else if ((result is sbyte) || (result is byte) || (result is short) ||
+				 (result is ushort) || (result is int) || (result is uint) ||
+				 (result is long) || (result is char))
+				return System.Convert.ToInt64 (result) != 0;
+			else if (result is ulong)
+				return (ulong) result != 0;
+
+			throw new ScriptingException ("Expression `{0}' is not a boolean.", Text);
+		}
+
+		public override bool Compile (BreakpointConditionBuilder builder)
+		{
+			return expression.CompileCondition (builder);
+		}
+	}
+
 	public class BreakCommand : DebuggerCommand, IDocumentableCommand
 	{
 		SourceLocation location;
@@ -3083,6 +3238,7 @@ namespace Mono.Debugger.Frontend
 		bool lazy, gui;
 		int domain = 0;
 		ThreadGroup tgroup;
+		string condition;
 
 		public string Group {
 			get { return group; }
@@ -3161,6 +3317,20 @@ namespace Mono.Debugger.Frontend
 
 		protected override bool DoResolve (ScriptingContext context)
 		{
+			int pos_if = Args != null ? Args.IndexOf ("if") : -1;
+			if (pos_if == 0)
+				throw new ScriptingException ("Invalid breakpoint expression");
+			else if (pos_if > 0) {
+				string[] s = (string []) Args.GetRange (
+					pos_if + 1, Args.Count - pos_if - 1).ToArray (typeof (string));
+				condition = String.Join (" ", s);
+				if (condition == "")
+					throw new ScriptingException ("Condition expected");
+
+				Args.RemoveRange (pos_if, Args.Count - pos_if);
+				context.ParseExpression (condition);
+			}
+
 			if (global) {
 				if (local)
 					throw new ScriptingException (
@@ -3284,6 +3454,19 @@ namespace Mono.Debugger.Frontend
 				context.Print ("Breakpoint {0} at {1}", handle.Index, Argument);
 			}
 
+			if (condition != null) {
+				Breakpoint breakpoint = handle as Breakpoint;
+				if (breakpoint == null)
+					throw new ScriptingException (
+						"Cannot use a condition with this breakpoint.");
+
+				breakpoint.Condition = new ExpressionCondition (
+					context.Interpreter, condition,
+					context.ParseExpression (condition));
+				context.Print ("Breakpoint {0} condition: {1}",
+					       handle.Index, condition);
+			}
+
 			if (gui) {
 				context.ActivatePendingBreakpoints ();
 				return handle.Index;
@@ -3845,6 +4028,20 @@ namespace Mono.Debugger.Frontend
 					continue;
 				}
 
+				if (arg.StartsWith ("symbol-cache-dir=")) {
+					config.SymbolIndexCacheDirectory = arg.Substring (17);
+					continue;
+				}
+
+				if (arg.StartsWith ("symbol-cache-size=")) {
+					int size;
+					if (!Int32.TryParse (arg.Substring (18), out size) || (size < 0))
+						throw new ScriptingException ("Invalid 'symbol-cache-size' option '{0}'.",
+									      arg.Substring (18));
+					config.SymbolIndexCacheSize = size;
+					continue;
+				}
+
 				if ((arg [0] != '+') && (arg [0] != '-'))
 					throw new ScriptingException ("Expected `+option' or `-option'.");
 
@@ -3872,6 +4069,14 @@ namespace Mono.Debugger.Frontend
 					config.RedirectOutput = enable;
 					break;
 
+				case "symbol-cache":
+					config.SymbolIndexCache = enable;
+					break;
+
+				case "symtab-stats":
+					config.SymbolTableStatistics = enable;
+					break;
+
 				case "stop-daemon":
 					require_expert_mode ();
 					if (enable)
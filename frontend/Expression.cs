@@ -263,6 +263,15 @@ namespace Mono.Debugger.Frontend
 			}
 		}
 
+		// <summary>
+		//   Compile this (unresolved) expression into a breakpoint condition;
+		//   returns false if that's not possible.
+		// </summary>
+		public virtual bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return false;
+		}
+
 		public override string ToString ()
 		{
 			return String.Format ("{0} ({1})", GetType (), Name);
@@ -357,6 +366,14 @@ namespace Mono.Debugger.Frontend
 			return val;
 		}
 
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			if ((val is int) || (val is uint) || (val is long) || (val is ulong))
+				return builder.EmitConstant (Value);
+
+			return false;
+		}
+
 		public override string ToString ()
 		{
 			return Name;
@@ -435,6 +452,11 @@ namespace Mono.Debugger.Frontend
 			return context.CurrentLanguage.CreateInstance (context.CurrentThread, val);
 		}
 
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return builder.EmitConstant (val ? 1 : 0);
+		}
+
 		public override string ToString ()
 		{
 			return Name;
@@ -535,6 +557,11 @@ namespace Mono.Debugger.Frontend
 		{
 			return var;
 		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return builder.EmitVariable ("this");
+		}
 	}
 
 	public class BaseExpression : ThisExpression
@@ -572,6 +599,11 @@ namespace Mono.Debugger.Frontend
 			TargetClassObject cobj = (TargetClassObject) obj;
 			return cobj.GetParentObject (context.CurrentThread);
 		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return false;
+		}
 	}
 
 	public class CatchExpression : Expression
@@ -898,6 +930,11 @@ namespace Mono.Debugger.Frontend
 
 			return null;
 		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return builder.EmitVariable (name);
+		}
 	}
 
 	public class PointerTypeExpression : TypeExpr
@@ -1110,6 +1147,11 @@ namespace Mono.Debugger.Frontend
 
 			return new TypeExpression (the_type);
 		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return left.CompileCondition (builder) && builder.EmitMember (name);
+		}
 	}
 
 	public abstract class MemberExpression : Expression
@@ -1452,6 +1494,288 @@ namespace Mono.Debugger.Frontend
 			resolved = true;
 			return this;
 		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			if (!left.CompileCondition (builder) || !right.CompileCondition (builder))
+				return false;
+
+			switch (kind) {
+			case Kind.Mult:
+				return builder.EmitOperator (BreakpointConditionOperator.Multiply);
+			case Kind.Plus:
+				return builder.EmitOperator (BreakpointConditionOperator.Add);
+			case Kind.Minus:
+				return builder.EmitOperator (BreakpointConditionOperator.Subtract);
+			case Kind.Div:
+				return builder.EmitOperator (BreakpointConditionOperator.Divide);
+			default:
+				return false;
+			}
+		}
+	}
+
+	public class ComparisonExpression : Expression
+	{
+		public enum Kind { Equal, NotEqual, Less, LessOrEqual, Greater, GreaterOrEqual };
+
+		protected Kind kind;
+		protected Expression left, right;
+
+		public ComparisonExpression (Kind kind, Expression left, Expression right)
+		{
+			this.kind = kind;
+			this.left = left;
+			this.right = right;
+		}
+
+		public override string Name {
+			get {
+				string op;
+				switch (kind) {
+				case Kind.Equal:
+					op = "==";
+					break;
+				case Kind.NotEqual:
+					op = "!=";
+					break;
+				case Kind.Less:
+					op = "<";
+					break;
+				case Kind.LessOrEqual:
+					op = "<=";
+					break;
+				case Kind.Greater:
+					op = ">";
+					break;
+				case Kind.GreaterOrEqual:
+					op = ">=";
+					break;
+				default:
+					throw new InternalError ();
+				}
+				return left.Name + op + right.Name;
+			}
+		}
+
+		// <summary>
+		//   Get the value of @expr as an integer, for comparisons and the
+		//   operands of `&&' and `||'.
+		// </summary>
+		internal static long GetValue (ScriptingContext context, Expression expr)
+		{
+			object val = expr.Evaluate (context);
+		again:
+			if (val is bool)
+				return (bool) val ? 1 : 0;
+			else if (val is char)
+				return (long) (char) val;
+			else if ((val is sbyte) || (val is byte) || (val is short) || (val is ushort) ||
+				 (val is int) || (val is uint) || (val is long))
+				return System.Convert.ToInt64 (val);
+			else if (val is ulong)
+				return (long) (ulong) val;
+			else if (val is NumberExpression)
+				return ((NumberExpression) val).Value;
+			else if (val is TargetPointerObject) {
+				TargetPointerObject pobj = (TargetPointerObject) val;
+				return pobj.GetAddress (context.CurrentThread).Address;
+			} else if (val is TargetFundamentalObject) {
+				TargetFundamentalObject fobj = (TargetFundamentalObject) val;
+				val = fobj.GetObject (context.CurrentThread);
+				if (!(val is TargetFundamentalObject))
+					goto again;
+			}
+
+			throw new ScriptingException ("Cannot evaluate expression `{0}'", expr.Name);
+		}
+
+		protected override object DoEvaluate (ScriptingContext context)
+		{
+			long lvalue = GetValue (context, left);
+			long rvalue = GetValue (context, right);
+
+			switch (kind) {
+			case Kind.Equal:
+				return lvalue == rvalue;
+			case Kind.NotEqual:
+				return lvalue != rvalue;
+			case Kind.Less:
+				return lvalue < rvalue;
+			case Kind.LessOrEqual:
+				return lvalue <= rvalue;
+			case Kind.Greater:
+				return lvalue > rvalue;
+			case Kind.GreaterOrEqual:
+				return lvalue >= rvalue;
+			}
+
+			throw new ScriptingException ("Unknown comparison kind: {0}", kind);
+		}
+
+		protected override TargetObject DoEvaluateObject (ScriptingContext context)
+		{
+			bool result = (bool) DoEvaluate (context);
+
+			if ((context.CurrentLanguage == null) ||
+			    !context.CurrentLanguage.CanCreateInstance (typeof (bool)))
+				throw new ScriptingException ("Cannot instantiate value '{0}' in the current frame's language", Name);
+
+			return context.CurrentLanguage.CreateInstance (context.CurrentThread, result);
+		}
+
+		protected override Expression DoResolve (ScriptingContext context)
+		{
+			left = left.Resolve (context);
+			if (left == null)
+				return null;
+
+			right = right.Resolve (context);
+			if (right == null)
+				return null;
+
+			resolved = true;
+			return this;
+		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			if (!left.CompileCondition (builder) || !right.CompileCondition (builder))
+				return false;
+
+			switch (kind) {
+			case Kind.Equal:
+				return builder.EmitOperator (BreakpointConditionOperator.Equal);
+			case Kind.NotEqual:
+				return builder.EmitOperator (BreakpointConditionOperator.NotEqual);
+			case Kind.Less:
+				return builder.EmitOperator (BreakpointConditionOperator.Less);
+			case Kind.LessOrEqual:
+				return builder.EmitOperator (BreakpointConditionOperator.LessOrEqual);
+			case Kind.Greater:
+				return builder.EmitOperator (BreakpointConditionOperator.Greater);
+			case Kind.GreaterOrEqual:
+				return builder.EmitOperator (BreakpointConditionOperator.GreaterOrEqual);
+			default:
+				return false;
+			}
+		}
+	}
+
+	public class LogicalExpression : Expression
+	{
+		public enum Kind { And, Or };
+
+		protected Kind kind;
+		protected Expression left, right;
+
+		public LogicalExpression (Kind kind, Expression left, Expression right)
+		{
+			this.kind = kind;
+			this.left = left;
+			this.right = right;
+		}
+
+		public override string Name {
+			get {
+				string op = kind == Kind.And ? "&&" : "||";
+				return left.Name + op + right.Name;
+			}
+		}
+
+		protected override object DoEvaluate (ScriptingContext context)
+		{
+			bool lvalue = ComparisonExpression.GetValue (context, left) != 0;
+			if (kind == Kind.And ? !lvalue : lvalue)
+				return lvalue;
+
+			return ComparisonExpression.GetValue (context, right) != 0;
+		}
+
+		protected override TargetObject DoEvaluateObject (ScriptingContext context)
+		{
+			bool result = (bool) DoEvaluate (context);
+
+			if ((context.CurrentLanguage == null) ||
+			    !context.CurrentLanguage.CanCreateInstance (typeof (bool)))
+				throw new ScriptingException ("Cannot instantiate value '{0}' in the current frame's language", Name);
+
+			return context.CurrentLanguage.CreateInstance (context.CurrentThread, result);
+		}
+
+		protected override Expression DoResolve (ScriptingContext context)
+		{
+			left = left.Resolve (context);
+			if (left == null)
+				return null;
+
+			right = right.Resolve (context);
+			if (right == null)
+				return null;
+
+			resolved = true;
+			return this;
+		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			if (!left.CompileCondition (builder))
+				return false;
+
+			int label = builder.BeginLogical (kind == Kind.Or);
+			if (label < 0)
+				return false;
+
+			return right.CompileCondition (builder) && builder.EndLogical (label);
+		}
+	}
+
+	public class LogicalNotExpression : Expression
+	{
+		Expression expr;
+
+		public LogicalNotExpression (Expression expr)
+		{
+			this.expr = expr;
+		}
+
+		public override string Name {
+			get { return "!" + expr.Name; }
+		}
+
+		protected override object DoEvaluate (ScriptingContext context)
+		{
+			return ComparisonExpression.GetValue (context, expr) == 0;
+		}
+
+		protected override TargetObject DoEvaluateObject (ScriptingContext context)
+		{
+			bool result = (bool) DoEvaluate (context);
+
+			if ((context.CurrentLanguage == null) ||
+			    !context.CurrentLanguage.CanCreateInstance (typeof (bool)))
+				throw new ScriptingException ("Cannot instantiate value '{0}' in the current frame's language", Name);
+
+			return context.CurrentLanguage.CreateInstance (context.CurrentThread, result);
+		}
+
+		protected override Expression DoResolve (ScriptingContext context)
+		{
+			expr = expr.Resolve (context);
+			if (expr == null)
+				return null;
+
+			resolved = true;
+			return this;
+		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			if (!expr.CompileCondition (builder))
+				return false;
+
+			return builder.EmitOperator (BreakpointConditionOperator.LogicalNot);
+		}
 	}
 
 	public class TypeOfExpression : Expression
@@ -1557,6 +1881,11 @@ namespace Mono.Debugger.Frontend
 			register.WriteRegister (context.CurrentThread, value);
 			return true;
 		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return builder.EmitRegister (name);
+		}
 	}
 
 	public class StructAccessExpression : MemberExpression
@@ -2024,6 +2353,11 @@ namespace Mono.Debugger.Frontend
 
 			return pobj.GetAddress (context.CurrentThread);
 		}
+
+		public override bool CompileCondition (BreakpointConditionBuilder builder)
+		{
+			return expr.CompileCondition (builder) && builder.EmitDereference ();
+		}
 	}
 
 	public class AddressOfExpression : PointerExpression
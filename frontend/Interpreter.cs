@@ -455,7 +455,37 @@ namespace Mono.Debugger.Frontend
 				       handle.IsActivated ? "y" : "n",
 				       handle.ThreadGroup != null ? handle.ThreadGroup.Name : "global",
 				       handle.Name);
+
+				Breakpoint breakpoint = handle as Breakpoint;
+				if (breakpoint == null)
+					continue;
+
+				if (breakpoint.Condition != null)
+					Print ("{0,33}  if {1}", "", breakpoint.Condition);
+
+				ShowBreakpointStatistics (breakpoint);
+			}
+		}
+
+		void ShowBreakpointStatistics (Breakpoint breakpoint)
+		{
+			if (!HasTarget || !breakpoint.IsActivated)
+				return;
+
+			BreakpointStatistics stats;
+			try {
+				stats = CurrentThread.GetBreakpointStatistics (breakpoint);
+			} catch (TargetException) {
+				return;
 			}
+
+			if ((stats == null) || ((stats.HitCount == 0) && (stats.IgnoreCount == 0)))
+				return;
+
+			Print ("{0,33}  hit {1} times ({2} filtered by the server, {3} reported)",
+			       "", stats.HitCount, stats.FilteredCount, stats.ReportedCount);
+			if (stats.IgnoreCount > 0)
+				Print ("{0,33}  will ignore next {1} hits", "", stats.IgnoreCount);
 		}
 
 		public Event GetEvent (int index)
@@ -258,30 +258,42 @@ namespace Mono.Debugger.Frontend
 				}
 			}
 
-			TargetFieldInfo[] fields = class_info.GetFields (target);
-			for (int i = 0; i < fields.Length; i++) {
-				if (fields [i].IsStatic || fields [i].HasConstValue)
+			ArrayList list = new ArrayList ();
+			foreach (TargetFieldInfo field in class_info.GetFields (target)) {
+				if (field.IsStatic || field.HasConstValue)
 					continue;
-				if (fields [i].IsCompilerGenerated)
+				if (field.IsCompilerGenerated)
 					continue;
-				if (fields [i].DebuggerBrowsableState == DebuggerBrowsableState.Never)
+				if (field.DebuggerBrowsableState == DebuggerBrowsableState.Never)
 					continue;
 
+				list.Add (field);
+			}
+
+			TargetFieldInfo[] fields = (TargetFieldInfo []) list.ToArray (typeof (TargetFieldInfo));
+
+			//
+			// Read all the fields at once; this is a lot faster than asking the
+			// target for each of them.
+			//
+			TargetObject[] values;
+			try {
+				values = class_info.GetFieldValues (target, obj, fields);
+			} catch {
+				values = new TargetObject [fields.Length];
+			}
+
+			for (int i = 0; i < fields.Length; i++) {
 				if (!first) {
 					Append (", ");
 					CheckLineWrap ();
 				}
 				first = false;
 				Append (fields [i].Name + " = ");
-				try {
-					TargetObject fobj = class_info.GetField (target, obj, fields [i]);
-					if (fobj == null)
-						Append ("null");
-					else
-						FormatObjectRecursed (target, fobj, true);
-				} catch {
+				if (values [i] == null)
 					Append ("<cannot display object>");
-				}
+				else
+					FormatObjectRecursed (target, values [i], true);
 			}
 
 			Append (first ? "}" : " }");
@@ -378,6 +390,12 @@ namespace Mono.Debugger.Frontend
 				upper = bounds.UpperBounds [dimension];
 			}
 
+			TargetObject[] elements = null;
+			if ((dimension + 1 == bounds.Rank) && (upper >= lower)) {
+				new_indices [dimension] = lower;
+				elements = aobj.GetElements (target, new_indices, upper - lower + 1);
+			}
+
 			for (int i = lower; i <= upper; i++) {
 				if (!first) {
 					Append (", ");
@@ -388,10 +406,10 @@ namespace Mono.Debugger.Frontend
 				new_indices [dimension] = i;
 				if (dimension + 1 < bounds.Rank)
 					FormatArray (target, aobj, bounds, dimension + 1, new_indices);
-				else {
-					TargetObject eobj = aobj.GetElement (target, new_indices);
-					FormatObjectRecursed (target, eobj, false);
-				}
+				else if (elements [i - lower] == null)
+					Append ("<cannot display object>");
+				else
+					FormatObjectRecursed (target, elements [i - lower], false);
 			}
 
 			Append (first ? "]" : " ]");
@@ -25,7 +25,8 @@ namespace Mono.Debugger
 		Remoting		= 4096,
 		NUnit			= 8192,
 		GUI			= 16384,
-		CLI			= 32768
+		CLI			= 32768,
+		MemoryCache		= 65536
 	}
 
 	public static class Report
@@ -110,6 +111,9 @@ namespace Mono.Debugger
 				case "cli":
 					flags |= DebugFlags.CLI;
 					break;
+				case "memory":
+					flags |= DebugFlags.MemoryCache;
+					break;
 				default:
 					return false;
 				}
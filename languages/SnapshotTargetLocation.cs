@@ -0,0 +1,82 @@
+using System;
+
+using Mono.Debugger.Backend;
+
+namespace Mono.Debugger.Languages
+{
+	// <summary>
+	//   A location in the target whose contents we already read.
+	// </summary>
+	// <remarks>
+	//   This is used when reading all fields of an object or a range of array
+	//   elements at once: we read the whole memory block once and give each
+	//   field a location which points into that block.  Reads which don't fit
+	//   into the block and all writes go to the target; a write also discards
+	//   the cached contents.  The block is only used until the target's
+	//   memory may have changed, see TargetMemoryAccess.MemoryGeneration.
+	// </remarks>
+	internal class SnapshotTargetLocation : TargetLocation
+	{
+		TargetAddress address;
+		TargetBlob blob;
+		int offset;
+		long generation;
+
+		public SnapshotTargetLocation (TargetMemoryAccess target, TargetAddress address,
+					       TargetBlob blob, int offset)
+		{
+			this.address = address;
+			this.blob = blob;
+			this.offset = offset;
+			this.generation = target.MemoryGeneration;
+		}
+
+		internal TargetAddress Address {
+			get { return address; }
+		}
+
+		internal override bool HasAddress {
+			get { return true; }
+		}
+
+		internal override TargetAddress GetAddress (TargetMemoryAccess target)
+		{
+			return address;
+		}
+
+		internal override TargetBlob ReadMemory (TargetMemoryAccess target, int size)
+		{
+			if ((blob == null) || (offset + size > blob.Size) ||
+			    (target.MemoryGeneration != generation))
+				return target.ReadMemory (address, size);
+
+			byte[] data = new byte [size];
+			Array.Copy (blob.Contents, offset, data, 0, size);
+
+			return new TargetBlob (data, blob.TargetMemoryInfo);
+		}
+
+		internal override void WriteBuffer (TargetMemoryAccess target, byte[] data)
+		{
+			blob = null;
+			target.WriteBuffer (address, data);
+		}
+
+		internal override void WriteAddress (TargetMemoryAccess target,
+						     TargetAddress new_address)
+		{
+			blob = null;
+			target.WriteAddress (address, new_address);
+		}
+
+		public override string Print ()
+		{
+			return address.ToString ();
+		}
+
+		protected override string MyToString ()
+		{
+			return String.Format (":{0}:{1}", address, offset);
+		}
+	}
+}
@@ -94,6 +94,41 @@ namespace Mono.Debugger.Languages
 
 		internal abstract TargetObject GetElement (TargetMemoryAccess target, int[] indices);
 
+		// <summary>
+		//   Read @count consecutive elements, starting at @indices, with a
+		//   single access to the target; only the last index is incremented.
+		//   Elements which can't be read are returned as null.
+		// </summary>
+		public TargetObject[] GetElements (Thread thread, int[] indices, int count)
+		{
+			return (TargetObject[]) thread.ThreadServant.DoTargetAccess (
+				delegate (TargetMemoryAccess target) {
+					return GetElements (target, indices, count);
+			});
+		}
+
+		internal virtual TargetObject[] GetElements (TargetMemoryAccess target,
+							     int[] indices, int count)
+		{
+			TargetObject[] elements = new TargetObject [count];
+			int[] current = (int []) indices.Clone ();
+
+			for (int i = 0; i < count; i++) {
+				current [Rank - 1] = indices [Rank - 1] + i;
+				try {
+					elements [i] = GetElement (target, current);
+
+					TargetFundamentalObject fobj = elements [i] as TargetFundamentalObject;
+					if ((fobj != null) && fobj.Type.HasFixedSize)
+						fobj.CacheObject (target);
+				} catch (TargetException) {
+					elements [i] = null;
+				}
+			}
+
+			return elements;
+		}
+
 		public void SetElement (Thread thread, int[] indices, TargetObject obj)
 		{
 			thread.ThreadServant.DoTargetAccess (
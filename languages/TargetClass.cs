@@ -24,6 +24,30 @@ namespace Mono.Debugger.Languages
 						       TargetStructObject instance,
 						       TargetFieldInfo field);
 
+		// <summary>
+		//   Read the values of all @fields of @instance at once.  Fields
+		//   whose value can't be read are returned as null.
+		// </summary>
+		// <remarks>
+		//   Implementations should do this with a single access to the
+		//   target; the returned objects may hold a copy of their contents,
+		//   which they use until the target is resumed.
+		// </remarks>
+		public virtual TargetObject[] GetFieldValues (Thread thread,
+							      TargetStructObject instance,
+							      TargetFieldInfo[] fields)
+		{
+			TargetObject[] values = new TargetObject [fields.Length];
+			for (int i = 0; i < fields.Length; i++) {
+				try {
+					values [i] = GetField (thread, instance, fields [i]);
+				} catch (TargetException) {
+					values [i] = null;
+				}
+			}
+			return values;
+		}
+
 		public abstract void SetField (Thread thread, TargetStructObject instance,
 					       TargetFieldInfo field, TargetObject value);
 
@@ -8,6 +8,8 @@ namespace Mono.Debugger.Languages
 	public class TargetFundamentalObject : TargetObject
 	{
 		new public readonly TargetFundamentalType Type;
+		object cached_value;
+		long cached_generation;
 
 		internal TargetFundamentalObject (TargetFundamentalType type, TargetLocation location)
 			: base (type, location)
@@ -24,17 +26,45 @@ namespace Mono.Debugger.Languages
 
 		public object GetObject (Thread thread)
 		{
+			long generation = thread.ThreadServant.MemoryGeneration;
+			lock (this) {
+				if ((cached_value != null) && (cached_generation == generation))
+					return cached_value;
+			}
+
 			return thread.ThreadServant.DoTargetAccess (
 				delegate (TargetMemoryAccess target) {
-					return DoGetObject (target);
+					return GetObject (target);
 			});
 		}
 
 		internal object GetObject (TargetMemoryAccess target)
 		{
+			long generation = target.MemoryGeneration;
+			lock (this) {
+				if ((cached_value != null) && (cached_generation == generation))
+					return cached_value;
+			}
+
 			return DoGetObject (target);
 		}
 
+		// <summary>
+		//   Read our value now, so GetObject() doesn't have to access the
+		//   target again.  This is used when reading many objects at once;
+		//   the value is only used until the target's memory may have
+		//   changed.
+		// </summary>
+		internal void CacheObject (TargetMemoryAccess target)
+		{
+			long generation = target.MemoryGeneration;
+			object value = DoGetObject (target);
+			lock (this) {
+				cached_value = value;
+				cached_generation = generation;
+			}
+		}
+
 		protected virtual object DoGetObject (TargetMemoryAccess target)
 		{
 			TargetBlob blob = Location.ReadMemory (target, Type.Size);
@@ -110,6 +140,7 @@ namespace Mono.Debugger.Languages
 
 		public void SetObject (Thread thread, TargetObject obj)
 		{
+			cached_value = null;
 			thread.ThreadServant.DoTargetAccess (
 				delegate (TargetMemoryAccess target) {
 					Type.SetObject (target, Location, obj);
@@ -49,6 +49,10 @@ namespace Mono.Debugger.Languages
 			if (!Location.HasAddress)
 				throw new InvalidOperationException ();
 
+			SnapshotTargetLocation snapshot = Location as SnapshotTargetLocation;
+			if (snapshot != null)
+				return snapshot.Address;
+
 			return (TargetAddress) thread.ThreadServant.DoTargetAccess (
 				delegate (TargetMemoryAccess target) {
 					return Location.GetAddress (target);
@@ -43,6 +43,15 @@ namespace Mono.Debugger.Languages
 			get;
 		}
 
+		// <summary>
+		//   The offset of instance field @field from the start of an instance,
+		//   or -1 if it can't be accessed directly.
+		// </summary>
+		internal virtual int GetFieldOffset (TargetMemoryAccess target, TargetFieldInfo field)
+		{
+			return -1;
+		}
+
 		public virtual TargetMemberInfo FindMember (string name, bool search_static,
 							    bool search_instance)
 		{
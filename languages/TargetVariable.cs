@@ -57,5 +57,14 @@ namespace Mono.Debugger.Languages
 		}
 
 		public abstract void SetObject (StackFrame frame, TargetObject obj);
+
+		// <summary>
+		//   Compile this variable's location for a breakpoint condition; see
+		//   BreakpointConditionBuilder.EmitLocation().
+		// </summary>
+		internal virtual bool CompileLocation (BreakpointConditionBuilder builder)
+		{
+			return false;
+		}
 	}
 }
@@ -64,6 +64,71 @@ namespace Mono.Debugger.Languages.Mono
 			return Type.ElementType.GetObject (target, new_loc);
 		}
 
+		internal override TargetObject[] GetElements (TargetMemoryAccess target,
+							      int[] indices, int count)
+		{
+			if (count <= 0)
+				return new TargetObject [0];
+
+			TargetType element_type = Type.ElementType;
+			if (!element_type.IsByRef && !element_type.HasFixedSize)
+				return base.GetElements (target, indices, count);
+
+			int[] last = (int []) indices.Clone ();
+			last [Rank - 1] += count - 1;
+
+			int offset = GetArrayOffset (target, indices);
+			GetArrayOffset (target, last);
+
+			int element_size = Type.GetElementSize (target);
+
+			TargetAddress address;
+			TargetBlob blob;
+			try {
+				TargetLocation dynamic_location;
+				TargetBlob object_blob = Location.ReadMemory (target, Type.Size);
+				GetDynamicSize (target, object_blob, Location, out dynamic_location);
+
+				TargetLocation location = dynamic_location.GetLocationAtOffset (offset);
+				address = location.GetAddress (target);
+				blob = location.ReadMemory (target, count * element_size);
+			} catch (TargetException ex) {
+				throw new LocationInvalidException (ex);
+			}
+
+			TargetBinaryReader reader = blob.GetReader ();
+			TargetObject[] elements = new TargetObject [count];
+
+			for (int i = 0; i < count; i++) {
+				int element_offset = i * element_size;
+				try {
+					if (element_type.IsByRef) {
+						reader.Position = element_offset;
+						TargetAddress reference = new TargetAddress (
+							target.AddressDomain, reader.ReadAddress ());
+						if (reference.IsNull)
+							elements [i] = new TargetNullObject (element_type);
+						else
+							elements [i] = element_type.GetObject (
+								target, new AbsoluteTargetLocation (reference));
+						continue;
+					}
+
+					TargetLocation location = new SnapshotTargetLocation (
+						target, address + element_offset, blob, element_offset);
+					elements [i] = element_type.GetObject (target, location);
+
+					TargetFundamentalObject fobj = elements [i] as TargetFundamentalObject;
+					if ((fobj != null) && fobj.Type.HasFixedSize)
+						fobj.CacheObject (target);
+				} catch (TargetException) {
+					elements [i] = null;
+				}
+			}
+
+			return elements;
+		}
+
 		internal override void SetElement (TargetMemoryAccess target, int[] indices,
 						   TargetObject obj)
 		{
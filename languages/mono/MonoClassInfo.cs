@@ -16,6 +16,7 @@ namespace Mono.Debugger.Languages.Mono
 
 		public readonly Cecil.TypeDefinition CecilType;
 
+		MetadataHelper.MonoClassSnapshot snapshot;
 		TargetType type;
 		IMonoStructType struct_type;
 
@@ -32,12 +33,14 @@ namespace Mono.Debugger.Languages.Mono
 							   TargetMemoryAccess target,
 							   TargetAddress klass)
 		{
-			TargetAddress image = mono.MetadataHelper.MonoClassGetMonoImage (target, klass);
-			MonoSymbolFile file = mono.GetImage (image);
+			MetadataHelper.MonoClassSnapshot snapshot;
+			snapshot = mono.MetadataHelper.GetClassSnapshot (target, klass);
+
+			MonoSymbolFile file = mono.GetImage (snapshot.Image);
 			if (file == null)
 				throw new InternalError ();
 
-			int token = mono.MetadataHelper.MonoClassGetToken (target, klass);
+			int token = snapshot.Token;
 			if ((token & 0xff000000) != 0x02000000)
 				throw new InternalError ();
 
@@ -47,7 +50,7 @@ namespace Mono.Debugger.Languages.Mono
 			if (typedef == null)
 				throw new InternalError ();
 
-			MonoClassInfo info = new MonoClassInfo (file, typedef, target, klass);
+			MonoClassInfo info = new MonoClassInfo (file, typedef, snapshot);
 			if ((file == mono.BuiltinTypes.Corlib) &&
 			    (typedef.FullName == "System.Decimal")) {
 				MonoFundamentalType ftype = mono.BuiltinTypes.DecimalType;
@@ -82,7 +85,8 @@ namespace Mono.Debugger.Languages.Mono
 							  TargetAddress klass,
 							  out MonoClassType type)
 		{
-			MonoClassInfo info = new MonoClassInfo (file, typedef, target, klass);
+			MonoClassInfo info = new MonoClassInfo (
+				file, typedef, file.MonoLanguage.MetadataHelper.GetClassSnapshot (target, klass));
 			type = new MonoClassType (file, typedef, info);
 			((IMonoStructType) type).ClassInfo = info;
 			info.struct_type = type;
@@ -91,15 +95,16 @@ namespace Mono.Debugger.Languages.Mono
 		}
 
 		protected MonoClassInfo (MonoSymbolFile file, Cecil.TypeDefinition typedef,
-					 TargetMemoryAccess target, TargetAddress klass)
+					 MetadataHelper.MonoClassSnapshot snapshot)
 		{
 			this.SymbolFile = file;
-			this.KlassAddress = klass;
+			this.KlassAddress = snapshot.Klass;
 			this.CecilType = typedef;
+			this.snapshot = snapshot;
 
-			parent_klass = MetadataHelper.MonoClassGetParent (target, klass);
-			GenericClass = MetadataHelper.MonoClassGetGenericClass (target, klass);
-			GenericContainer = MetadataHelper.MonoClassGetGenericContainer (target, klass);
+			parent_klass = snapshot.Parent;
+			GenericClass = snapshot.GenericClass;
+			GenericContainer = snapshot.GenericContainer;
 		}
 
 		protected MetadataHelper MetadataHelper {
@@ -120,7 +125,7 @@ namespace Mono.Debugger.Languages.Mono
 
 		internal int GetInstanceSize (TargetMemoryAccess target)
 		{
-			return MetadataHelper.MonoClassGetInstanceSize (target, KlassAddress);
+			return snapshot.GetInstanceSize (target);
 		}
 
 		internal MonoFieldInfo[] GetFields (TargetMemoryAccess target)
@@ -128,8 +133,8 @@ namespace Mono.Debugger.Languages.Mono
 			if (fields != null)
 				return fields;
 
-			int field_count = MetadataHelper.MonoClassGetFieldCount (target, KlassAddress);
-			if ((field_count != 0) && !MetadataHelper.MonoClassHasFields (target, KlassAddress))
+			int field_count = snapshot.GetFieldCount (target);
+			if ((field_count != 0) && !snapshot.HasFields (target))
 				throw new TargetException (TargetError.ClassNotInitialized);
 
 			fields = new MonoFieldInfo [field_count];
@@ -139,12 +144,10 @@ namespace Mono.Debugger.Languages.Mono
 			for (int i = 0; i < field_count; i++) {
 				Cecil.FieldDefinition field = CecilType.Fields [i];
 
-				TargetAddress type_addr = MetadataHelper.MonoClassGetFieldType (
-					target, KlassAddress, i);
+				TargetAddress type_addr = snapshot.GetFieldType (target, i);
 
 				field_types [i] = SymbolFile.MonoLanguage.ReadType (target, type_addr);
-				field_offsets [i] = MetadataHelper.MonoClassGetFieldOffset (
-					target, KlassAddress, i);
+				field_offsets [i] = snapshot.GetFieldOffset (target, i);
 
 				fields [i] = new MonoFieldInfo (struct_type, field_types [i], i, field);
 			}
@@ -186,6 +189,145 @@ namespace Mono.Debugger.Languages.Mono
 			}
 		}
 
+		public override TargetObject[] GetFieldValues (Thread thread,
+							       TargetStructObject instance,
+							       TargetFieldInfo[] fields)
+		{
+			TargetObject[] values = new TargetObject [fields.Length];
+			bool has_instance_fields = false;
+
+			for (int i = 0; i < fields.Length; i++) {
+				if (!fields [i].HasConstValue && !fields [i].IsStatic) {
+					has_instance_fields = true;
+					continue;
+				}
+
+				try {
+					values [i] = GetField (thread, instance, fields [i]);
+				} catch (TargetException) {
+					values [i] = null;
+				}
+			}
+
+			if (!has_instance_fields)
+				return values;
+
+			if (instance == null)
+				throw new InvalidOperationException ();
+
+			thread.ThreadServant.DoTargetAccess (
+				delegate (TargetMemoryAccess target)  {
+					GetInstanceFields (target, instance, fields, values);
+					return null;
+			});
+
+			return values;
+		}
+
+		int get_field_size (TargetMemoryAccess target, int pos)
+		{
+			TargetType type = field_types [pos];
+			if (type.IsByRef)
+				return target.TargetMemoryInfo.TargetAddressSize;
+			else if (type.HasFixedSize)
+				return type.Size;
+			else
+				return -1;
+		}
+
+		// <summary>
+		//   Read all the instance fields in @fields with a single read from
+		//   the target; each field's location points into that block.
+		// </summary>
+		internal void GetInstanceFields (TargetMemoryAccess target, TargetStructObject instance,
+						 TargetFieldInfo[] fields, TargetObject[] values)
+		{
+			GetFields (target);
+
+			int header = 0;
+			if (!Type.IsByRef)
+				header = 2 * target.TargetMemoryInfo.TargetAddressSize;
+
+			int start = Int32.MaxValue, end = 0;
+			for (int i = 0; i < fields.Length; i++) {
+				if (fields [i].HasConstValue || fields [i].IsStatic)
+					continue;
+
+				int pos = fields [i].Position;
+				int size = get_field_size (target, pos);
+				if (size < 0)
+					continue;
+
+				int offset = field_offsets [pos] - header;
+				start = Math.Min (start, offset);
+				end = Math.Max (end, offset + size);
+			}
+
+			TargetAddress address = TargetAddress.Null;
+			TargetBlob blob = null;
+			if ((start < end) && instance.Location.HasAddress) {
+				try {
+					TargetLocation location = instance.Location.GetLocationAtOffset (start);
+					address = location.GetAddress (target);
+					blob = location.ReadMemory (target, end - start);
+				} catch (TargetException) {
+					blob = null;
+				}
+			}
+
+			for (int i = 0; i < fields.Length; i++) {
+				if (fields [i].HasConstValue || fields [i].IsStatic)
+					continue;
+
+				int pos = fields [i].Position;
+				try {
+					if ((blob == null) || (get_field_size (target, pos) < 0))
+						values [i] = GetInstanceField (target, instance, fields [i]);
+					else
+						values [i] = get_snapshot_field (
+							target, pos, address, blob,
+							field_offsets [pos] - header - start);
+
+					TargetFundamentalObject fobj = values [i] as TargetFundamentalObject;
+					if ((fobj != null) && fobj.Type.HasFixedSize)
+						fobj.CacheObject (target);
+				} catch (TargetException) {
+					values [i] = null;
+				}
+			}
+		}
+
+		TargetObject get_snapshot_field (TargetMemoryAccess target, int pos,
+						 TargetAddress address, TargetBlob blob, int offset)
+		{
+			TargetType type = field_types [pos];
+
+			if (!type.IsByRef) {
+				TargetLocation location = new SnapshotTargetLocation (
+					target, address + offset, blob, offset);
+				return type.GetObject (target, location);
+			}
+
+			TargetBinaryReader reader = blob.GetReader ();
+			reader.Position = offset;
+			TargetAddress reference = new TargetAddress (
+				target.AddressDomain, reader.ReadAddress ());
+			if (reference.IsNull)
+				return new TargetNullObject (type);
+
+			return type.GetObject (target, new AbsoluteTargetLocation (reference));
+		}
+
+		internal int GetFieldOffset (TargetMemoryAccess target, TargetFieldInfo field)
+		{
+			GetFields (target);
+
+			int offset = field_offsets [field.Position];
+			if (!Type.IsByRef)
+				offset -= 2 * target.TargetMemoryInfo.TargetAddressSize;
+			return offset;
+		}
+
 		internal TargetObject GetInstanceField (TargetMemoryAccess target,
 							TargetStructObject instance,
 							TargetFieldInfo field)
@@ -217,9 +359,8 @@ namespace Mono.Debugger.Languages.Mono
 			if (!thread.CurrentFrame.Language.IsManaged)
 				throw new TargetException (TargetError.InvalidContext);
 
-			TargetAddress data_address = thread.CallMethod (
-				SymbolFile.MonoLanguage.MonoDebuggerInfo.ClassGetStaticFieldData,
-				KlassAddress, 0);
+			TargetAddress data_address = SymbolFile.MonoLanguage.GetStaticFieldData (
+				thread, KlassAddress);
 
 			return (TargetObject) thread.ThreadServant.DoTargetAccess (
 				delegate (TargetMemoryAccess target) {
@@ -289,9 +430,8 @@ namespace Mono.Debugger.Languages.Mono
 			if (!thread.CurrentFrame.Language.IsManaged)
 				throw new TargetException (TargetError.InvalidContext);
 
-			TargetAddress data_address = thread.CallMethod (
-				SymbolFile.MonoLanguage.MonoDebuggerInfo.ClassGetStaticFieldData,
-				KlassAddress, 0);
+			TargetAddress data_address = SymbolFile.MonoLanguage.GetStaticFieldData (
+				thread, KlassAddress);
 
 			thread.ThreadServant.DoTargetAccess (
 				delegate (TargetMemoryAccess target) {
@@ -346,16 +486,15 @@ namespace Mono.Debugger.Languages.Mono
 				return;
 
 			try {
-				if (!MetadataHelper.MonoClassHasMethods (target, KlassAddress))
+				if (!snapshot.HasMethods (target))
 					return;
 
-				int count = MetadataHelper.MonoClassGetMethodCount (target, KlassAddress);
+				int count = snapshot.GetMethodCount (target);
 
 				methods_by_token = new Dictionary<int,TargetAddress> ();
 
 				for (int i = 0; i < count; i++) {
-					TargetAddress address = MetadataHelper.MonoClassGetMethod (
-						target, KlassAddress, i);
+					TargetAddress address = snapshot.GetMethod (target, i);
 					int mtoken = MetadataHelper.MonoMethodGetToken (target, address);
 					if (mtoken != 0)
 						methods_by_token.Add (mtoken, address);
@@ -397,7 +536,7 @@ namespace Mono.Debugger.Languages.Mono
 
 		void get_parent (TargetMemoryAccess target)
 		{
-			parent_klass = MetadataHelper.MonoClassGetParent (target, KlassAddress);
+			parent_klass = snapshot.Parent;
 			if (parent_klass.IsNull)
 				return;
 
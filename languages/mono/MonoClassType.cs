@@ -198,6 +198,15 @@ namespace Mono.Debugger.Languages.Mono
 			return ResolveClass (target, false);
 		}
 
+		internal override int GetFieldOffset (TargetMemoryAccess target, TargetFieldInfo field)
+		{
+			MonoClassInfo info = ResolveClass (target, false);
+			if (info == null)
+				return -1;
+
+			return info.GetFieldOffset (target, field);
+		}
+
 		public MonoClassInfo ResolveClass (TargetMemoryAccess target, bool fail)
 		{
 			if (resolved)
@@ -105,6 +105,16 @@ namespace Mono.Debugger.Languages.Mono
 				return null;
 		}
 
+		internal override bool CompileLocation (BreakpointConditionBuilder builder)
+		{
+			if (info.Mode == VariableInfo.AddressMode.Register)
+				return builder.EmitLocation (info.Index, info.Offset, false, is_byref, type);
+			else if (info.Mode == VariableInfo.AddressMode.RegOffset)
+				return builder.EmitLocation (info.Index, info.Offset, true, is_byref, type);
+			else
+				return false;
+		}
+
 		public override bool IsInScope (TargetAddress address)
 		{
 			return (address >= start_scope) && (address <= end_scope);
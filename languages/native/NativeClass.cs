@@ -48,6 +48,39 @@ namespace Mono.Debugger.Languages.Native
 			});
 		}
 
+		public override TargetObject[] GetFieldValues (Thread thread,
+							       TargetStructObject instance,
+							       TargetFieldInfo[] fields)
+		{
+			TargetObject[] values = new TargetObject [fields.Length];
+			for (int i = 0; i < fields.Length; i++) {
+				if (fields [i].HasConstValue)
+					values [i] = type.Language.CreateInstance (
+						thread, fields [i].ConstValue);
+			}
+
+			thread.ThreadServant.DoTargetAccess (
+				delegate (TargetMemoryAccess target)  {
+					for (int i = 0; i < fields.Length; i++) {
+						if (fields [i].HasConstValue)
+							continue;
+
+						try {
+							values [i] = GetField (target, instance, fields [i]);
+
+							TargetFundamentalObject fobj = values [i] as TargetFundamentalObject;
+							if ((fobj != null) && fobj.Type.HasFixedSize)
+								fobj.CacheObject (target);
+						} catch (TargetException) {
+							values [i] = null;
+						}
+					}
+					return null;
+			});
+
+			return values;
+		}
+
 		internal TargetObject GetField (TargetMemoryAccess target,
 						TargetStructObject instance,
 						TargetFieldInfo field)
@@ -102,9 +102,17 @@ namespace Mono.Debugger.Languages.Native
 
 		public override TargetType LookupType (string name)
 		{
-			os.ReadNativeTypes ();
-
+			//
+			// Only read the compile units which define `name' instead of
+			// all of them; this may replace an incomplete type we found
+			// earlier with a complete one.
+			//
 			ITypeEntry entry = (ITypeEntry) type_hash [name];
+			if ((entry == null) || !entry.IsComplete) {
+				os.ReadNativeTypes (name);
+				entry = (ITypeEntry) type_hash [name];
+			}
+
 			if (entry == null)
 				return null;
 
@@ -113,11 +121,14 @@ namespace Mono.Debugger.Languages.Native
 
 		public void AddType (ITypeEntry entry)
 		{
-			if (!type_hash.Contains (entry.Name))
-				type_hash.Add (entry.Name, entry);
+			// The DwarfReader may call us from several threads at once.
+			lock (type_hash.SyncRoot) {
+				if (!type_hash.Contains (entry.Name))
+					type_hash.Add (entry.Name, entry);
 
-			if (entry.IsComplete)
-				type_hash [entry.Name] = entry;
+				if (entry.IsComplete)
+					type_hash [entry.Name] = entry;
+			}
 		}
 
 		TargetFundamentalType GetFundamentalType (Type type)
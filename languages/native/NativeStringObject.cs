@@ -19,10 +19,12 @@ namespace Mono.Debugger.Languages.Native
 
 		public static int ChunkSize {
 			get {
-				return 16;
+				return 256;
 			}
 		}
 
+		const int PageSize = 4096;
+
 		protected override object DoGetObject (TargetMemoryAccess target)
 		{
 			try {
@@ -47,7 +49,16 @@ namespace Mono.Debugger.Languages.Native
 
 			while (!done && (offset < MaximumDynamicSize)) {
 				TargetLocation location = start.GetLocationAtOffset (offset);
-				byte[] buffer = location.ReadBuffer (target, ChunkSize);
+
+				// Don't read across a page boundary, the next page may
+				// not be mapped, or beyond the maximum string length.
+				int chunk = System.Math.Min (ChunkSize, MaximumDynamicSize - offset);
+				if (location.HasAddress) {
+					long addr = location.GetAddress (target).Address;
+					chunk = (int) System.Math.Min (chunk, PageSize - (addr & (PageSize - 1)));
+				}
+
+				byte[] buffer = location.ReadBuffer (target, chunk);
 
 				int pos = 0;
 				int size = buffer.Length;
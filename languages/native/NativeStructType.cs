@@ -188,6 +188,15 @@ namespace Mono.Debugger.Languages.Native
 			}
 		}
 
+		internal override int GetFieldOffset (TargetMemoryAccess target, TargetFieldInfo field)
+		{
+			NativeFieldInfo nfield = field as NativeFieldInfo;
+			if ((nfield == null) || nfield.IsBitfield)
+				return -1;
+
+			return nfield.Offset;
+		}
+
 		public override TargetPropertyInfo[] Properties {
 			get {
 				return new TargetPropertyInfo [0];
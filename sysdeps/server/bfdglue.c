@@ -1,6 +1,10 @@
 #include <bfdglue.h>
 #include <signal.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #if defined(__linux__) || defined(__FreeBSD__)
 #include <link.h>
 #include <elf.h>
@@ -65,14 +69,11 @@ bfd_glue_get_symbols (bfd *abfd, asymbol ***symbol_table)
 	return bfd_canonicalize_symtab (abfd, *symbol_table);
 }
 
-gchar *
-bfd_glue_get_symbol (bfd *abfd, asymbol **symbol_table, int idx, int *is_function, guint64 *address)
+static const char *
+get_symbol_info (asymbol *symbol, int *is_function, guint64 *address)
 {
-	asymbol *symbol;
 	int flags;
 
-	symbol = symbol_table [idx];
-
 	if ((symbol->flags & (BSF_WEAK | BSF_DYNAMIC)) == (BSF_WEAK | BSF_DYNAMIC))
 		return NULL;
 	if ((symbol->flags & BSF_DEBUGGING) || !symbol->name || !strlen (symbol->name))
@@ -108,7 +109,107 @@ bfd_glue_get_symbol (bfd *abfd, asymbol **symbol_table, int idx, int *is_functio
 		*address = symbol->section->vma + symbol->value;
 	}
 
-	return g_strdup (symbol->name);
+	return symbol->name;
+}
+
+gchar *
+bfd_glue_get_symbol (bfd *abfd, asymbol **symbol_table, int idx, int *is_function, guint64 *address)
+{
+	const char *name;
+
+	name = get_symbol_info (symbol_table [idx], is_function, address);
+	if (!name)
+		return NULL;
+
+	return g_strdup (name);
+}
+
+/*
+ * 32-bit FNV-1a; Bfd.cs computes the same hash for the names it looks up.
+ */
+static guint32
+hash_symbol_name (const char *name)
+{
+	guint32 hash = 2166136261U;
+
+	for (; *name; name++) {
+		hash ^= (guint8) *name;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static void
+export_symbol_table (asymbol **symbol_table, int count, guint32 extra_flags,
+		     gboolean strip_leading_underscore, GArray *records, GString *pool)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		BfdGlueSymbol record;
+		const char *name;
+		int is_function;
+		guint64 address;
+
+		name = get_symbol_info (symbol_table [i], &is_function, &address);
+		if (!name)
+			continue;
+
+		if (strip_leading_underscore && (name [0] == '_'))
+			name++;
+
+		record.address = address;
+		record.name_offset = pool->len;
+		record.name_hash = hash_symbol_name (name);
+		record.flags = extra_flags;
+		if (is_function)
+			record.flags |= SYMBOL_FLAGS_FUNCTION;
+		record.reserved = 0;
+
+		g_array_append_val (records, record);
+		g_string_append_len (pool, name, strlen (name) + 1);
+	}
+}
+
+gpointer
+bfd_glue_export_symbols (bfd *abfd, gboolean strip_leading_underscore, guint32 *num_symbols,
+			 guint32 *size)
+{
+	asymbol **symbol_table;
+	GArray *records;
+	GString *pool;
+	gsize records_size;
+	guint8 *buffer;
+	int count;
+
+	records = g_array_new (FALSE, FALSE, sizeof (BfdGlueSymbol));
+	pool = g_string_new (NULL);
+
+	count = bfd_glue_get_symbols (abfd, &symbol_table);
+	if (count > 0)
+		export_symbol_table (symbol_table, count, 0, strip_leading_underscore,
+				     records, pool);
+	g_free (symbol_table);
+
+	count = bfd_glue_get_dynamic_symbols (abfd, &symbol_table);
+	if (count > 0)
+		export_symbol_table (symbol_table, count, SYMBOL_FLAGS_DYNAMIC, FALSE,
+				     records, pool);
+	g_free (symbol_table);
+
+	records_size = records->len * sizeof (BfdGlueSymbol);
+
+	buffer = g_malloc (records_size + pool->len);
+	memcpy (buffer, records->data, records_size);
+	memcpy (buffer + records_size, pool->str, pool->len);
+
+	*num_symbols = records->len;
+	*size = records_size + pool->len;
+
+	g_array_free (records, TRUE);
+	g_string_free (pool, TRUE);
+	return buffer;
 }
 
 int
@@ -213,6 +314,101 @@ bfd_glue_get_section_contents (bfd *abfd, asection *section, gpointer data, guin
 	return bfd_get_section_contents (abfd, section, data, 0, size);
 }
 
+/*
+ * Map the file region backing `section' read-only into memory.  Returns a
+ * pointer to the section's contents and stores the start and size of the
+ * whole mapping (which is page-aligned) in `map_start' and `map_size', or
+ * returns NULL if the section can't be used directly from the file; the
+ * caller must then fall back to bfd_glue_get_section_contents().
+ */
+gpointer
+bfd_glue_map_section (bfd *abfd, asection *section, gpointer *map_start, guint64 *map_size)
+{
+	const char *filename;
+	file_ptr offset, aligned_offset;
+	bfd_size_type size;
+	long page_size;
+	gpointer start;
+	int fd;
+
+	*map_start = NULL;
+	*map_size = 0;
+
+	/* Relocated or compressed sections differ from what's in the file. */
+	if (!(section->flags & SEC_HAS_CONTENTS) || (section->flags & (SEC_RELOC | SEC_IN_MEMORY)))
+		return NULL;
+	if (!strncmp (section->name, ".zdebug", 7))
+		return NULL;
+
+	size = section->_raw_size;
+	if (!size)
+		return NULL;
+
+	filename = abfd->my_archive ? abfd->my_archive->filename : abfd->filename;
+	if (!filename)
+		return NULL;
+
+	offset = section->filepos + abfd->origin;
+
+	page_size = sysconf (_SC_PAGESIZE);
+	aligned_offset = offset & ~((file_ptr) page_size - 1);
+
+	fd = open (filename, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	start = mmap (NULL, size + (offset - aligned_offset), PROT_READ, MAP_PRIVATE,
+		      fd, aligned_offset);
+	close (fd);
+
+	if (start == MAP_FAILED)
+		return NULL;
+
+	*map_start = start;
+	*map_size = size + (offset - aligned_offset);
+
+	return (guint8 *) start + (offset - aligned_offset);
+}
+
+void
+bfd_glue_unmap_section (gpointer map_start, guint64 map_size)
+{
+	munmap (map_start, map_size);
+}
+
+/*
+ * Map all of `filename' read-only into memory; used for core files, which
+ * may be much larger than anything we'd want to read into a buffer.  Use
+ * bfd_glue_unmap_section() to unmap it again.
+ */
+gpointer
+bfd_glue_map_file (const char *filename, guint64 *size)
+{
+	struct stat statb;
+	gpointer start;
+	int fd;
+
+	*size = 0;
+
+	fd = open (filename, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	if ((fstat (fd, &statb) < 0) || !statb.st_size) {
+		close (fd);
+		return NULL;
+	}
+
+	start = mmap (NULL, statb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close (fd);
+
+	if (start == MAP_FAILED)
+		return NULL;
+
+	*size = statb.st_size;
+	return start;
+}
+
 asection *
 bfd_glue_get_first_section (bfd *abfd)
 {
@@ -25,6 +25,28 @@ bfd_glue_get_symbol (bfd *abfd, asymbol **symbol_table, int idx, int *is_functio
 extern int
 bfd_glue_get_dynamic_symbols (bfd *abfd, asymbol ***symbol_table);
 
+typedef enum {
+	SYMBOL_FLAGS_FUNCTION	= 1,
+	SYMBOL_FLAGS_DYNAMIC	= 2
+} BfdGlueSymbolFlags;
+
+/*
+ * bfd_glue_export_symbols() returns an array of these, followed by a pool
+ * of NUL-terminated names which `name_offset' points into.  Keep this in
+ * sync with Bfd.cs.
+ */
+typedef struct {
+	guint64 address;
+	guint32 name_offset;
+	guint32 name_hash;
+	guint32 flags;
+	guint32 reserved;
+} BfdGlueSymbol;
+
+extern gpointer
+bfd_glue_export_symbols (bfd *abfd, gboolean strip_leading_underscore, guint32 *num_symbols,
+			 guint32 *size);
+
 typedef int (*BfdGlueReadMemoryHandler) (guint64 address, bfd_byte *buffer, int size);
 typedef void (*BfdGlueOutputHandler) (const char *output);
 typedef void (*BfdGluePrintAddressHandler) (guint64 address);
@@ -55,6 +77,15 @@ typedef enum {
 	SECTION_FLAGS_READONLY	= 4
 } BfdGlueSectionFlags;
 
+extern gpointer
+bfd_glue_map_section (bfd *abfd, asection *section, gpointer *map_start, guint64 *map_size);
+
+extern void
+bfd_glue_unmap_section (gpointer map_start, guint64 map_size);
+
+extern gpointer
+bfd_glue_map_file (const char *filename, guint64 *size);
+
 extern bfd *
 bfd_glue_openr (const char *filename, const char *target);
 
@@ -36,6 +36,19 @@ mono_debugger_breakpoint_manager_clone (BreakpointManager *old)
 		BreakpointInfo *old_info = g_ptr_array_index (old->breakpoints, i);
 		BreakpointInfo *info = g_memdup (old_info, sizeof (BreakpointInfo));
 
+		if (old_info->condition)
+			info->condition = g_memdup (old_info->condition, old_info->condition_size);
+
+		/*
+		 * The new process doesn't know about our code buffer slots, so it
+		 * must step over the breakpoint the slow way.
+		 */
+		info->resume_address = 0;
+		info->resume_slots = 0;
+
+		info->hit_count = 0;
+		info->filtered_count = 0;
+
 		mono_debugger_breakpoint_manager_insert (bpm, info);
 	}
 
@@ -103,6 +116,7 @@ mono_debugger_breakpoint_manager_remove (BreakpointManager *bpm, BreakpointInfo
 	g_hash_table_remove (bpm->breakpoint_hash, GSIZE_TO_POINTER (breakpoint->id));
 	g_hash_table_remove (bpm->breakpoint_by_addr, GSIZE_TO_POINTER (breakpoint->address));
 	g_ptr_array_remove_fast (bpm->breakpoints, breakpoint);
+	g_free (breakpoint->condition);
 	g_free (breakpoint);
 }
 
@@ -123,3 +137,239 @@ mono_debugger_breakpoint_info_get_is_enabled (BreakpointInfo *info)
 {
 	return info->enabled;
 }
+
+void
+mono_debugger_breakpoint_info_set_condition (BreakpointInfo *info, const guint8 *code, guint32 size)
+{
+	g_free (info->condition);
+
+	if (size) {
+		info->condition = g_memdup (code, size);
+		info->condition_size = size;
+	} else {
+		info->condition = NULL;
+		info->condition_size = 0;
+	}
+}
+
+#define CONDITION_STACK_SIZE	32
+
+static gint64
+read_immediate (const guint8 *code, int size)
+{
+	guint64 value = 0;
+	int i;
+
+	for (i = size - 1; i >= 0; i--)
+		value = (value << 8) | code [i];
+
+	return (gint64) value;
+}
+
+static gint64
+extend_value (gint64 value, int size, gboolean is_signed)
+{
+	int shift;
+
+	if ((size <= 0) || (size >= 8))
+		return value;
+
+	shift = 64 - 8 * size;
+	if (is_signed)
+		return (value << shift) >> shift;
+	else
+		return (gint64) (((guint64) value << shift) >> shift);
+}
+
+/*
+ * Run the breakpoint's condition.  We never fail: if the condition can't be
+ * evaluated, we return BREAKPOINT_CONDITION_NONE and let the debugger deal
+ * with it.
+ */
+BreakpointConditionResult
+mono_debugger_breakpoint_info_evaluate_condition (BreakpointInfo *info, const guint64 *registers,
+						  guint32 num_registers, BreakpointReadMemoryFunc read_memory,
+						  gpointer user_data)
+{
+	gint64 stack [CONDITION_STACK_SIZE];
+	const guint8 *code = info->condition;
+	guint32 size = info->condition_size;
+	guint32 pc = 0;
+	int sp = 0;
+
+	if (!code)
+		return BREAKPOINT_CONDITION_NONE;
+
+	while (pc < size) {
+		BreakpointConditionOpcode opcode = code [pc++];
+		gint64 a, b;
+
+		switch (opcode) {
+		case BREAKPOINT_OP_END:
+			if (sp != 1)
+				return BREAKPOINT_CONDITION_NONE;
+			return stack [0] ? BREAKPOINT_CONDITION_TRUE : BREAKPOINT_CONDITION_FALSE;
+
+		case BREAKPOINT_OP_CONST:
+			if ((pc + 8 > size) || (sp >= CONDITION_STACK_SIZE))
+				return BREAKPOINT_CONDITION_NONE;
+			stack [sp++] = read_immediate (code + pc, 8);
+			pc += 8;
+			continue;
+
+		case BREAKPOINT_OP_REGISTER:
+			if ((pc + 1 > size) || (code [pc] >= num_registers) ||
+			    (sp >= CONDITION_STACK_SIZE))
+				return BREAKPOINT_CONDITION_NONE;
+			stack [sp++] = (gint64) registers [code [pc++]];
+			continue;
+
+		case BREAKPOINT_OP_LOAD: {
+			guint8 buffer [8];
+			int count;
+
+			if ((pc + 2 > size) || (sp < 1))
+				return BREAKPOINT_CONDITION_NONE;
+			count = code [pc];
+			if ((count < 1) || (count > 8))
+				return BREAKPOINT_CONDITION_NONE;
+			if (!read_memory (user_data, (guint64) stack [sp-1], count, buffer))
+				return BREAKPOINT_CONDITION_NONE;
+			stack [sp-1] = extend_value (read_immediate (buffer, count), count, code [pc+1]);
+			pc += 2;
+			continue;
+		}
+
+		case BREAKPOINT_OP_EXTEND:
+			if ((pc + 2 > size) || (sp < 1))
+				return BREAKPOINT_CONDITION_NONE;
+			stack [sp-1] = extend_value (stack [sp-1], code [pc], code [pc+1]);
+			pc += 2;
+			continue;
+
+		case BREAKPOINT_OP_NEG:
+		case BREAKPOINT_OP_NOT:
+		case BREAKPOINT_OP_LOGICAL_NOT:
+			if (sp < 1)
+				return BREAKPOINT_CONDITION_NONE;
+			a = stack [sp-1];
+			if (opcode == BREAKPOINT_OP_NEG)
+				stack [sp-1] = -a;
+			else if (opcode == BREAKPOINT_OP_NOT)
+				stack [sp-1] = ~a;
+			else
+				stack [sp-1] = !a;
+			continue;
+
+		case BREAKPOINT_OP_AND_THEN:
+		case BREAKPOINT_OP_OR_ELSE: {
+			guint32 offset;
+
+			if ((pc + 2 > size) || (sp < 1))
+				return BREAKPOINT_CONDITION_NONE;
+			offset = (guint32) read_immediate (code + pc, 2);
+			pc += 2;
+
+			/*
+			 * If the left side already decides the result, leave it on
+			 * the stack and skip the right side.
+			 */
+			if ((opcode == BREAKPOINT_OP_AND_THEN) ? !stack [sp-1] : (stack [sp-1] != 0)) {
+				stack [sp-1] = (stack [sp-1] != 0);
+				pc += offset;
+			} else
+				sp--;
+			continue;
+		}
+
+		default:
+			break;
+		}
+
+		if (sp < 2)
+			return BREAKPOINT_CONDITION_NONE;
+		b = stack [--sp];
+		a = stack [sp-1];
+
+		switch (opcode) {
+		case BREAKPOINT_OP_ADD:
+			a += b;
+			break;
+		case BREAKPOINT_OP_SUB:
+			a -= b;
+			break;
+		case BREAKPOINT_OP_MUL:
+			a *= b;
+			break;
+		case BREAKPOINT_OP_DIV:
+		case BREAKPOINT_OP_REM:
+			if ((b == 0) || ((b == -1) && (a == G_MININT64)))
+				return BREAKPOINT_CONDITION_NONE;
+			a = (opcode == BREAKPOINT_OP_DIV) ? a / b : a % b;
+			break;
+		case BREAKPOINT_OP_DIV_UN:
+		case BREAKPOINT_OP_REM_UN:
+			if (b == 0)
+				return BREAKPOINT_CONDITION_NONE;
+			if (opcode == BREAKPOINT_OP_DIV_UN)
+				a = (gint64) ((guint64) a / (guint64) b);
+			else
+				a = (gint64) ((guint64) a % (guint64) b);
+			break;
+		case BREAKPOINT_OP_AND:
+			a &= b;
+			break;
+		case BREAKPOINT_OP_OR:
+			a |= b;
+			break;
+		case BREAKPOINT_OP_XOR:
+			a ^= b;
+			break;
+		case BREAKPOINT_OP_SHL:
+			a = (gint64) ((guint64) a << (b & 63));
+			break;
+		case BREAKPOINT_OP_SHR:
+			a >>= (b & 63);
+			break;
+		case BREAKPOINT_OP_SHR_UN:
+			a = (gint64) ((guint64) a >> (b & 63));
+			break;
+		case BREAKPOINT_OP_EQ:
+			a = a == b;
+			break;
+		case BREAKPOINT_OP_NE:
+			a = a != b;
+			break;
+		case BREAKPOINT_OP_LT:
+			a = a < b;
+			break;
+		case BREAKPOINT_OP_LE:
+			a = a <= b;
+			break;
+		case BREAKPOINT_OP_GT:
+			a = a > b;
+			break;
+		case BREAKPOINT_OP_GE:
+			a = a >= b;
+			break;
+		case BREAKPOINT_OP_LT_UN:
+			a = (guint64) a < (guint64) b;
+			break;
+		case BREAKPOINT_OP_LE_UN:
+			a = (guint64) a <= (guint64) b;
+			break;
+		case BREAKPOINT_OP_GT_UN:
+			a = (guint64) a > (guint64) b;
+			break;
+		case BREAKPOINT_OP_GE_UN:
+			a = (guint64) a >= (guint64) b;
+			break;
+		default:
+			return BREAKPOINT_CONDITION_NONE;
+		}
+
+		stack [sp-1] = a;
+	}
+
+	return BREAKPOINT_CONDITION_NONE;
+}
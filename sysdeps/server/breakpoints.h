@@ -18,6 +18,57 @@ typedef enum {
 	HARDWARE_BREAKPOINT_WRITE
 } HardwareBreakpointType;
 
+/*
+ * Breakpoint conditions are compiled by the debugger into code for a small
+ * stack machine; all values on the stack are 64-bit integers and immediate
+ * operands are stored in little-endian order.
+ */
+typedef enum {
+	BREAKPOINT_OP_END = 0,
+	BREAKPOINT_OP_CONST,		/* gint64 value */
+	BREAKPOINT_OP_REGISTER,		/* guint8 register */
+	BREAKPOINT_OP_LOAD,		/* guint8 size, guint8 is_signed; pops the address */
+	BREAKPOINT_OP_EXTEND,		/* guint8 size, guint8 is_signed */
+	BREAKPOINT_OP_ADD,
+	BREAKPOINT_OP_SUB,
+	BREAKPOINT_OP_MUL,
+	BREAKPOINT_OP_DIV,
+	BREAKPOINT_OP_REM,
+	BREAKPOINT_OP_AND,
+	BREAKPOINT_OP_OR,
+	BREAKPOINT_OP_XOR,
+	BREAKPOINT_OP_SHL,
+	BREAKPOINT_OP_SHR,
+	BREAKPOINT_OP_NEG,
+	BREAKPOINT_OP_NOT,
+	BREAKPOINT_OP_LOGICAL_NOT,
+	BREAKPOINT_OP_EQ,
+	BREAKPOINT_OP_NE,
+	BREAKPOINT_OP_LT,
+	BREAKPOINT_OP_LE,
+	BREAKPOINT_OP_GT,
+	BREAKPOINT_OP_GE,
+	BREAKPOINT_OP_AND_THEN,		/* guint16 offset; skip the rest of an `&&' if false */
+	BREAKPOINT_OP_OR_ELSE,		/* guint16 offset; skip the rest of an `||' if true */
+	BREAKPOINT_OP_LT_UN,		/* like the signed ones, but treat both operands as guint64 */
+	BREAKPOINT_OP_LE_UN,
+	BREAKPOINT_OP_GT_UN,
+	BREAKPOINT_OP_GE_UN,
+	BREAKPOINT_OP_DIV_UN,
+	BREAKPOINT_OP_REM_UN,
+	BREAKPOINT_OP_SHR_UN
+} BreakpointConditionOpcode;
+
+typedef enum {
+	BREAKPOINT_CONDITION_NONE = 0,
+	BREAKPOINT_CONDITION_TRUE,
+	BREAKPOINT_CONDITION_FALSE,
+	BREAKPOINT_CONDITION_IGNORED
+} BreakpointConditionResult;
+
+typedef gboolean (*BreakpointReadMemoryFunc) (gpointer user_data, guint64 address,
+					       guint32 size, gpointer buffer);
+
 typedef struct {
 	HardwareBreakpointType type;
 	int id;
@@ -28,6 +79,28 @@ typedef struct {
 	char saved_insn;
 	int runtime_table_slot;
 	guint64 address;
+
+	/*
+	 * The compiled condition, if any.  `resume_address' points to a copy of the
+	 * original instruction followed by a jump back, so a thread can continue
+	 * without removing the breakpoint; it occupies `resume_slots' slots of the
+	 * runtime's executable code buffer, starting at `resume_slot'.
+	 */
+	guint8 *condition;
+	guint32 condition_size;
+	guint64 resume_address;
+	int resume_slot;
+	int resume_slots;
+
+	/*
+	 * `hit_count' counts the times we hit the breakpoint while its condition
+	 * was true (or if it has none), `filtered_count' the ones where we resumed
+	 * the target without reporting the stop.  While `ignore_count' is non-zero,
+	 * we decrement it instead of reporting such a hit.
+	 */
+	guint32 hit_count;
+	guint32 filtered_count;
+	guint32 ignore_count;
 } BreakpointInfo;
 
 BreakpointManager *
@@ -69,6 +142,14 @@ mono_debugger_breakpoint_info_get_id                 (BreakpointInfo *info);
 gboolean
 mono_debugger_breakpoint_info_get_is_enabled         (BreakpointInfo *info);
 
+void
+mono_debugger_breakpoint_info_set_condition          (BreakpointInfo *info, const guint8 *code, guint32 size);
+
+BreakpointConditionResult
+mono_debugger_breakpoint_info_evaluate_condition     (BreakpointInfo *info, const guint64 *registers,
+						      guint32 num_registers, BreakpointReadMemoryFunc read_memory,
+						      gpointer user_data);
+
 G_END_DECLS
 
 #endif
@@ -234,6 +234,21 @@ server_ptrace_read_memory (ServerHandle *handle, guint64 start, guint32 size, gp
 	return COMMAND_ERROR_NONE;
 }
 
+static ServerCommandError
+server_ptrace_read_memory_vectored (ServerHandle *handle, guint32 count, const guint64 *addresses,
+				    const guint32 *sizes, gpointer buffer, guint32 *status)
+{
+	guint8 *ptr = buffer;
+	guint32 i;
+
+	for (i = 0; i < count; i++) {
+		status [i] = server_ptrace_read_memory (handle, addresses [i], sizes [i], ptr);
+		ptr += sizes [i];
+	}
+
+	return COMMAND_ERROR_NONE;
+}
+
 static ServerCommandError
 _server_ptrace_make_memory_executable (ServerHandle *handle, guint64 start, guint32 size)
 {
@@ -956,6 +971,8 @@ server_ptrace_continue (ServerHandle *handle)
 	struct thread_basic_info th_info;
 	unsigned int info_count = THREAD_BASIC_INFO_COUNT;
 
+	x86_arch_invalidate_registers (handle);
+
 	/* Clear trap flag, if in case it had been set in server_ptrace_step */
 	_server_ptrace_get_registers(inferior, &regs);
 	regs.eflags &= ~0x100UL;
@@ -1014,6 +1031,8 @@ server_ptrace_step (ServerHandle *handle)
 	kern_return_t err;
 	INFERIOR_REGS_TYPE regs;
 	int i;
+
+	x86_arch_invalidate_registers (handle);
 	
 	/* 
 	 * PT_STEP seems to be badly broken on OS X in multi-threaded environments.
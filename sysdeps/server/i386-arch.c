@@ -28,6 +28,7 @@ struct ArchInfo
 	GPtrArray *callback_stack;
 	CodeBufferData *code_buffer;
 	guint64 dr_control, dr_status;
+	gboolean regs_valid, fpregs_valid;
 	BreakpointManager *hw_bpm;
 	int dr_regs [DR_NADDR];
 };
@@ -114,9 +115,11 @@ server_ptrace_get_frame (ServerHandle *handle, StackFrame *frame)
 {
 	ServerCommandError result;
 
-	result = x86_arch_get_registers (handle);
-	if (result != COMMAND_ERROR_NONE)
-		return result;
+	if (!handle->arch->regs_valid) {
+		result = x86_arch_get_registers (handle);
+		if (result != COMMAND_ERROR_NONE)
+			return result;
+	}
 
 	frame->address = (guint32) INFERIOR_REG_EIP (handle->arch->current_regs);
 	frame->stack_pointer = (guint32) INFERIOR_REG_ESP (handle->arch->current_regs);
@@ -145,6 +148,10 @@ server_ptrace_call_method (ServerHandle *handle, guint64 method_address,
 			  0x00, 0xcc };
 	int size = sizeof (code);
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 
 	new_esp = (guint32) INFERIOR_REG_ESP (arch->current_regs) - size;
@@ -213,6 +220,10 @@ server_ptrace_call_method_1 (ServerHandle *handle, guint64 method_address,
 	memcpy (code, static_code, static_size);
 	strcpy ((char *) (code + static_size), string_argument);
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 
 	new_esp = (guint32) INFERIOR_REG_ESP (arch->current_regs) - size;
@@ -285,6 +296,10 @@ server_ptrace_call_method_2 (ServerHandle *handle, guint64 method_address,
 	*((guint32 *) (code+52)) = INFERIOR_REG_EIP (arch->current_regs);
 	*((guint8 *) (code+data_size+56)) = 0xcc;
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 	memcpy (&cdata->saved_regs, &arch->current_regs, sizeof (arch->current_regs));
 	memcpy (&cdata->saved_fpregs, &arch->current_fpregs, sizeof (arch->current_fpregs));
@@ -359,6 +374,10 @@ server_ptrace_call_method_3 (ServerHandle *handle, guint64 method_address,
 	*((guint32 *) (code+12)) = effective_address;
 	*((guint32 *) (code+20)) = new_esp;
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 	memcpy (&cdata->saved_regs, &arch->current_regs, sizeof (arch->current_regs));
 	memcpy (&cdata->saved_fpregs, &arch->current_fpregs, sizeof (arch->current_fpregs));
@@ -434,6 +453,10 @@ server_ptrace_call_method_invoke (ServerHandle *handle, guint64 invoke_method,
 	*((guint32 *) (code+12)) = new_esp + static_size + blob_size + 4;
 	*((guint32 *) (code+16)) = new_esp + 20;
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 	memcpy (&cdata->saved_regs, &arch->current_regs, sizeof (arch->current_regs));
 	memcpy (&cdata->saved_fpregs, &arch->current_fpregs, sizeof (arch->current_fpregs));
@@ -527,23 +550,59 @@ get_callback_data (ArchInfo *arch)
 static ServerCommandError
 x86_arch_get_registers (ServerHandle *handle)
 {
+	ArchInfo *arch = handle->arch;
 	ServerCommandError result;
 
-	result = _server_ptrace_get_registers (handle->inferior, &handle->arch->current_regs);
+	result = _server_ptrace_get_registers (handle->inferior, &arch->current_regs);
 	if (result != COMMAND_ERROR_NONE)
 		return result;
 
-	result = _server_ptrace_get_fp_registers (handle->inferior, &handle->arch->current_fpregs);
+	arch->regs_valid = TRUE;
+	arch->fpregs_valid = FALSE;
+
+	/*
+	 * DR_STATUS can only be set if we armed a hardware breakpoint.
+	 */
+	if (!X86_DR_ARMED (arch)) {
+		arch->dr_status = 0;
+		return COMMAND_ERROR_NONE;
+	}
+
+	result = _server_ptrace_get_dr (handle->inferior, DR_STATUS, &arch->dr_status);
 	if (result != COMMAND_ERROR_NONE)
 		return result;
 
-	result = _server_ptrace_get_dr (handle->inferior, DR_STATUS, &handle->arch->dr_status);
+	return COMMAND_ERROR_NONE;
+}
+
+/*
+ * The FP registers are only needed when saving the state for a callback,
+ * so only fetch them once per stop and only when asked for.
+ */
+static ServerCommandError
+x86_arch_get_fp_registers (ServerHandle *handle)
+{
+	ArchInfo *arch = handle->arch;
+	ServerCommandError result;
+
+	if (arch->fpregs_valid)
+		return COMMAND_ERROR_NONE;
+
+	result = _server_ptrace_get_fp_registers (handle->inferior, &arch->current_fpregs);
 	if (result != COMMAND_ERROR_NONE)
 		return result;
 
+	arch->fpregs_valid = TRUE;
 	return COMMAND_ERROR_NONE;
 }
 
+static void
+x86_arch_invalidate_registers (ServerHandle *handle)
+{
+	handle->arch->regs_valid = FALSE;
+	handle->arch->fpregs_valid = FALSE;
+}
+
 ChildStoppedAction
 x86_arch_child_stopped (ServerHandle *handle, int stopsig,
 			guint64 *callback_arg, guint64 *retval, guint64 *retval2,
@@ -553,13 +612,24 @@ x86_arch_child_stopped (ServerHandle *handle, int stopsig,
 	InferiorHandle *inferior = handle->inferior;
 	CodeBufferData *cbuffer = NULL;
 	CallbackData *cdata;
-	guint64 code;
+	guint64 code, resume_ip;
 	int i;
 
 	x86_arch_get_registers (handle);
 
-	if (stopsig == SIGSTOP)
+	/*
+	 * We stopped while executing the resume code of a conditional breakpoint,
+	 * so make it look like we're still in the original code.
+	 */
+	if (_server_ptrace_get_resume_code_address (handle, INFERIOR_REG_EIP (arch->current_regs), &resume_ip)) {
+		INFERIOR_REG_EIP (arch->current_regs) = resume_ip;
+		_server_ptrace_set_registers (inferior, &arch->current_regs);
+	}
+
+	if (stopsig == SIGSTOP) {
+		inferior->stop_pending = FALSE;
 		return STOP_ACTION_INTERRUPTED;
+	}
 
 #if defined(__linux__) || defined(__FreeBSD__)
 	if (stopsig != SIGTRAP)
@@ -594,8 +664,20 @@ x86_arch_child_stopped (ServerHandle *handle, int stopsig,
 	}
 
 	if (check_breakpoint (handle, (guint32) INFERIOR_REG_EIP (arch->current_regs) - 1, retval)) {
+		BreakpointConditionResult condition;
+
 		INFERIOR_REG_EIP (arch->current_regs)--;
+
+		condition = _server_ptrace_check_breakpoint_condition (handle, *retval);
+		if (((condition == BREAKPOINT_CONDITION_FALSE) ||
+		     (condition == BREAKPOINT_CONDITION_IGNORED)) &&
+		    x86_arch_resume_after_breakpoint (handle, *retval)) {
+			_server_ptrace_breakpoint_filtered (handle, *retval);
+			return STOP_ACTION_RESUMED;
+		}
+
 		_server_ptrace_set_registers (inferior, &arch->current_regs);
+		*retval2 = condition;
 		return STOP_ACTION_BREAKPOINT_HIT;
 	}
 
@@ -1052,6 +1134,7 @@ server_ptrace_remove_breakpoint (ServerHandle *handle, guint32 idx)
 		goto out;
 
 	breakpoint->enabled = FALSE;
+	_server_ptrace_release_resume_code (handle, breakpoint);
 	mono_debugger_breakpoint_manager_remove (bpm, breakpoint);
 
  out:
@@ -1215,9 +1298,73 @@ find_code_buffer_slot (MonoRuntimeInfo *runtime)
 	return -1;
 }
 
+/*
+ * Build the code which resumes a thread after a breakpoint whose condition was
+ * false: a copy of the original instruction, followed by a jump to the next
+ * instruction.
+ */
+static int
+x86_arch_build_resume_code (guint64 code_address, guint64 address, const guint8 *instruction,
+			    guint32 insn_size, gint32 ip_relative_offset, guint8 *code)
+{
+	gint32 displacement;
+
+	if ((ip_relative_offset >= 0) || (insn_size + 5 > RESUME_CODE_SIZE))
+		return -1;
+
+	memcpy (code, instruction, insn_size);
+
+	/* jmp rel32 */
+	displacement = (gint32) ((address + insn_size) - (code_address + insn_size + 5));
+	code [insn_size] = 0xe9;
+	memcpy (code + insn_size + 1, &displacement, sizeof (gint32));
+
+	return insn_size + 5;
+}
+
+static gboolean
+x86_arch_resume_after_breakpoint (ServerHandle *handle, guint32 idx)
+{
+#ifdef __linux__
+	ArchInfo *arch = handle->arch;
+	InferiorHandle *inferior = handle->inferior;
+	BreakpointInfo *breakpoint;
+	guint64 resume_address = 0, eip;
+
+	/*
+	 * The debugger wants to see the next stop.
+	 */
+	if (inferior->stepping || inferior->stop_pending)
+		return FALSE;
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoint = mono_debugger_breakpoint_manager_lookup_by_id (handle->bpm, idx);
+	if (breakpoint)
+		resume_address = breakpoint->resume_address;
+	mono_debugger_breakpoint_manager_unlock ();
+
+	if (!resume_address)
+		return FALSE;
+
+	eip = INFERIOR_REG_EIP (arch->current_regs);
+	INFERIOR_REG_ORIG_EAX (arch->current_regs) = -1;
+	INFERIOR_REG_EIP (arch->current_regs) = resume_address;
+
+	if (_server_ptrace_set_registers (inferior, &arch->current_regs) != COMMAND_ERROR_NONE) {
+		INFERIOR_REG_EIP (arch->current_regs) = eip;
+		return FALSE;
+	}
+
+	inferior->last_signal = 0;
+	return server_ptrace_continue (handle) == COMMAND_ERROR_NONE;
+#else
+	return FALSE;
+#endif
+}
+
 static ServerCommandError
 server_ptrace_execute_instruction (ServerHandle *handle, const guint8 *instruction,
-				   guint32 size, gboolean update_ip)
+				   guint32 size, gboolean update_ip, gint32 ip_relative_offset)
 {
 	MonoRuntimeInfo *runtime;
 	ServerCommandError result;
@@ -1228,6 +1375,10 @@ server_ptrace_execute_instruction (ServerHandle *handle, const guint8 *instructi
 	runtime = handle->mono_runtime;
 	g_assert (runtime);
 
+	/* There is no %eip-relative addressing on i386. */
+	if (ip_relative_offset >= 0)
+		return COMMAND_ERROR_NOT_IMPLEMENTED;
+
 	if (!runtime->executable_code_buffer)
 		return COMMAND_ERROR_INTERNAL_ERROR;
 
@@ -212,6 +212,16 @@ mono_debugger_server_read_memory (ServerHandle *handle, guint64 start, guint32 s
 	return (* global_vtable->read_memory) (handle, start, size, data);
 }
 
+ServerCommandError
+mono_debugger_server_read_memory_vectored (ServerHandle *handle, guint32 count, const guint64 *addresses,
+					   const guint32 *sizes, gpointer data, guint32 *status)
+{
+	if (!global_vtable->read_memory_vectored)
+		return COMMAND_ERROR_NOT_IMPLEMENTED;
+
+	return (* global_vtable->read_memory_vectored) (handle, count, addresses, sizes, data, status);
+}
+
 ServerCommandError
 mono_debugger_server_write_memory (ServerHandle *handle, guint64 start, guint32 size, gconstpointer data)
 {
@@ -291,13 +301,14 @@ mono_debugger_server_call_method_invoke (ServerHandle *handle, guint64 invoke_me
 
 ServerCommandError
 mono_debugger_server_execute_instruction (ServerHandle *handle, const guint8 *instruction,
-					  guint32 insn_size, gboolean update_ip)
+					  guint32 insn_size, gboolean update_ip,
+					  gint32 ip_relative_offset)
 {
 	if (!global_vtable->execute_instruction)
 		return COMMAND_ERROR_NOT_IMPLEMENTED;
 
 	return (* global_vtable->execute_instruction) (
-		handle, instruction, insn_size, update_ip);
+		handle, instruction, insn_size, update_ip, ip_relative_offset);
 }
 
 ServerCommandError
@@ -347,6 +358,43 @@ mono_debugger_server_remove_breakpoint (ServerHandle *handle, guint32 breakpoint
 	return (* global_vtable->remove_breakpoint) (handle, breakpoint);
 }
 
+ServerCommandError
+mono_debugger_server_set_breakpoint_condition (ServerHandle *handle, guint32 breakpoint,
+					       const guint8 *code, guint32 code_size,
+					       const guint8 *instruction, guint32 insn_size,
+					       gint32 ip_relative_offset)
+{
+	if (!global_vtable->set_breakpoint_condition)
+		return COMMAND_ERROR_NOT_IMPLEMENTED;
+
+	return (* global_vtable->set_breakpoint_condition) (
+		handle, breakpoint, code, code_size, instruction, insn_size, ip_relative_offset);
+}
+
+ServerCommandError
+mono_debugger_server_set_breakpoint_ignore_count (ServerHandle *handle, guint32 breakpoint,
+						  guint32 count, const guint8 *instruction,
+						  guint32 insn_size, gint32 ip_relative_offset)
+{
+	if (!global_vtable->set_breakpoint_ignore_count)
+		return COMMAND_ERROR_NOT_IMPLEMENTED;
+
+	return (* global_vtable->set_breakpoint_ignore_count) (
+		handle, breakpoint, count, instruction, insn_size, ip_relative_offset);
+}
+
+ServerCommandError
+mono_debugger_server_get_breakpoint_stats (ServerHandle *handle, guint32 breakpoint,
+					   guint32 *hit_count, guint32 *filtered_count,
+					   guint32 *ignore_count)
+{
+	if (!global_vtable->get_breakpoint_stats)
+		return COMMAND_ERROR_NOT_IMPLEMENTED;
+
+	return (* global_vtable->get_breakpoint_stats) (
+		handle, breakpoint, hit_count, filtered_count, ignore_count);
+}
+
 ServerCommandError
 mono_debugger_server_enable_breakpoint (ServerHandle *handle, guint32 breakpoint)
 {
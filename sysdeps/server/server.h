@@ -56,7 +56,8 @@ typedef enum {
 	MESSAGE_CHILD_NOTIFICATION,
 	MESSAGE_CHILD_INTERRUPTED,
 	MESSAGE_RUNTIME_INVOKE_DONE,
-	MESSAGE_INTERNAL_ERROR
+	MESSAGE_INTERNAL_ERROR,
+	MESSAGE_CHILD_RESUMED
 } ServerStatusMessageType;
 
 typedef struct {
@@ -97,6 +98,7 @@ typedef struct
 	guint8 *breakpoint_table_bitfield;
 	guint8 *executable_code_bitfield;
 	guint32 executable_code_last_slot;
+	guint32 resume_code_chunks;
 } MonoRuntimeInfo;
 
 typedef enum {
@@ -320,10 +322,17 @@ struct InferiorVTable {
 						       guint64           callback_argument,
 						       gboolean          debug);
 
+	/*
+	 * Execute `instruction' out of line in the code buffer.
+	 * If `ip_relative_offset' is not -1, it is the offset of a RIP-relative
+	 * 32-bit displacement within the instruction, which is adjusted for the
+	 * instruction's new location.
+	 */
 	ServerCommandError    (* execute_instruction) (ServerHandle     *handle,
 						       const guint8     *instruction,
 						       guint32           size,
-						       gboolean          update_ip);
+						       gboolean          update_ip,
+						       gint32            ip_relative_offset);
 
 	ServerCommandError    (* mark_rti_frame)      (ServerHandle     *handle);
 
@@ -444,6 +453,50 @@ struct InferiorVTable {
 	guint32               (*get_current_pid) (void);
 
 	guint64               (*get_current_thread) (void);
+
+	/*
+	 * Read `count' blocks of memory in one go; block `i' is `sizes [i]' bytes
+	 * starting at `addresses [i]'.  The blocks are stored back-to-back in
+	 * `buffer' and `status [i]' receives the result of reading block `i'.
+	 */
+	ServerCommandError    (* read_memory_vectored) (ServerHandle     *handle,
+							guint32           count,
+							const guint64    *addresses,
+							const guint32    *sizes,
+							gpointer          buffer,
+							guint32          *status);
+
+	/*
+	 * Attach a compiled condition to breakpoint `breakpoint'; see breakpoints.h.
+	 * If `insn_size' is non-zero, `instruction' is the instruction at the
+	 * breakpoint's address and it may be executed out of line so we can
+	 * resume the target without any help from the debugger if the condition
+	 * is false.
+	 */
+	ServerCommandError    (* set_breakpoint_condition) (ServerHandle *handle,
+							    guint32       breakpoint,
+							    const guint8 *code,
+							    guint32       code_size,
+							    const guint8 *instruction,
+							    guint32       insn_size,
+							    gint32        ip_relative_offset);
+
+	/*
+	 * Don't report the next `count' hits of breakpoint `breakpoint'; the
+	 * instruction arguments are the same as in set_breakpoint_condition().
+	 */
+	ServerCommandError    (* set_breakpoint_ignore_count) (ServerHandle *handle,
+							       guint32       breakpoint,
+							       guint32       count,
+							       const guint8 *instruction,
+							       guint32       insn_size,
+							       gint32        ip_relative_offset);
+
+	ServerCommandError    (* get_breakpoint_stats) (ServerHandle *handle,
+							guint32       breakpoint,
+							guint32      *hit_count,
+							guint32      *filtered_count,
+							guint32      *ignore_count);
 };
 
 /*
@@ -543,6 +596,14 @@ mono_debugger_server_read_memory          (ServerHandle       *handle,
 					   guint32             size,
 					   gpointer            data);
 
+ServerCommandError
+mono_debugger_server_read_memory_vectored (ServerHandle       *handle,
+					   guint32             count,
+					   const guint64      *addresses,
+					   const guint32      *sizes,
+					   gpointer            data,
+					   guint32            *status);
+
 ServerCommandError
 mono_debugger_server_write_memory         (ServerHandle       *handle,
 					   guint64             start,
@@ -597,7 +658,8 @@ ServerCommandError
 mono_debugger_execute_instruction         (ServerHandle        *handle,
 					   const guint8        *instruction,
 					   guint32              instruction_size,
-					   gboolean             update_ip);
+					   gboolean             update_ip,
+					   gint32               ip_relative_offset);
 
 ServerCommandError
 mono_debugger_mark_rti_framenvoke        (ServerHandle        *handle);
@@ -622,6 +684,30 @@ ServerCommandError
 mono_debugger_server_remove_breakpoint   (ServerHandle        *handle,
 					  guint32              breakpoint);
 
+ServerCommandError
+mono_debugger_server_set_breakpoint_condition (ServerHandle   *handle,
+					   guint32             breakpoint,
+					   const guint8       *code,
+					   guint32             code_size,
+					   const guint8       *instruction,
+					   guint32             insn_size,
+					   gint32              ip_relative_offset);
+
+ServerCommandError
+mono_debugger_server_set_breakpoint_ignore_count (ServerHandle *handle,
+						  guint32             breakpoint,
+						  guint32             count,
+						  const guint8       *instruction,
+						  guint32             insn_size,
+						  gint32              ip_relative_offset);
+
+ServerCommandError
+mono_debugger_server_get_breakpoint_stats (ServerHandle        *handle,
+					   guint32              breakpoint,
+					   guint32             *hit_count,
+					   guint32             *filtered_count,
+					   guint32             *ignore_count);
+
 ServerCommandError
 mono_debugger_server_enable_breakpoint   (ServerHandle        *handle,
 					  guint32              breakpoint);
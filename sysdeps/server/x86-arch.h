@@ -13,9 +13,21 @@ typedef enum {
 	STOP_ACTION_CALLBACK_COMPLETED,
 	STOP_ACTION_NOTIFICATION,
 	STOP_ACTION_RTI_DONE,
-	STOP_ACTION_INTERNAL_ERROR
+	STOP_ACTION_INTERNAL_ERROR,
+	STOP_ACTION_RESUMED
 } ChildStoppedAction;
 
+/*
+ * Size of the code which resumes a thread after a breakpoint whose
+ * condition was false; see x86_arch_build_resume_code().
+ */
+#define RESUME_CODE_SIZE	32
+
+/*
+ * Number of code buffer chunks which may be reserved for resume code.
+ */
+#define MAX_RESUME_CODE_CHUNKS(runtime)	((runtime)->executable_code_total_chunks / 4)
+
 typedef enum {
 	DEBUGGER_REG_RAX	= 0,
 	DEBUGGER_REG_RCX,
@@ -71,9 +83,22 @@ x86_arch_child_stopped (ServerHandle *handle, int stopsig,
 			guint64 *callback_arg, guint64 *retval, guint64 *retval2,
 			guint32 *opt_data_size, gpointer *opt_data);
 
+static int
+x86_arch_build_resume_code (guint64 code_address, guint64 address, const guint8 *instruction,
+			    guint32 insn_size, gint32 ip_relative_offset, guint8 *code);
+
+static gboolean
+x86_arch_resume_after_breakpoint (ServerHandle *handle, guint32 idx);
+
 static ServerCommandError
 x86_arch_get_registers (ServerHandle *handle);
 
+static ServerCommandError
+x86_arch_get_fp_registers (ServerHandle *handle);
+
+static void
+x86_arch_invalidate_registers (ServerHandle *handle);
+
 static ServerCommandError
 x86_arch_disable_breakpoint (ServerHandle *handle, BreakpointInfo *breakpoint);
 
@@ -152,6 +177,10 @@ x86_arch_enable_breakpoint (ServerHandle *handle, BreakpointInfo *breakpoint);
 #define X86_DR_GET_RW_LEN(arch,i) \
   ((arch->dr_control >> (DR_CONTROL_SHIFT + DR_CONTROL_SIZE * (i))) & 0x0f)
 
+/* Is any of the debug registers enabled?  */
+#define X86_DR_ARMED(arch) \
+  ((arch->dr_control & 0xff) != 0)
+
 /* Did the watchpoint whose address is in the I'th register break?  */
 #define X86_DR_WATCH_HIT(arch,i) \
   (arch->dr_status & (1 << (i)))
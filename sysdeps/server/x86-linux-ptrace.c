@@ -111,6 +111,104 @@ server_ptrace_read_memory (ServerHandle *handle, guint64 start, guint32 size, gp
 	return COMMAND_ERROR_NONE;
 }
 
+#ifdef HAVE_PROCESS_VM_READV
+
+#define MAX_READ_MEMORY_IOV 256
+
+/* Only cleared if the kernel doesn't have the syscall at all. */
+static gboolean has_process_vm_readv = TRUE;
+
+/*
+ * Read as many of the `count' blocks as possible with a single process_vm_readv().
+ * Returns the number of blocks which have been read completely.
+ */
+static guint32
+_server_ptrace_read_memory_iov (ServerHandle *handle, guint32 count, const guint64 *addresses,
+				const guint32 *sizes, guint8 *buffer)
+{
+	struct iovec local [MAX_READ_MEMORY_IOV], remote [MAX_READ_MEMORY_IOV];
+	gssize ret, total = 0;
+	guint32 i;
+
+	if (count > MAX_READ_MEMORY_IOV)
+		count = MAX_READ_MEMORY_IOV;
+
+	for (i = 0; i < count; i++) {
+		local [i].iov_base = buffer + total;
+		local [i].iov_len = sizes [i];
+		remote [i].iov_base = GSIZE_TO_POINTER ((gsize) addresses [i]);
+		remote [i].iov_len = sizes [i];
+		total += sizes [i];
+	}
+
+	do {
+		ret = process_vm_readv (handle->inferior->pid, local, count, remote, count, 0);
+	} while ((ret < 0) && (errno == EINTR));
+
+	if (ret < 0) {
+		/*
+		 * EPERM is a per-process denial (Yama, a different uid), so we only
+		 * stop using the syscall for this process; ptrace may still work.
+		 */
+		if (errno == ENOSYS)
+			has_process_vm_readv = FALSE;
+		else if (errno == EPERM)
+			handle->inferior->os.process_vm_readv_denied = TRUE;
+		return 0;
+	}
+
+	/* A partial transfer stops at the first block which could not be read. */
+	for (i = 0; i < count; i++) {
+		if (ret < (gssize) sizes [i])
+			break;
+		ret -= sizes [i];
+	}
+
+	return i;
+}
+
+#endif
+
+static ServerCommandError
+server_ptrace_read_memory_vectored (ServerHandle *handle, guint32 count, const guint64 *addresses,
+				    const guint32 *sizes, gpointer buffer, guint32 *status)
+{
+	guint8 *ptr = buffer;
+	guint32 i = 0;
+
+	while (i < count) {
+		guint32 done = 0, j;
+
+#ifdef HAVE_PROCESS_VM_READV
+		if (has_process_vm_readv && !handle->inferior->os.process_vm_readv_denied)
+			done = _server_ptrace_read_memory_iov (
+				handle, count - i, addresses + i, sizes + i, ptr);
+#endif
+
+		for (j = 0; j < done; j++, i++) {
+			x86_arch_remove_breakpoints_from_target_memory (
+				handle, addresses [i], sizes [i], ptr);
+			status [i] = COMMAND_ERROR_NONE;
+			ptr += sizes [i];
+		}
+
+		if (i >= count)
+			break;
+
+		/*
+		 * Either process_vm_readv() is not available or it stopped at this
+		 * block; read it the slow way to get an accurate error code.
+		 */
+		status [i] = server_ptrace_read_memory (handle, addresses [i], sizes [i], ptr);
+		if (status [i] == COMMAND_ERROR_NOT_STOPPED)
+			return COMMAND_ERROR_NOT_STOPPED;
+		ptr += sizes [i];
+		i++;
+	}
+
+	return COMMAND_ERROR_NONE;
+}
+
 static ServerCommandError
 server_ptrace_write_memory (ServerHandle *handle, guint64 start,
 			    guint32 size, gconstpointer buffer)
@@ -189,6 +287,8 @@ server_ptrace_continue (ServerHandle *handle)
 {
 	InferiorHandle *inferior = handle->inferior;
 
+	x86_arch_invalidate_registers (handle);
+
 	errno = 0;
 	inferior->stepping = FALSE;
 	if (ptrace (PT_CONTINUE, inferior->pid, (caddr_t) 1, inferior->last_signal)) {
@@ -203,6 +303,8 @@ server_ptrace_step (ServerHandle *handle)
 {
 	InferiorHandle *inferior = handle->inferior;
 
+	x86_arch_invalidate_registers (handle);
+
 	errno = 0;
 	inferior->stepping = TRUE;
 	if (ptrace (PT_STEP, inferior->pid, (caddr_t) 1, inferior->last_signal))
@@ -373,6 +475,7 @@ server_ptrace_stop (ServerHandle *handle)
 			return COMMAND_ERROR_UNKNOWN_ERROR;
 	}
 
+	handle->inferior->stop_pending = TRUE;
 	return COMMAND_ERROR_NONE;
 }
 
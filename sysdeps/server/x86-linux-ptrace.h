@@ -3,9 +3,17 @@
 
 #include "x86-arch.h"
 
+#ifdef HAVE_PROCESS_VM_READV
+#include <sys/uio.h>
+#endif
+
 struct OSData
 {
 	int mem_fd;
+#ifdef HAVE_PROCESS_VM_READV
+	/* process_vm_readv() is available, but we may not use it on this process. */
+	gboolean process_vm_readv_denied;
+#endif
 };
 
 #include "x86-ptrace.h"
@@ -201,7 +201,7 @@ server_ptrace_dispatch_event (ServerHandle *handle, guint32 status, guint64 *arg
 #if __MACH__
 		handle->inferior->os.wants_to_run = FALSE;
 #endif
-		guint64 callback_arg, retval, retval2;
+		guint64 callback_arg, retval, retval2 = 0;
 		ChildStoppedAction action;
 		int stopsig;
 
@@ -232,6 +232,7 @@ server_ptrace_dispatch_event (ServerHandle *handle, guint32 status, guint64 *arg
 
 		case STOP_ACTION_BREAKPOINT_HIT:
 			*arg = (int) retval;
+			*data1 = retval2;
 			return MESSAGE_CHILD_HIT_BREAKPOINT;
 
 		case STOP_ACTION_CALLBACK:
@@ -260,6 +261,10 @@ server_ptrace_dispatch_event (ServerHandle *handle, guint32 status, guint64 *arg
 
 		case STOP_ACTION_INTERNAL_ERROR:
 			return MESSAGE_INTERNAL_ERROR;
+
+		case STOP_ACTION_RESUMED:
+			*arg = 0;
+			return MESSAGE_CHILD_RESUMED;
 		}
 
 		g_assert_not_reached ();
@@ -597,6 +602,271 @@ extern void GC_end_blocking (void);
 #error "Unknown architecture"
 #endif
 
+static gboolean
+read_condition_memory (gpointer user_data, guint64 address, guint32 size, gpointer buffer)
+{
+	ServerHandle *handle = (ServerHandle *) user_data;
+
+	return server_ptrace_read_memory (handle, address, size, buffer) == COMMAND_ERROR_NONE;
+}
+
+/*
+ * Called each time we hit breakpoint `idx'; evaluates its condition and, if
+ * that's true or if there is none, counts the hit and decrements its ignore
+ * count.  If we can't evaluate the condition, we leave both to the debugger.
+ */
+static BreakpointConditionResult
+_server_ptrace_check_breakpoint_condition (ServerHandle *handle, guint32 idx)
+{
+	BreakpointConditionResult result = BREAKPOINT_CONDITION_NONE;
+	BreakpointInfo *breakpoint;
+	guint64 registers [DEBUGGER_REG_LAST];
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoint = mono_debugger_breakpoint_manager_lookup_by_id (handle->bpm, idx);
+	if (!breakpoint) {
+		mono_debugger_breakpoint_manager_unlock ();
+		return BREAKPOINT_CONDITION_NONE;
+	}
+
+	if (breakpoint->condition) {
+		if (server_ptrace_get_registers (handle, registers) != COMMAND_ERROR_NONE) {
+			mono_debugger_breakpoint_manager_unlock ();
+			return BREAKPOINT_CONDITION_NONE;
+		}
+
+		result = mono_debugger_breakpoint_info_evaluate_condition (
+			breakpoint, registers, DEBUGGER_REG_LAST, read_condition_memory, handle);
+		if (result != BREAKPOINT_CONDITION_TRUE) {
+			mono_debugger_breakpoint_manager_unlock ();
+			return result;
+		}
+	}
+
+	breakpoint->hit_count++;
+
+	if (breakpoint->ignore_count) {
+		breakpoint->ignore_count--;
+		result = BREAKPOINT_CONDITION_IGNORED;
+	}
+
+	mono_debugger_breakpoint_manager_unlock ();
+	return result;
+}
+
+static void
+_server_ptrace_breakpoint_filtered (ServerHandle *handle, guint32 idx)
+{
+	BreakpointInfo *breakpoint;
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoint = mono_debugger_breakpoint_manager_lookup_by_id (handle->bpm, idx);
+	if (breakpoint)
+		breakpoint->filtered_count++;
+	mono_debugger_breakpoint_manager_unlock ();
+}
+
+static int
+reserve_code_buffer_slots (MonoRuntimeInfo *runtime, int count)
+{
+	int i, j;
+
+	for (i = 0; i + count <= runtime->executable_code_total_chunks; i++) {
+		for (j = 0; j < count; j++) {
+			if (runtime->executable_code_bitfield [i + j])
+				break;
+		}
+
+		if (j < count) {
+			i += j;
+			continue;
+		}
+
+		for (j = 0; j < count; j++)
+			runtime->executable_code_bitfield [i + j] = 1;
+		return i;
+	}
+
+	return -1;
+}
+
+static void
+_server_ptrace_release_resume_code (ServerHandle *handle, BreakpointInfo *breakpoint)
+{
+	MonoRuntimeInfo *runtime = handle->mono_runtime;
+	int i;
+
+	if (!breakpoint->resume_address)
+		return;
+
+	if (runtime && runtime->executable_code_bitfield) {
+		for (i = 0; i < breakpoint->resume_slots; i++)
+			runtime->executable_code_bitfield [breakpoint->resume_slot + i] = 0;
+		runtime->resume_code_chunks -= breakpoint->resume_slots;
+	}
+
+	breakpoint->resume_address = 0;
+	breakpoint->resume_slot = 0;
+	breakpoint->resume_slots = 0;
+}
+
+/*
+ * If `ip' is inside the resume code of one of our breakpoints, compute the
+ * corresponding address in the original code.
+ */
+static gboolean
+_server_ptrace_get_resume_code_address (ServerHandle *handle, guint64 ip, guint64 *address)
+{
+	MonoRuntimeInfo *runtime = handle->mono_runtime;
+	GPtrArray *breakpoints;
+	gboolean found = FALSE;
+	int i;
+
+	if (!runtime || !runtime->executable_code_buffer)
+		return FALSE;
+	if ((ip < runtime->executable_code_buffer) ||
+	    (ip >= runtime->executable_code_buffer + runtime->executable_code_buffer_size))
+		return FALSE;
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoints = mono_debugger_breakpoint_manager_get_breakpoints (handle->bpm);
+	for (i = 0; i < breakpoints->len; i++) {
+		BreakpointInfo *info = g_ptr_array_index (breakpoints, i);
+
+		if (!info->resume_address || (ip < info->resume_address) ||
+		    (ip >= info->resume_address + info->resume_slots * runtime->executable_code_chunk_size))
+			continue;
+
+		*address = info->address + (ip - info->resume_address);
+		found = TRUE;
+		break;
+	}
+	mono_debugger_breakpoint_manager_unlock ();
+
+	return found;
+}
+
+/*
+ * Copy the breakpoint's original instruction into the runtime's code buffer,
+ * so the thread may continue without removing the breakpoint.  If we can't do
+ * that, the debugger has to step over the breakpoint itself.  Must be called
+ * with the breakpoint manager locked.
+ *
+ * The slots stay reserved until the breakpoint is removed or doesn't need them
+ * anymore.  The rest of the code buffer is used to step over breakpoints, so
+ * we use at most MAX_RESUME_CODE_CHUNKS of it and take the slow way for all
+ * breakpoints beyond that.
+ */
+static void
+setup_resume_code (ServerHandle *handle, BreakpointInfo *breakpoint,
+		   const guint8 *instruction, guint32 insn_size, gint32 ip_relative_offset)
+{
+	MonoRuntimeInfo *runtime = handle->mono_runtime;
+	guint8 resume_code [RESUME_CODE_SIZE];
+	guint64 code_address;
+	int slot, slots, size, i;
+
+	if (breakpoint->resume_address)
+		return;
+
+	if (!insn_size || !runtime || !runtime->executable_code_buffer)
+		return;
+
+	slots = (RESUME_CODE_SIZE + runtime->executable_code_chunk_size - 1) /
+		runtime->executable_code_chunk_size;
+	if (runtime->resume_code_chunks + slots > MAX_RESUME_CODE_CHUNKS (runtime))
+		return;
+
+	slot = reserve_code_buffer_slots (runtime, slots);
+	if (slot < 0)
+		return;
+
+	code_address = runtime->executable_code_buffer + slot * runtime->executable_code_chunk_size;
+	size = x86_arch_build_resume_code (code_address, breakpoint->address, instruction,
+					   insn_size, ip_relative_offset, resume_code);
+	if ((size < 0) ||
+	    (server_ptrace_write_memory (handle, code_address, size, resume_code) != COMMAND_ERROR_NONE)) {
+		for (i = 0; i < slots; i++)
+			runtime->executable_code_bitfield [slot + i] = 0;
+		return;
+	}
+
+	breakpoint->resume_address = code_address;
+	breakpoint->resume_slot = slot;
+	breakpoint->resume_slots = slots;
+	runtime->resume_code_chunks += slots;
+}
+
+static ServerCommandError
+server_ptrace_set_breakpoint_condition (ServerHandle *handle, guint32 idx,
+					const guint8 *code, guint32 code_size,
+					const guint8 *instruction, guint32 insn_size,
+					gint32 ip_relative_offset)
+{
+	BreakpointInfo *breakpoint;
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoint = mono_debugger_breakpoint_manager_lookup_by_id (handle->bpm, idx);
+	if (!breakpoint || breakpoint->is_hardware_bpt) {
+		mono_debugger_breakpoint_manager_unlock ();
+		return COMMAND_ERROR_NO_SUCH_BREAKPOINT;
+	}
+
+	mono_debugger_breakpoint_info_set_condition (breakpoint, code, code_size);
+	_server_ptrace_release_resume_code (handle, breakpoint);
+
+	if (code_size || breakpoint->ignore_count)
+		setup_resume_code (handle, breakpoint, instruction, insn_size, ip_relative_offset);
+
+	mono_debugger_breakpoint_manager_unlock ();
+	return COMMAND_ERROR_NONE;
+}
+
+static ServerCommandError
+server_ptrace_set_breakpoint_ignore_count (ServerHandle *handle, guint32 idx, guint32 count,
+					   const guint8 *instruction, guint32 insn_size,
+					   gint32 ip_relative_offset)
+{
+	BreakpointInfo *breakpoint;
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoint = mono_debugger_breakpoint_manager_lookup_by_id (handle->bpm, idx);
+	if (!breakpoint || breakpoint->is_hardware_bpt) {
+		mono_debugger_breakpoint_manager_unlock ();
+		return COMMAND_ERROR_NO_SUCH_BREAKPOINT;
+	}
+
+	breakpoint->ignore_count = count;
+	if (count)
+		setup_resume_code (handle, breakpoint, instruction, insn_size, ip_relative_offset);
+	else if (!breakpoint->condition)
+		_server_ptrace_release_resume_code (handle, breakpoint);
+
+	mono_debugger_breakpoint_manager_unlock ();
+	return COMMAND_ERROR_NONE;
+}
+
+static ServerCommandError
+server_ptrace_get_breakpoint_stats (ServerHandle *handle, guint32 idx, guint32 *hit_count,
+				    guint32 *filtered_count, guint32 *ignore_count)
+{
+	BreakpointInfo *breakpoint;
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoint = mono_debugger_breakpoint_manager_lookup_by_id (handle->bpm, idx);
+	if (!breakpoint) {
+		mono_debugger_breakpoint_manager_unlock ();
+		return COMMAND_ERROR_NO_SUCH_BREAKPOINT;
+	}
+
+	*hit_count = breakpoint->hit_count;
+	*filtered_count = breakpoint->filtered_count;
+	*ignore_count = breakpoint->ignore_count;
+
+	mono_debugger_breakpoint_manager_unlock ();
+	return COMMAND_ERROR_NONE;
+}
+
 InferiorVTable i386_ptrace_inferior = {
 	server_ptrace_global_init,
 	server_ptrace_get_server_type,
@@ -653,5 +923,9 @@ InferiorVTable i386_ptrace_inferior = {
 	server_ptrace_restart_notification,
 	server_ptrace_get_registers_from_core_file,
 	server_ptrace_get_current_pid,
-	server_ptrace_get_current_thread
+	server_ptrace_get_current_thread,
+	server_ptrace_read_memory_vectored,
+	server_ptrace_set_breakpoint_condition,
+	server_ptrace_set_breakpoint_ignore_count,
+	server_ptrace_get_breakpoint_stats
 };
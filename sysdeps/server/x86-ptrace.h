@@ -9,6 +9,7 @@ struct InferiorHandle
 
 	guint32 pid;
 	int stepping;
+	int stop_pending;
 	int last_signal;
 	int redirect_fds;
 	int output_fd [2], error_fd [2];
@@ -78,6 +79,18 @@ server_ptrace_poke_word (ServerHandle *handle, guint64 addr, gsize value);
 static ServerCommandError
 _server_ptrace_set_dr (InferiorHandle *handle, int regnum, guint64 value);
 
+static BreakpointConditionResult
+_server_ptrace_check_breakpoint_condition (ServerHandle *handle, guint32 idx);
+
+static gboolean
+_server_ptrace_get_resume_code_address (ServerHandle *handle, guint64 ip, guint64 *address);
+
+static void
+_server_ptrace_release_resume_code (ServerHandle *handle, BreakpointInfo *breakpoint);
+
+static void
+_server_ptrace_breakpoint_filtered (ServerHandle *handle, guint32 idx);
+
 static ServerCommandError
 _server_ptrace_get_dr (InferiorHandle *handle, int regnum, guint64 *value);
 
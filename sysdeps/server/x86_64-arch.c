@@ -31,6 +31,7 @@ struct ArchInfo
 	GPtrArray *callback_stack;
 	CodeBufferData *code_buffer;
 	guint64 dr_control, dr_status;
+	gboolean regs_valid, fpregs_valid;
 	guint64 pushed_regs_rsp;
 	BreakpointManager *hw_bpm;
 	int dr_regs [DR_NADDR];
@@ -118,9 +119,11 @@ server_ptrace_get_frame (ServerHandle *handle, StackFrame *frame)
 {
 	ServerCommandError result;
 
-	result = x86_arch_get_registers (handle);
-	if (result != COMMAND_ERROR_NONE)
-		return result;
+	if (!handle->arch->regs_valid) {
+		result = x86_arch_get_registers (handle);
+		if (result != COMMAND_ERROR_NONE)
+			return result;
+	}
 
 	frame->address = (guint64) INFERIOR_REG_RIP (handle->arch->current_regs);
 	frame->stack_pointer = (guint64) INFERIOR_REG_RSP (handle->arch->current_regs);
@@ -186,23 +189,59 @@ get_callback_data (ArchInfo *arch)
 static ServerCommandError
 x86_arch_get_registers (ServerHandle *handle)
 {
+	ArchInfo *arch = handle->arch;
 	ServerCommandError result;
 
-	result = _server_ptrace_get_registers (handle->inferior, &handle->arch->current_regs);
+	result = _server_ptrace_get_registers (handle->inferior, &arch->current_regs);
 	if (result != COMMAND_ERROR_NONE)
 		return result;
 
-	result = _server_ptrace_get_fp_registers (handle->inferior, &handle->arch->current_fpregs);
+	arch->regs_valid = TRUE;
+	arch->fpregs_valid = FALSE;
+
+	/*
+	 * DR_STATUS can only be set if we armed a hardware breakpoint.
+	 */
+	if (!X86_DR_ARMED (arch)) {
+		arch->dr_status = 0;
+		return COMMAND_ERROR_NONE;
+	}
+
+	result = _server_ptrace_get_dr (handle->inferior, DR_STATUS, &arch->dr_status);
 	if (result != COMMAND_ERROR_NONE)
 		return result;
 
-	result = _server_ptrace_get_dr (handle->inferior, DR_STATUS, &handle->arch->dr_status);
+	return COMMAND_ERROR_NONE;
+}
+
+/*
+ * The FP registers are only needed when saving the state for a callback,
+ * so only fetch them once per stop and only when asked for.
+ */
+static ServerCommandError
+x86_arch_get_fp_registers (ServerHandle *handle)
+{
+	ArchInfo *arch = handle->arch;
+	ServerCommandError result;
+
+	if (arch->fpregs_valid)
+		return COMMAND_ERROR_NONE;
+
+	result = _server_ptrace_get_fp_registers (handle->inferior, &arch->current_fpregs);
 	if (result != COMMAND_ERROR_NONE)
 		return result;
 
+	arch->fpregs_valid = TRUE;
 	return COMMAND_ERROR_NONE;
 }
 
+static void
+x86_arch_invalidate_registers (ServerHandle *handle)
+{
+	handle->arch->regs_valid = FALSE;
+	handle->arch->fpregs_valid = FALSE;
+}
+
 ChildStoppedAction
 x86_arch_child_stopped (ServerHandle *handle, int stopsig,
 			guint64 *callback_arg, guint64 *retval, guint64 *retval2,
@@ -212,13 +251,24 @@ x86_arch_child_stopped (ServerHandle *handle, int stopsig,
 	InferiorHandle *inferior = handle->inferior;
 	CodeBufferData *cbuffer = NULL;
 	CallbackData *cdata;
-	guint64 code;
+	guint64 code, resume_ip;
 	int i;
 
 	x86_arch_get_registers (handle);
 
-	if (stopsig == SIGSTOP)
+	/*
+	 * We stopped while executing the resume code of a conditional breakpoint,
+	 * so make it look like we're still in the original code.
+	 */
+	if (_server_ptrace_get_resume_code_address (handle, INFERIOR_REG_RIP (arch->current_regs), &resume_ip)) {
+		INFERIOR_REG_RIP (arch->current_regs) = resume_ip;
+		_server_ptrace_set_registers (inferior, &arch->current_regs);
+	}
+
+	if (stopsig == SIGSTOP) {
+		inferior->stop_pending = FALSE;
 		return STOP_ACTION_INTERRUPTED;
+	}
 
 	/*
 	 * By default, when the NX-flag is set in the BIOS, we stop at the `cdata->call_address'
@@ -325,8 +375,20 @@ x86_arch_child_stopped (ServerHandle *handle, int stopsig,
 	}
 
 	if (check_breakpoint (handle, INFERIOR_REG_RIP (arch->current_regs) - 1, retval)) {
+		BreakpointConditionResult condition;
+
 		INFERIOR_REG_RIP (arch->current_regs)--;
+
+		condition = _server_ptrace_check_breakpoint_condition (handle, *retval);
+		if (((condition == BREAKPOINT_CONDITION_FALSE) ||
+		     (condition == BREAKPOINT_CONDITION_IGNORED)) &&
+		    x86_arch_resume_after_breakpoint (handle, *retval)) {
+			_server_ptrace_breakpoint_filtered (handle, *retval);
+			return STOP_ACTION_RESUMED;
+		}
+
 		_server_ptrace_set_registers (inferior, &arch->current_regs);
+		*retval2 = condition;
 		return STOP_ACTION_BREAKPOINT_HIT;
 	}
 
@@ -774,6 +836,7 @@ server_ptrace_remove_breakpoint (ServerHandle *handle, guint32 idx)
 		goto out;
 
 	breakpoint->enabled = FALSE;
+	_server_ptrace_release_resume_code (handle, breakpoint);
 	mono_debugger_breakpoint_manager_remove (bpm, breakpoint);
 
  out:
@@ -925,6 +988,10 @@ server_ptrace_call_method (ServerHandle *handle, guint64 method_address,
 			  0xcc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
 	int size = sizeof (code);
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 
 	new_rsp = INFERIOR_REG_RSP (arch->current_regs) - AMD64_RED_ZONE_SIZE - size - 16;
@@ -985,6 +1052,10 @@ server_ptrace_call_method_1 (ServerHandle *handle, guint64 method_address,
 	memcpy (code, static_code, static_size);
 	strcpy (code + static_size, string_argument);
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 
 	new_rsp = INFERIOR_REG_RSP (arch->current_regs) - AMD64_RED_ZONE_SIZE - size - 16;
@@ -1054,6 +1125,10 @@ server_ptrace_call_method_2 (ServerHandle *handle, guint64 method_address,
 	*((guint64 *) (code+104)) = INFERIOR_REG_R15 (arch->current_regs);
 	*((guint8 *) (code+data_size+112)) = 0xcc;
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 	memcpy (&cdata->saved_regs, &arch->current_regs, sizeof (arch->current_regs));
 	memcpy (&cdata->saved_fpregs, &arch->current_fpregs, sizeof (arch->current_fpregs));
@@ -1125,6 +1200,10 @@ server_ptrace_call_method_3 (ServerHandle *handle, guint64 method_address,
 
 	effective_address = address_argument ? address_argument : blob_start;
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 	memcpy (&cdata->saved_regs, &arch->current_regs, sizeof (arch->current_regs));
 	memcpy (&cdata->saved_fpregs, &arch->current_fpregs, sizeof (arch->current_fpregs));
@@ -1194,6 +1273,10 @@ server_ptrace_call_method_invoke (ServerHandle *handle, guint64 invoke_method,
 	*((guint64 *) code) = new_rsp + 24;
 	*((guint64 *) (code+8)) = callback_argument;
 
+	result = x86_arch_get_fp_registers (handle);
+	if (result != COMMAND_ERROR_NONE)
+		return result;
+
 	cdata = g_new0 (CallbackData, 1);
 	memcpy (&cdata->saved_regs, &arch->current_regs, sizeof (arch->current_regs));
 	memcpy (&cdata->saved_fpregs, &arch->current_fpregs, sizeof (arch->current_fpregs));
@@ -1255,14 +1338,96 @@ find_code_buffer_slot (MonoRuntimeInfo *runtime)
 	return -1;
 }
 
+/*
+ * Build the code which resumes a thread after a breakpoint whose condition was
+ * false: a copy of the original instruction, followed by an absolute jump to the
+ * next instruction.
+ */
+static int
+x86_arch_build_resume_code (guint64 code_address, guint64 address, const guint8 *instruction,
+			    guint32 insn_size, gint32 ip_relative_offset, guint8 *code)
+{
+	guint64 next_address = address + insn_size;
+
+	if (insn_size + 14 > RESUME_CODE_SIZE)
+		return -1;
+
+	memcpy (code, instruction, insn_size);
+
+	if (ip_relative_offset >= 0) {
+		gint32 displacement;
+		gint64 new_displacement;
+
+		if (ip_relative_offset + sizeof (gint32) > insn_size)
+			return -1;
+
+		memcpy (&displacement, code + ip_relative_offset, sizeof (gint32));
+		new_displacement = (gint64) displacement + (gint64) (address - code_address);
+		if (new_displacement != (gint32) new_displacement)
+			return -1;
+
+		displacement = (gint32) new_displacement;
+		memcpy (code + ip_relative_offset, &displacement, sizeof (gint32));
+	}
+
+	/* jmp *0(%rip) */
+	code [insn_size] = 0xff;
+	code [insn_size + 1] = 0x25;
+	memset (code + insn_size + 2, 0, 4);
+	memcpy (code + insn_size + 6, &next_address, sizeof (guint64));
+
+	return insn_size + 14;
+}
+
+static gboolean
+x86_arch_resume_after_breakpoint (ServerHandle *handle, guint32 idx)
+{
+#ifdef __linux__
+	ArchInfo *arch = handle->arch;
+	InferiorHandle *inferior = handle->inferior;
+	BreakpointInfo *breakpoint;
+	guint64 resume_address = 0, rip;
+
+	/*
+	 * The debugger wants to see the next stop.
+	 */
+	if (inferior->stepping || inferior->stop_pending)
+		return FALSE;
+
+	mono_debugger_breakpoint_manager_lock ();
+	breakpoint = mono_debugger_breakpoint_manager_lookup_by_id (handle->bpm, idx);
+	if (breakpoint)
+		resume_address = breakpoint->resume_address;
+	mono_debugger_breakpoint_manager_unlock ();
+
+	if (!resume_address)
+		return FALSE;
+
+	rip = INFERIOR_REG_RIP (arch->current_regs);
+	INFERIOR_REG_ORIG_RAX (arch->current_regs) = -1;
+	INFERIOR_REG_RIP (arch->current_regs) = resume_address;
+
+	if (_server_ptrace_set_registers (inferior, &arch->current_regs) != COMMAND_ERROR_NONE) {
+		INFERIOR_REG_RIP (arch->current_regs) = rip;
+		return FALSE;
+	}
+
+	inferior->last_signal = 0;
+	return server_ptrace_continue (handle) == COMMAND_ERROR_NONE;
+#else
+	return FALSE;
+#endif
+}
+
 static ServerCommandError
 server_ptrace_execute_instruction (ServerHandle *handle, const guint8 *instruction,
-				   guint32 size, gboolean update_ip)
+				   guint32 size, gboolean update_ip, gint32 ip_relative_offset)
 {
 	MonoRuntimeInfo *runtime;
 	ServerCommandError result;
 	CodeBufferData *data;
 	guint64 code_address;
+	guint8 code [EXECUTABLE_CODE_CHUNK_SIZE];
 	int slot;
 
 	runtime = handle->mono_runtime;
@@ -1280,8 +1445,38 @@ server_ptrace_execute_instruction (ServerHandle *handle, const guint8 *instructi
 	if (handle->arch->code_buffer)
 		return COMMAND_ERROR_INTERNAL_ERROR;
 
+	if (size > sizeof (code))
+		return COMMAND_ERROR_INTERNAL_ERROR;
+
 	code_address = runtime->executable_code_buffer + slot * runtime->executable_code_chunk_size;
 
+	memcpy (code, instruction, size);
+
+	/*
+	 * The instruction addresses memory relative to %rip, so we need to adjust
+	 * its displacement to still reach the same location from the code buffer.
+	 */
+	if (ip_relative_offset >= 0) {
+		guint64 rip = INFERIOR_REG_RIP (handle->arch->current_regs);
+		gint32 displacement;
+		gint64 new_displacement;
+
+		if (ip_relative_offset + sizeof (gint32) > size) {
+			runtime->executable_code_bitfield [slot] = 0;
+			return COMMAND_ERROR_INTERNAL_ERROR;
+		}
+
+		memcpy (&displacement, code + ip_relative_offset, sizeof (gint32));
+		new_displacement = (gint64) displacement + (gint64) (rip - code_address);
+		if (new_displacement != (gint32) new_displacement) {
+			runtime->executable_code_bitfield [slot] = 0;
+			return COMMAND_ERROR_INTERNAL_ERROR;
+		}
+
+		displacement = (gint32) new_displacement;
+		memcpy (code + ip_relative_offset, &displacement, sizeof (gint32));
+	}
+
 	data = g_new0 (CodeBufferData, 1);
 	data->slot = slot;
 	data->insn_size = size;
@@ -1291,7 +1486,7 @@ server_ptrace_execute_instruction (ServerHandle *handle, const guint8 *instructi
 
 	handle->arch->code_buffer = data;
 
-	result = server_ptrace_write_memory (handle, code_address, size, instruction);
+	result = server_ptrace_write_memory (handle, code_address, size, code);
 	if (result != COMMAND_ERROR_NONE)
 		return result;
 
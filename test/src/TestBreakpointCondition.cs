@@ -0,0 +1,27 @@
+using System;
+
+class X
+{
+	static int total;
+	static int last;
+
+	static bool Check (bool value)
+	{
+		return value;
+	}
+
+	static void Loop (int count)
+	{
+		for (int i = 0; i < count; i++) {
+			total += i;					// @MDB LINE: loop
+			last = i;					// @MDB LINE: loop last
+			Check (total >= last);				// @MDB LINE: loop check
+		}
+	}
+
+	static void Main ()
+	{
+		Loop (10);						// @MDB LINE: main
+		Console.WriteLine (total);
+	}
+}
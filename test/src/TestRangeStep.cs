@@ -0,0 +1,19 @@
+using System;
+
+class X
+{
+	static int Compute (int a, int b)
+	{
+		int total = a;						// @MDB BREAKPOINT: compute
+		total = (a * b + a) * (b - a) + (a ^ b) * 3 + (total << 2) - (b >> 1) + (a | b) * (a & b) - (total ^ 0x5a5a); // @MDB LINE: compute expression
+		for (int i = 0; i < 1000; i++)				// @MDB LINE: compute loop
+			total += (i * a) ^ b;				// @MDB LINE: compute loop body
+		return total;						// @MDB LINE: compute return
+	}
+
+	static void Main ()
+	{
+		int total = Compute (3, 8);				// @MDB LINE: main
+		Console.WriteLine (total);
+	}
+}
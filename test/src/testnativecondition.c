@@ -0,0 +1,26 @@
+#include <stdio.h>
+
+int total;
+int last;
+
+void
+loop (int count)
+{
+	unsigned long long mask = 0;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		total += i;			// @MDB LINE: loop
+		last = i;			// @MDB LINE: loop last
+		mask = (unsigned long long) i << 63;	// @MDB LINE: loop mask
+	}
+}
+
+int
+main (void)
+{
+	setbuf (stdout, NULL);			// @MDB LINE: main
+	loop (10);
+	printf ("Total: %d\n", total);
+	return 0;
+}
@@ -0,0 +1,57 @@
+using System;
+using NUnit.Framework;
+
+using Mono.Debugger;
+using Mono.Debugger.Languages;
+using Mono.Debugger.Frontend;
+using Mono.Debugger.Test.Framework;
+
+namespace Mono.Debugger.Tests
+{
+	[DebuggerTestFixture]
+	public class TestBreakpointCondition : DebuggerTestFixture
+	{
+		public TestBreakpointCondition ()
+			: base ("TestBreakpointCondition")
+		{ }
+
+		int AssertBreakpoint (string line, string condition)
+		{
+			return AssertBreakpoint (String.Format (
+				"{0}:{1} if {2}", FileName, GetLine (line), condition));
+		}
+
+		[Test]
+		[Category("ManagedTypes")]
+		public void Main ()
+		{
+			Process process = Start ();
+			Assert.IsTrue (process.IsManaged);
+			Assert.IsTrue (process.MainThread.IsStopped);
+			Thread thread = process.MainThread;
+
+			AssertStopped (thread, "main", "X.Main()");
+
+			AssertBreakpoint ("loop check", "i > 100");
+			int bpt_loop = AssertBreakpoint ("loop", "(i > 1) && !(total == 0)");
+			int bpt_last = AssertBreakpoint ("loop last", "last == 6");
+
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, bpt_loop, "X.Loop(int)", GetLine ("loop"));
+			AssertPrint (thread, "i", "(int) 2");
+			AssertPrint (thread, "total", "(int) 1");
+			AssertPrint (thread, "!(total == 1)", "(bool) false");
+			AssertPrint (thread, "Check (i == 2)", "(bool) true");
+			AssertExecute ("delete " + bpt_loop);
+
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, bpt_last, "X.Loop(int)", GetLine ("loop last"));
+			AssertPrint (thread, "i", "(int) 7");
+			AssertPrint (thread, "last", "(int) 6");
+
+			AssertExecute ("continue");
+			AssertTargetOutput ("45");
+			AssertTargetExited (thread.Process);
+		}
+	}
+}
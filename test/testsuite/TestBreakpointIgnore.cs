@@ -0,0 +1,70 @@
+using System;
+using NUnit.Framework;
+
+using Mono.Debugger;
+using Mono.Debugger.Languages;
+using Mono.Debugger.Frontend;
+using Mono.Debugger.Test.Framework;
+
+namespace Mono.Debugger.Tests
+{
+	[DebuggerTestFixture]
+	public class TestBreakpointIgnore : DebuggerTestFixture
+	{
+		public TestBreakpointIgnore ()
+			: base ("TestBreakpointCondition")
+		{ }
+
+		[Test]
+		[Category("ManagedTypes")]
+		public void Main ()
+		{
+			Process process = Start ();
+			Assert.IsTrue (process.IsManaged);
+			Assert.IsTrue (process.MainThread.IsStopped);
+			Thread thread = process.MainThread;
+
+			AssertStopped (thread, "main", "X.Main()");
+
+			int bpt_loop = AssertBreakpoint (GetLine ("loop"));
+			AssertExecute ("ignore " + bpt_loop + " 4");
+
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, bpt_loop, "X.Loop(int)", GetLine ("loop"));
+			AssertPrint (thread, "i", "(int) 4");
+
+			Breakpoint breakpoint = (Breakpoint) Interpreter.GetEvent (bpt_loop);
+			BreakpointStatistics stats = thread.GetBreakpointStatistics (breakpoint);
+			Assert.AreEqual (5, stats.HitCount);
+			Assert.AreEqual (0, stats.IgnoreCount);
+
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, bpt_loop, "X.Loop(int)", GetLine ("loop"));
+			AssertPrint (thread, "i", "(int) 5");
+
+			AssertExecute ("delete " + bpt_loop);
+
+			//
+			// Only the hits where the condition is true count, so this
+			// ignores i == 6 and stops at i == 8.
+			//
+			int bpt_last = AssertBreakpoint (String.Format (
+				"{0}:{1} if (i == 6) || (i == 8)", FileName, GetLine ("loop last")));
+			AssertExecute ("ignore " + bpt_last + " 1");
+
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, bpt_last, "X.Loop(int)", GetLine ("loop last"));
+			AssertPrint (thread, "i", "(int) 8");
+
+			breakpoint = (Breakpoint) Interpreter.GetEvent (bpt_last);
+			stats = thread.GetBreakpointStatistics (breakpoint);
+			Assert.AreEqual (2, stats.HitCount);
+			Assert.AreEqual (0, stats.IgnoreCount);
+
+			AssertExecute ("delete " + bpt_last);
+			AssertExecute ("continue");
+			AssertTargetOutput ("45");
+			AssertTargetExited (thread.Process);
+		}
+	}
+}
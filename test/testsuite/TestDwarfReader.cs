@@ -0,0 +1,108 @@
+using System;
+using System.IO;
+using System.Collections.Generic;
+using NUnit.Framework;
+
+using Mono.Debugger;
+using Mono.Debugger.Languages;
+using Mono.Debugger.Frontend;
+using Mono.Debugger.Test.Framework;
+
+namespace Mono.Debugger.Tests
+{
+	//
+	// Reads all compile units of the test's executable and checks that we
+	// decoded its source files, functions and line numbers correctly.
+	//
+	[DebuggerTestFixture]
+	public class TestDwarfReader : DebuggerTestFixture
+	{
+		public TestDwarfReader ()
+			: base ("testnativetypes", "testnativetypes.c")
+		{ }
+
+		static readonly string[] Functions = {
+			"simple", "print_test_struct", "test_struct", "test_struct_2",
+			"test_struct_3", "test_func", "test_function_struct", "test_bitfield",
+			"test_list", "test_function_ptr", "allocate_array", "test_array", "main"
+		};
+
+		Module FindModule (Process process)
+		{
+			string name = Path.GetFileName (ExeFileName);
+			foreach (Module module in process.Modules) {
+				if (module.SymbolsLoaded && module.HasDebuggingInfo &&
+				    (module.Name.IndexOf (name) >= 0))
+					return module;
+			}
+
+			Assert.Fail ("No module matching `{0}'.", name);
+			return null;
+		}
+
+		SourceFile FindSourceFile (Module module)
+		{
+			foreach (SourceFile file in module.Sources) {
+				if (file.Name == Path.GetFileName (FileName))
+					return file;
+			}
+
+			Assert.Fail ("Module {0} has no source file {1}.", module.Name, FileName);
+			return null;
+		}
+
+		void AssertMethodAt (SourceFile file, string line, string function)
+		{
+			MethodSource method = file.FindMethod (GetLine (line));
+			Assert.IsNotNull (method, "No method at line `{0}'.", line);
+			Assert.AreEqual (function, method.Name, "Wrong method at line `{0}'.", line);
+		}
+
+		[Test]
+		[Category("Native")]
+		public void Main ()
+		{
+			Process process = Start ();
+			Assert.IsTrue (process.MainThread.IsStopped);
+
+			Thread thread = process.MainThread;
+
+			AssertStopped (thread, "main", "main");
+
+			Module module = FindModule (process);
+			SourceFile file = FindSourceFile (module);
+
+			List<string> names = new List<string> ();
+			foreach (MethodSource method in module.GetMethods (file)) {
+				Assert.IsTrue (method.StartRow <= method.EndRow,
+					       "Method {0} ends before it starts.", method.Name);
+				names.Add (method.Name);
+			}
+
+			names.Sort ();
+			List<string> expected = new List<string> (Functions);
+			expected.Sort ();
+			Assert.AreEqual (expected.ToArray (), names.ToArray (),
+					 "Wrong methods in {0}.", file.Name);
+
+			AssertMethodAt (file, "main", "main");
+			AssertMethodAt (file, "simple", "simple");
+			AssertMethodAt (file, "struct", "test_struct");
+			AssertMethodAt (file, "struct2", "test_struct_2");
+			AssertMethodAt (file, "struct3", "test_struct_3");
+			AssertMethodAt (file, "function struct", "test_function_struct");
+			AssertMethodAt (file, "bitfield", "test_bitfield");
+			AssertMethodAt (file, "list", "test_list");
+			AssertMethodAt (file, "funcptr", "test_function_ptr");
+			AssertMethodAt (file, "array", "test_array");
+
+			foreach (string function in Functions) {
+				MethodSource method = module.FindMethod (function);
+				Assert.IsNotNull (method, "Can't find method {0}.", function);
+				Assert.AreEqual (function, method.Name);
+			}
+
+			AssertExecute ("kill");
+		}
+	}
+}
@@ -0,0 +1,89 @@
+using System;
+using System.IO;
+using System.Diagnostics;
+using NUnit.Framework;
+
+using Mono.Debugger;
+using Mono.Debugger.Languages;
+using Mono.Debugger.Frontend;
+using Mono.Debugger.Test.Framework;
+
+namespace Mono.Debugger.Tests
+{
+	//
+	// Reports how long it takes to read all compile units of a module and
+	// how much memory that allocates; this is not run by default.
+	//
+	// By default, we read the test's own executable; set MDB_DWARF_BENCHMARK
+	// to a part of a module's file name to read that module instead, for
+	// instance `libstdc++' together with LD_PRELOAD pointing to a libstdc++
+	// which was built with debugging info.
+	//
+	[DebuggerTestFixture]
+	public class TestDwarfReaderBenchmark : DebuggerTestFixture
+	{
+		public TestDwarfReaderBenchmark ()
+			: base ("testnativetypes", "testnativetypes.c")
+		{ }
+
+		void ReadModule (Module module)
+		{
+			GC.Collect ();
+			GC.WaitForPendingFinalizers ();
+
+			long memory = GC.GetTotalMemory (false);
+			int collections = GC.CollectionCount (0);
+			Stopwatch watch = Stopwatch.StartNew ();
+
+			int num_sources = 0, num_methods = 0;
+			foreach (SourceFile file in module.Sources) {
+				MethodSource[] methods = module.GetMethods (file);
+				num_methods += methods.Length;
+				num_sources++;
+			}
+
+			watch.Stop ();
+
+			Console.WriteLine ("TestDwarfReaderBenchmark: {0}: {1} sources and {2} methods " +
+					   "in {3} ms; {4} kB allocated, {5} collections.",
+					   module.Name, num_sources, num_methods,
+					   watch.ElapsedMilliseconds,
+					   (GC.GetTotalMemory (false) - memory) / 1024,
+					   GC.CollectionCount (0) - collections);
+
+			Assert.IsTrue (num_sources > 0, "No sources in {0}.", module.Name);
+		}
+
+		[Test]
+		[Explicit]
+		[Category("Benchmark")]
+		public void Main ()
+		{
+			Process process = Start ();
+			Assert.IsTrue (process.MainThread.IsStopped);
+
+			Thread thread = process.MainThread;
+
+			AssertStopped (thread, "main", "main");
+
+			string filter = Environment.GetEnvironmentVariable ("MDB_DWARF_BENCHMARK");
+			if (filter == null)
+				filter = Path.GetFileName (ExeFileName);
+
+			bool found = false;
+			foreach (Module module in process.Modules) {
+				if (!module.SymbolsLoaded || !module.HasDebuggingInfo)
+					continue;
+				if (module.Name.IndexOf (filter) < 0)
+					continue;
+
+				ReadModule (module);
+				found = true;
+			}
+
+			Assert.IsTrue (found, "No module matching `{0}'.", filter);
+
+			AssertExecute ("kill");
+		}
+	}
+}
@@ -0,0 +1,64 @@
+using System;
+using NUnit.Framework;
+
+using Mono.Debugger;
+using Mono.Debugger.Languages;
+using Mono.Debugger.Frontend;
+using Mono.Debugger.Test.Framework;
+
+namespace Mono.Debugger.Tests
+{
+	[DebuggerTestFixture]
+	public class TestRangeStep : DebuggerTestFixture
+	{
+		public TestRangeStep ()
+			: base ("TestRangeStep")
+		{ }
+
+		int Next (Thread thread, string line)
+		{
+			AssertExecute ("next");
+			AssertStopped (thread, "X.Compute(int, int)", GetLine (line));
+
+			int traps = thread.StepTrapCount;
+			Console.WriteLine ("TestRangeStep: {0} traps for `next' to `{1}'.", traps, line);
+			return traps;
+		}
+
+		[Test]
+		[Category("SSE")]
+		public void Main ()
+		{
+			Process process = Start ();
+			Assert.IsTrue (process.IsManaged);
+			Assert.IsTrue (process.MainThread.IsStopped);
+			Thread thread = process.MainThread;
+
+			AssertStopped (thread, "main", "X.Main()");
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, "compute", "X.Compute(int, int)");
+
+			Next (thread, "compute expression");
+
+			//
+			// The expression is straight-line code, so we should run to
+			// the end of the line instead of stepping each instruction.
+			//
+			int traps = Next (thread, "compute loop");
+			Assert.IsTrue (traps <= 3, "Too many traps for a straight-line `next': {0}", traps);
+
+			int total = 0;
+			for (int i = 0; i < 3; i++) {
+				total += Next (thread, "compute loop body");
+				total += Next (thread, "compute loop");
+			}
+
+			Console.WriteLine ("TestRangeStep: {0:0.0} traps per `next' in the loop.",
+					   total / 6.0);
+
+			AssertExecute ("continue");
+			AssertTargetOutput ("1475563");
+			AssertTargetExited (thread.Process);
+		}
+	}
+}
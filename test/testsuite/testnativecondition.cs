@@ -0,0 +1,57 @@
+using System;
+using NUnit.Framework;
+
+using Mono.Debugger;
+using Mono.Debugger.Languages;
+using Mono.Debugger.Frontend;
+using Mono.Debugger.Test.Framework;
+
+namespace Mono.Debugger.Tests
+{
+	[DebuggerTestFixture]
+	public class testnativecondition : DebuggerTestFixture
+	{
+		public testnativecondition ()
+			: base ("testnativecondition", "testnativecondition.c")
+		{ }
+
+		int AssertBreakpoint (string line, string condition)
+		{
+			return AssertBreakpoint (String.Format (
+				"{0}:{1} if {2}", FileName, GetLine (line), condition));
+		}
+
+		[Test]
+		[Category("Native")]
+		public void Main ()
+		{
+			Process process = Start ();
+			Assert.IsTrue (process.MainThread.IsStopped);
+			Thread thread = process.MainThread;
+
+			AssertStopped (thread, "main", "main");
+
+			int bpt_loop = AssertBreakpoint ("loop", "i == 7");
+			AssertBreakpoint ("loop last", "total > 1000");
+
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, bpt_loop, "loop", GetLine ("loop"));
+			AssertPrint (thread, "i", "(int) 7");
+			AssertPrint (thread, "total", "(int) 21");
+
+			//
+			// `mask' is 1 << 63 after odd iterations; this must be
+			// compared as an unsigned value.
+			//
+			int bpt_mask = AssertBreakpoint ("loop mask", "mask > 1");
+
+			AssertExecute ("continue");
+			AssertHitBreakpoint (thread, bpt_mask, "loop", GetLine ("loop mask"));
+			AssertPrint (thread, "i", "(int) 8");
+
+			AssertExecute ("continue");
+			AssertTargetOutput ("Total: 45");
+			AssertTargetExited (thread.Process);
+		}
+	}
+}